@@ -179,8 +179,8 @@ auto make_base_metrics(telemetry::metric_registry& reg) {
     // Initialize the base metrics.
     reg.counter_singleton("caf.system", "rejected-messages",
                           "Number of rejected messages.", "1", true),
-    reg.counter_family("caf.system", "processed-messages", {"name"},
-                       "Number of processed messages.", "1", true),
+    reg.striped_counter_family("caf.system", "processed-messages", {"name"},
+                               "Number of processed messages.", "1", true),
     reg.gauge_singleton("caf.system", "queued-messages",
                         "Number of messages in all mailboxes.", "1", true),
   };
@@ -220,6 +220,11 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       reg.gauge_family("caf.actor.stream", "input-buffer-size",
                        {"name", "type"},
                        "Number of buffered stream elements from upstream."),
+      reg.gauge_family("caf.actor.stream", "batch-size", {"name", "type"},
+                       "Average number of elements per batch from upstream."),
+      reg.gauge_family("caf.actor.stream", "max-in-flight-batches",
+                       {"name", "type"},
+                       "Number of batches from upstream allowed in flight."),
       reg.counter_family(
         "caf.actor.stream", "pushed-elements", {"name", "type"},
         "Number of elements that have been pushed downstream."),
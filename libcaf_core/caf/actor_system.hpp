@@ -159,8 +159,9 @@ public:
     /// mailbox was closed or did not exist.
     telemetry::int_counter* rejected_messages;
 
-    /// Counts the total number of processed messages.
-    telemetry::int_counter_family* processed_messages;
+    /// Counts the total number of processed messages. Uses a striped counter,
+    /// because all workers update it after running an actor.
+    telemetry::striped_int_counter_family* processed_messages;
 
     /// Counts the total number of messages that wait in a mailbox.
     telemetry::int_gauge* queued_messages;
@@ -189,6 +190,12 @@ public:
       /// Tracks how many stream elements from upstream are currently buffered.
       telemetry::int_gauge_family* input_buffer_size = nullptr;
 
+      /// Tracks the average number of elements per batch from upstream.
+      telemetry::int_gauge_family* batch_size = nullptr;
+
+      /// Tracks how many batches from upstream may be in flight.
+      telemetry::int_gauge_family* max_in_flight_batches = nullptr;
+
       // -- outbound -----------------------------------------------------------
 
       /// Counts the total number of elements that have been pushed downstream.
@@ -134,9 +134,19 @@ actor_system_config::actor_system_config() {
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
                    "sleep duration between relaxed steal attempts");
+  opt_group{custom_options_, "caf.logger"}
+    .add<bool>("deferred-formatting",
+               "formats log events in the logger thread")
+    .add<size_t>("thread-buffer-size",
+                 "size of the log buffer per thread for deferred formatting")
+    .add<config_value::list>("rate-limits",
+                             "limits log events per component and level")
+    .add<timespan>("rate-limit-summary-interval",
+                   "time between reports of events dropped by rate limits");
   opt_group{custom_options_, "caf.logger.file"}
     .add<std::string>("path", "filesystem path for the log file")
     .add<std::string>("format", "format for individual log file entries")
+    .add<bool>("binary", "writes binary records instead of formatted text")
     .add<std::string>("verbosity", "minimum severity level for file output")
     .add<std::vector<std::string>>("excluded-components",
                                    "excluded components in files");
@@ -194,8 +204,15 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::relaxed_sleep_duration);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
+  put_missing(logger_group, "deferred-formatting",
+              defaults::logger::deferred_formatting);
+  put_missing(logger_group, "thread-buffer-size",
+              defaults::logger::thread_buffer_size);
+  put_missing(logger_group, "rate-limit-summary-interval",
+              defaults::logger::rate_limit_summary_interval);
   auto& file_group = logger_group["file"].as_dictionary();
   put_missing(file_group, "path", defaults::logger::file::path);
+  put_missing(file_group, "binary", defaults::logger::file::binary);
   put_missing(file_group, "format", defaults::logger::file::format);
   put_missing(file_group, "excluded-components", std::vector<std::string>{});
   auto& console_group = logger_group["console"].as_dictionary();
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "caf/async/fwd.hpp"
+#include "caf/async/mpsc_buffer.hpp"
 #include "caf/async/producer.hpp"
 #include "caf/async/spsc_buffer.hpp"
 #include "caf/detail/atomic_ref_counted.hpp"
@@ -18,16 +20,21 @@
 namespace caf::async {
 
 /// Blocking interface for emitting items to an asynchronous consumer.
-template <class T>
+/// @tparam T The type of the emitted items.
+/// @tparam Buffer The buffer type for writing items, i.e., either
+///                `spsc_buffer<T>` or `mpsc_buffer_port<T>`.
+template <class T, class Buffer>
 class blocking_producer {
 public:
+  using buffer_ptr = intrusive_ptr<Buffer>;
+
   class impl : public detail::atomic_ref_counted, public producer {
   public:
     impl() = delete;
     impl(const impl&) = delete;
     impl& operator=(const impl&) = delete;
 
-    explicit impl(spsc_buffer_ptr<T> buf) : buf_(std::move(buf)) {
+    explicit impl(buffer_ptr buf) : buf_(std::move(buf)) {
       buf_->set_producer(this);
     }
 
@@ -102,7 +109,7 @@ public:
     }
 
   private:
-    spsc_buffer_ptr<T> buf_;
+    buffer_ptr buf_;
     mutable std::mutex mtx_;
     std::condition_variable cv_;
     ptrdiff_t demand_ = 0;
@@ -124,7 +131,7 @@ public:
     // nop
   }
 
-  explicit blocking_producer(spsc_buffer_ptr<T> buf) {
+  explicit blocking_producer(buffer_ptr buf) {
     impl_.emplace(std::move(buf));
   }
 
@@ -177,6 +184,15 @@ private:
   intrusive_ptr<impl> impl_;
 };
 
+/// @relates blocking_producer
+template <class T>
+blocking_producer(spsc_buffer_ptr<T>) -> blocking_producer<T>;
+
+/// @relates blocking_producer
+template <class T>
+blocking_producer(mpsc_buffer_port_ptr<T>)
+  -> blocking_producer<T, mpsc_buffer_port<T>>;
+
 /// @pre `buf != nullptr`
 /// @relates blocking_producer
 template <class T>
@@ -185,6 +201,16 @@ blocking_producer<T> make_blocking_producer(spsc_buffer_ptr<T> buf) {
   return blocking_producer<T>{make_counted<impl_t>(std::move(buf))};
 }
 
+/// @pre `port != nullptr`
+/// @relates blocking_producer
+template <class T>
+blocking_producer<T, mpsc_buffer_port<T>>
+make_blocking_producer(mpsc_buffer_port_ptr<T> port) {
+  using result_t = blocking_producer<T, mpsc_buffer_port<T>>;
+  using impl_t = typename result_t::impl;
+  return result_t{make_counted<impl_t>(std::move(port))};
+}
+
 /// @relates blocking_producer
 template <class T>
 std::optional<blocking_producer<T>>
@@ -196,6 +222,18 @@ make_blocking_producer(producer_resource<T> res) {
   }
 }
 
+/// Opens a new port on the MPSC buffer and creates a blocking producer for it.
+/// @relates blocking_producer
+template <class T>
+std::optional<blocking_producer<T, mpsc_buffer_port<T>>>
+make_blocking_producer(mpsc_producer_resource<T> res) {
+  if (auto port = res.try_open()) {
+    return {make_blocking_producer(std::move(port))};
+  } else {
+    return {};
+  }
+}
+
 /// @relates blocking_producer
 template <class T>
 std::pair<blocking_producer<T>, consumer_resource<T>> make_blocking_producer() {
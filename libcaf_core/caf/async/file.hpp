@@ -3,13 +3,25 @@
 // https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
 
 #include "caf/actor_system.hpp"
+#include "caf/async/file_sink_options.hpp"
+#include "caf/async/promise.hpp"
+#include "caf/async/publisher.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/chunk.hpp"
+#include "caf/cow_string.hpp"
 #include "caf/detail/concepts.hpp"
+#include "caf/detail/file_writer.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/flow/byte.hpp"
 #include "caf/flow/string.hpp"
 #include "caf/scheduled_actor/flow.hpp"
 
+#include <algorithm>
 #include <cstdio>
+#include <deque>
+#include <string>
+#include <string_view>
 
 namespace caf::detail {
 
@@ -96,6 +108,328 @@ private:
   std::string path_;
 };
 
+/// Reads a file in large blocks, bypassing the buffering of the C library.
+class file_block_input {
+public:
+  file_block_input(std::string path, size_t block_size)
+    : path_(std::move(path)), block_size_(block_size) {
+    // nop
+  }
+
+  file_block_input(file_block_input&& other) noexcept
+    : block_size_(other.block_size_) {
+    swap(other);
+  }
+
+  file_block_input& operator=(file_block_input&& other) noexcept {
+    if (this != &other)
+      swap(other);
+    return *this;
+  }
+
+  file_block_input(const file_block_input& other)
+    : path_(other.path_), block_size_(other.block_size_) {
+    // Note: intentionally don't copy the file handle or the buffer.
+  }
+
+  file_block_input& operator=(const file_block_input& other) {
+    if (this != &other) {
+      path_ = other.path_;
+      block_size_ = other.block_size_;
+      close();
+    }
+    return *this;
+  }
+
+  ~file_block_input() {
+    close();
+  }
+
+  /// Opens the file unless it is already open.
+  /// @returns an error if the file cannot be opened or if the block size is 0.
+  error open() {
+    if (file_ != nullptr)
+      return {};
+    if (block_size_ == 0)
+      return make_error(sec::invalid_argument, "block size must be positive");
+    file_ = fopen(path_.c_str(), "rb");
+    if (file_ == nullptr)
+      return make_error(sec::cannot_open_file);
+    // We always read entire blocks, so the buffer of the C library would only
+    // add an extra copy.
+    setvbuf(file_, nullptr, _IONBF, 0);
+    buf_.resize(block_size_);
+    return {};
+  }
+
+  /// Reads the next block from the file. The result is only valid until the
+  /// next call to `read`.
+  /// @returns the bytes read from the file. A result that is shorter than the
+  ///          block size indicates the end of the file or an error.
+  const_byte_span read() {
+    auto n = fread(buf_.data(), 1, buf_.size(), file_);
+    return const_byte_span{buf_.data(), n};
+  }
+
+  /// Checks whether the last read failed because of an error.
+  bool failed() const noexcept {
+    return file_ != nullptr && ferror(file_) != 0;
+  }
+
+  /// Closes the file.
+  void close() {
+    if (file_ != nullptr) {
+      fclose(file_);
+      file_ = nullptr;
+    }
+  }
+
+  size_t block_size() const noexcept {
+    return block_size_;
+  }
+
+  void swap(file_block_input& other) noexcept {
+    using std::swap;
+    swap(file_, other.file_);
+    swap(path_, other.path_);
+    swap(block_size_, other.block_size_);
+    swap(buf_, other.buf_);
+  }
+
+private:
+  FILE* file_ = nullptr;
+  std::string path_;
+  size_t block_size_;
+  byte_buffer buf_;
+};
+
+/// A generator that emits the content of a file in chunks of up to
+/// `block_size` bytes. Only the last chunk may be shorter.
+class file_block_reader {
+public:
+  using output_type = chunk;
+
+  file_block_reader(std::string path, size_t block_size)
+    : input_(std::move(path), block_size) {
+    // nop
+  }
+
+  template <class Step, class... Steps>
+  void pull(size_t n, Step& step, Steps&... steps) {
+    if (auto err = input_.open()) {
+      step.on_error(err, steps...);
+      return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      auto bytes = input_.read();
+      if (!bytes.empty() && !step.on_next(chunk{bytes}, steps...))
+        return;
+      if (bytes.size() < input_.block_size()) {
+        finalize(step, steps...);
+        return;
+      }
+    }
+  }
+
+private:
+  template <class Step, class... Steps>
+  void finalize(Step& step, Steps&... steps) {
+    if (input_.failed())
+      step.on_error(make_error(sec::runtime_error, "failed to read file"),
+                    steps...);
+    else
+      step.on_complete(steps...);
+    input_.close();
+  }
+
+  file_block_input input_;
+};
+
+/// Splits blocks of characters into lines. Accepts "\n", "\r\n" and "\r"
+/// as line separators, even if a separator spans two blocks.
+class line_splitter {
+public:
+  /// Splits `block` into lines and calls `consume` for each complete line.
+  /// Stores trailing characters until the next call.
+  template <class F>
+  void split(std::string_view block, F&& consume) {
+    auto is_separator = [](char ch) { return ch == '\n' || ch == '\r'; };
+    auto first = block.begin();
+    auto last = block.end();
+    // Skip the '\n' of a "\r\n" sequence that spans two blocks.
+    if (skip_lf_ && first != last && *first == '\n')
+      ++first;
+    skip_lf_ = false;
+    while (first != last) {
+      auto sep = std::find_if(first, last, is_separator);
+      buf_.append(first, sep);
+      if (sep == last)
+        return;
+      consume(cow_string{std::move(buf_)});
+      buf_.clear();
+      first = sep + 1;
+      if (*sep == '\r') {
+        if (first == last)
+          skip_lf_ = true;
+        else if (*first == '\n')
+          ++first;
+      }
+    }
+  }
+
+  /// Returns the remaining characters as the last line.
+  cow_string finish() {
+    skip_lf_ = false;
+    auto result = cow_string{std::move(buf_)};
+    buf_.clear();
+    return result;
+  }
+
+private:
+  std::string buf_;
+  bool skip_lf_ = false;
+};
+
+/// A generator that emits the lines of a file while reading the file in large
+/// blocks. Produces the same lines as combining a `file_reader<char>` with the
+/// `normalize_newlines` and `to_lines` steps.
+class file_line_reader {
+public:
+  using output_type = cow_string;
+
+  file_line_reader(std::string path, size_t block_size)
+    : input_(std::move(path), block_size) {
+    // nop
+  }
+
+  file_line_reader(file_line_reader&&) noexcept = default;
+
+  file_line_reader& operator=(file_line_reader&&) noexcept = default;
+
+  file_line_reader(const file_line_reader& other) : input_(other.input_) {
+    // Note: intentionally don't copy the lines and the state of the splitter.
+  }
+
+  file_line_reader& operator=(const file_line_reader& other) {
+    if (this != &other) {
+      input_ = other.input_;
+      lines_.clear();
+      splitter_ = line_splitter{};
+      done_ = false;
+    }
+    return *this;
+  }
+
+  template <class Step, class... Steps>
+  void pull(size_t n, Step& step, Steps&... steps) {
+    if (auto err = input_.open()) {
+      step.on_error(err, steps...);
+      return;
+    }
+    auto add_line = [this](cow_string line) {
+      lines_.emplace_back(std::move(line));
+    };
+    for (size_t i = 0; i < n; ++i) {
+      while (lines_.empty() && !done_) {
+        auto bytes = input_.read();
+        auto str = std::string_view{reinterpret_cast<const char*>(bytes.data()),
+                                    bytes.size()};
+        splitter_.split(str, add_line);
+        if (bytes.size() < input_.block_size()) {
+          done_ = true;
+          if (input_.failed()) {
+            input_.close();
+            step.on_error(make_error(sec::runtime_error, "failed to read file"),
+                          steps...);
+            return;
+          }
+          lines_.emplace_back(splitter_.finish());
+        }
+      }
+      if (lines_.empty()) {
+        step.on_complete(steps...);
+        input_.close();
+        return;
+      }
+      auto line = std::move(lines_.front());
+      lines_.pop_front();
+      if (!step.on_next(line, steps...))
+        return;
+    }
+    if (done_ && lines_.empty()) {
+      step.on_complete(steps...);
+      input_.close();
+    }
+  }
+
+private:
+  file_block_input input_;
+  line_splitter splitter_;
+  std::deque<cow_string> lines_;
+  bool done_ = false;
+};
+
+/// Stores the state of a file sink that runs in its own actor.
+struct file_sink_state {
+  file_sink_state(std::string path, async::file_sink_options opts,
+                  async::promise<size_t> res)
+    : writer(std::move(path), opts), result(std::move(res)) {
+    // nop
+  }
+
+  /// Writes the input to disk.
+  file_writer writer;
+
+  /// Receives the number of written bytes or an error.
+  async::promise<size_t> result;
+
+  /// Subscription to the input of the sink.
+  disposable sub;
+
+  /// Pending timeout for synchronizing the file.
+  disposable sync_timeout;
+
+  template <class T>
+  void on_next(scheduled_actor* self, std::shared_ptr<file_sink_state> ptr,
+               const T& item) {
+    auto err = error{};
+    if constexpr (std::is_same_v<T, chunk>)
+      err = writer.write(item.bytes());
+    else
+      err = writer.write_line(item.str());
+    if (err) {
+      abort(err);
+      return;
+    }
+    // Make sure that pending writes reach the disk eventually, even if the
+    // input stalls.
+    auto interval = writer.options().sync_interval;
+    if (interval.count() > 0 && writer.dirty() && !sync_timeout) {
+      sync_timeout = self->run_delayed(interval, [ptr] {
+        ptr->sync_timeout = disposable{};
+        if (auto err = ptr->writer.sync())
+          ptr->abort(err);
+      });
+    }
+  }
+
+  void complete() {
+    sync_timeout.dispose();
+    if (auto err = writer.close())
+      result.set_error(err);
+    else
+      result.set_value(writer.total_bytes());
+  }
+
+  void abort(const error& reason) {
+    sync_timeout.dispose();
+    sub.dispose();
+    // Note: we already report an error, so we ignore errors from closing.
+    static_cast<void>(writer.close());
+    result.set_error(reason);
+  }
+};
+
 } // namespace caf::detail
 
 namespace caf::async {
@@ -147,13 +481,13 @@ private: // must come before the public interface for return type deduction
     return source_runner<decltype(gen)>{sys, std::move(gen)};
   }
 
-  static auto read_lines_impl(actor_system* sys, std::string path) {
-    auto gen = [path = std::move(path)](event_based_actor* self) mutable {
+  static auto read_lines_impl(actor_system* sys, std::string path,
+                              size_t block_size) {
+    auto gen = [path = std::move(path),
+                block_size](event_based_actor* self) mutable {
       return self //
         ->make_observable()
-        .from_generator(detail::file_reader<char>{std::move(path)})
-        .transform(flow::string::normalize_newlines())
-        .transform(flow::string::to_lines());
+        .from_generator(detail::file_line_reader{std::move(path), block_size});
     };
     return source_runner<decltype(gen)>{sys, std::move(gen)};
   }
@@ -171,13 +505,44 @@ private: // must come before the public interface for return type deduction
     auto gen = [path = std::move(path), n](event_based_actor* self) mutable {
       return self //
         ->make_observable()
-        .from_generator(detail::file_reader<std::byte>{std::move(path)})
-        .transform(flow::byte::to_chunks(n));
+        .from_generator(detail::file_block_reader{std::move(path), n});
     };
     return source_runner<decltype(gen)>{sys, std::move(gen)};
   }
 
+  template <class T>
+  static future<size_t> write_impl(actor_system* sys, std::string path,
+                                   publisher<T> input, file_sink_options opts) {
+    auto prom = promise<size_t>{};
+    auto res = prom.get_future();
+    auto fn = [path = std::move(path), input = std::move(input), opts,
+               prom = std::move(prom)](event_based_actor* self) mutable {
+      using state_type = detail::file_sink_state;
+      auto state = std::make_shared<state_type>(std::move(path), opts,
+                                                std::move(prom));
+      if (auto err = state->writer.open()) {
+        state->result.set_error(err);
+        return;
+      }
+      // Note: the sink writes synchronously. While writing or synchronizing,
+      // it stops consuming its input, which propagates backpressure upstream.
+      state->sub = input.observe_on(self)
+                     .do_on_error([state](const error& what) { //
+                       state->abort(what);
+                     })
+                     .do_on_complete([state] { state->complete(); })
+                     .for_each([self, state](const T& item) {
+                       state->on_next(self, state, item);
+                     });
+    };
+    sys->spawn<detached>(std::move(fn));
+    return res;
+  }
+
 public:
+  /// Default size for reading a file in blocks when splitting it into lines.
+  static constexpr size_t default_block_size = 64 * 1024;
+
   file(actor_system& sys, std::string path)
     : sys_(&sys), path_(std::move(path)) {
     // nop
@@ -193,14 +558,16 @@ public:
     return read_chars_impl(sys_, path_);
   }
 
-  /// Asynchronously reads the entire file, line by line.
-  [[nodiscard]] auto read_lines() && {
-    return read_lines_impl(sys_, std::move(path_));
+  /// Asynchronously reads the entire file, line by line. Reads the file in
+  /// blocks of `block_size` bytes.
+  [[nodiscard]] auto read_lines(size_t block_size = default_block_size) && {
+    return read_lines_impl(sys_, std::move(path_), block_size);
   }
 
-  /// Asynchronously reads the entire file, line by line.
-  [[nodiscard]] auto read_lines() const& {
-    return read_lines_impl(sys_, path_);
+  /// Asynchronously reads the entire file, line by line. Reads the file in
+  /// blocks of `block_size` bytes.
+  [[nodiscard]] auto read_lines(size_t block_size = default_block_size) const& {
+    return read_lines_impl(sys_, path_, block_size);
   }
 
   /// Asynchronously reads the entire file, byte by byte.
@@ -214,17 +581,34 @@ public:
   }
 
   /// Asynchronously reads the entire file, grouped into chunks of size
-  /// `chunk_size`.
+  /// `chunk_size`. Only the last chunk may be shorter.
   [[nodiscard]] auto read_chunks(size_t chunk_size) const& {
     return read_chunks_impl(sys_, path_, chunk_size);
   }
 
   /// Asynchronously reads the entire file, grouped into chunks of size
-  /// `chunk_size`.
+  /// `chunk_size`. Only the last chunk may be shorter.
   [[nodiscard]] auto read_chunks(size_t chunk_size) && {
     return read_chunks_impl(sys_, std::move(path_), chunk_size);
   }
 
+  /// Asynchronously writes all chunks from `input` to the file.
+  /// @returns a future that receives the total number of written bytes after
+  ///          the sink has written all chunks and closed the file.
+  [[nodiscard]] future<size_t>
+  write_chunks(publisher<chunk> input, file_sink_options opts = {}) const {
+    return write_impl(sys_, path_, std::move(input), opts);
+  }
+
+  /// Asynchronously writes all lines from `input` to the file, appending a
+  /// newline character to each line.
+  /// @returns a future that receives the total number of written bytes after
+  ///          the sink has written all lines and closed the file.
+  [[nodiscard]] future<size_t>
+  write_lines(publisher<cow_string> input, file_sink_options opts = {}) const {
+    return write_impl(sys_, path_, std::move(input), opts);
+  }
+
 private:
   actor_system* sys_;
   std::string path_;
@@ -14,7 +14,10 @@
 #include "caf/flow/observable.hpp"
 
 #include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <future>
+#include <iterator>
 #include <string>
 
 using namespace caf;
@@ -84,6 +87,25 @@ TEST("async text file I/O") {
     }
     check_eq(res.get(), quotes_numbered_lines);
   }
+  SECTION("read lines from file using small blocks") {
+    auto pub = async::file(sys, quotes_file).read_lines(7).run();
+    sys.spawn([pub, prom](event_based_actor* self) mutable {
+      auto str = std::make_shared<std::string>();
+      pub.observe_on(self)
+        .do_on_error([prom](const error& err) { prom->set_value(err); })
+        .do_on_complete([prom, str] { prom->set_value(std::move(*str)); })
+        .for_each([str, line = 1](const cow_string& cs) mutable {
+          *str += std::to_string(line++);
+          *str += ':';
+          *str += cs.str();
+          *str += '\n';
+        });
+    });
+    if (res.wait_for(2s) != std::future_status::ready) {
+      fail("timeout");
+    }
+    check_eq(res.get(), quotes_numbered_lines);
+  }
   SECTION("try to read from non-existing file") {
     auto invalid = async::file(sys, invalid_file);
     SECTION("read_chars") {
@@ -166,4 +188,91 @@ TEST("async binary file I/O") {
     }
     check_eq(res.get(), expected<byte_buffer>{bytes});
   }
+  SECTION("read chunks with a size of 0") {
+    auto pub = async::file(sys, byte_range_file).read_chunks(0).run();
+    sys.spawn([pub, prom](event_based_actor* self) mutable {
+      pub.observe_on(self)
+        .do_on_error([prom](const error& err) { prom->set_value(err); })
+        .do_on_complete([prom] { prom->set_value(byte_buffer{}); })
+        .for_each([](const chunk&) {});
+    });
+    if (res.wait_for(2s) != std::future_status::ready) {
+      fail("timeout");
+    }
+    check_eq(res.get(), expected<byte_buffer>{sec::invalid_argument});
+  }
+}
+
+TEST("the line splitter accepts all line separators") {
+  using string_list = std::vector<std::string>;
+  auto lines = string_list{};
+  auto add = [&lines](const cow_string& line) { lines.push_back(line.str()); };
+  detail::line_splitter uut;
+  SECTION("separators within a block") {
+    uut.split("a\nb\r\nc\rd", add);
+    check_eq(lines, string_list({"a", "b", "c"}));
+    check_eq(uut.finish().str(), "d");
+  }
+  SECTION("separators that span two blocks") {
+    uut.split("a\r", add);
+    uut.split("\nb\r", add);
+    uut.split("\r", add);
+    uut.split("\nc", add);
+    check_eq(lines, string_list({"a", "b", ""}));
+    check_eq(uut.finish().str(), "c");
+  }
+  SECTION("empty lines") {
+    uut.split("\n\n\r\r\n", add);
+    check_eq(lines, string_list({"", "", "", ""}));
+    check_eq(uut.finish().str(), "");
+  }
+}
+
+TEST("async file sink") {
+  auto dir = std::filesystem::temp_directory_path() / "caf-file-sink-test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  auto out_file = (dir / "out.bin").string();
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  auto prom = std::make_shared<std::promise<expected<size_t>>>();
+  auto res = prom->get_future();
+  SECTION("write chunks to a file") {
+    auto opts = async::file_sink_options{};
+    opts.buffer_size = 64;
+    opts.sync_interval = 1ms;
+    auto pub = async::file(sys, byte_range_file).read_chunks(10).run();
+    auto fut = async::file(sys, out_file).write_chunks(pub, opts);
+    sys.spawn([fut, prom](event_based_actor* self) {
+      fut.bind_to(self).then(
+        [prom](size_t n) { prom->set_value(n); },
+        [prom](const error& err) { prom->set_value(err); });
+    });
+    if (res.wait_for(2s) != std::future_status::ready) {
+      fail("timeout");
+    }
+    check_eq(res.get(), expected<size_t>{256u});
+    std::ifstream in{out_file, std::ios::binary};
+    auto written = std::string{std::istreambuf_iterator<char>{in},
+                               std::istreambuf_iterator<char>{}};
+    require_eq(written.size(), 256u);
+    for (size_t i = 0; i < 256; ++i)
+      check_eq(static_cast<unsigned char>(written[i]), i);
+  }
+  SECTION("write to a file that cannot be opened") {
+    auto pub = async::file(sys, byte_range_file).read_chunks(10).run();
+    auto invalid_path = (dir / "no-such-dir" / "out.bin").string();
+    auto fut = async::file(sys, invalid_path).write_chunks(pub);
+    sys.spawn([fut, prom](event_based_actor* self) {
+      fut.bind_to(self).then(
+        [prom](size_t n) { prom->set_value(n); },
+        [prom](const error& err) { prom->set_value(err); });
+    });
+    if (res.wait_for(2s) != std::future_status::ready) {
+      fail("timeout");
+    }
+    check_eq(res.get(), expected<size_t>{sec::cannot_open_file});
+  }
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
 }
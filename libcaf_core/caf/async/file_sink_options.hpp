@@ -0,0 +1,43 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/timespan.hpp"
+
+#include <cstddef>
+
+namespace caf::async {
+
+/// Configures how a file sink writes its input to disk.
+struct file_sink_options {
+  /// Size of the write buffer. The sink collects its input in this buffer and
+  /// writes to the file in blocks of this size.
+  size_t buffer_size = 64 * 1024;
+
+  /// Synchronizes the file with the storage device after writing this many
+  /// bytes. A value of 0 disables synchronizing by size.
+  size_t sync_bytes = 0;
+
+  /// Synchronizes pending writes with the storage device after this amount of
+  /// time. A value of 0 disables synchronizing by time.
+  timespan sync_interval = timespan{0};
+
+  /// Configures whether synchronizing only flushes the content of the file
+  /// (`fdatasync`) or also its metadata (`fsync`). Falls back to `fsync` on
+  /// platforms that have no `fdatasync`.
+  bool sync_data_only = true;
+
+  /// Starts a new file before the current file exceeds this size. The sink
+  /// renames full files by appending an increasing index to their name, e.g.,
+  /// `out.log.1`. The index continues after the rotated files of earlier
+  /// runs. A value of 0 disables rotation.
+  size_t max_file_size = 0;
+
+  /// Configures whether the sink appends to an existing file instead of
+  /// truncating it.
+  bool append = false;
+};
+
+} // namespace caf::async
@@ -23,6 +23,18 @@ class consumer_resource;
 template <class T>
 class future;
 
+template <class T>
+class mpsc_buffer;
+
+template <class T>
+class mpsc_buffer_port;
+
+template <class T>
+class mpsc_consumer_resource;
+
+template <class T>
+class mpsc_producer_resource;
+
 template <class T>
 class producer_resource;
 
@@ -35,7 +47,7 @@ class publisher;
 template <class T>
 class spsc_buffer;
 
-template <class T>
+template <class T, class Buffer = spsc_buffer<T>>
 class blocking_producer;
 
 // -- smart pointer aliases ----------------------------------------------------
@@ -0,0 +1,751 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/async/consumer.hpp"
+#include "caf/async/policy.hpp"
+#include "caf/async/producer.hpp"
+#include "caf/config.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/error.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace caf::async {
+
+template <class T>
+class mpsc_buffer_port;
+
+/// A Multi Producer Single Consumer buffer. Producers do not access the buffer
+/// directly. Instead, each producer writes to its own @ref mpsc_buffer_port
+/// that shares the storage of the buffer with all other ports. Like the
+/// @ref spsc_buffer, this buffer uses a "soft bound": producers may add more
+/// items than their demand allows, but the buffer only signals demand for
+/// items up to its capacity.
+///
+/// The buffer splits the free capacity evenly between all producers: each
+/// producer may hold at most `capacity / num_producers` (but at least one)
+/// slots of unused demand at any time. Demand that producers have not used yet
+/// returns to the shared pool whenever a producer leaves. Hence, slow or idle
+/// producers can never starve other producers.
+///
+/// The buffer closes once all producers have closed their port and no further
+/// producers can connect, i.e., all copies of the producer resource were
+/// either opened or destroyed. A single producer calling `abort` stops the
+/// entire flow: the consumer receives the error and all other producers get
+/// canceled.
+template <class T>
+class mpsc_buffer : public ref_counted {
+public:
+  // -- friends ----------------------------------------------------------------
+
+  friend class mpsc_buffer_port<T>;
+
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using lock_type = std::unique_lock<std::mutex>;
+
+  using port_type = mpsc_buffer_port<T>;
+
+  using port_ptr = intrusive_ptr<port_type>;
+
+  /// Packs various status flags for the buffer into a single struct.
+  struct flags {
+    /// Stores whether the consumer side has been closed.
+    bool closed : 1;
+    /// Stores whether `cancel` has been called.
+    bool canceled : 1;
+    /// Stores whether no new producers may connect to the buffer.
+    bool sealed : 1;
+    /// Stores whether we have called `on_producer_ready` on the consumer.
+    bool ready : 1;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  mpsc_buffer(size_t capacity, size_t min_pull_size)
+    : capacity_(capacity), min_pull_size_(min_pull_size), free_(capacity) {
+    std::memset(&flags_, 0, sizeof(flags));
+    buf_.reserve(capacity + (capacity / 2));
+    consumer_buf_.reserve(capacity);
+  }
+
+  // -- producer management ----------------------------------------------------
+
+  /// Creates a new port for writing to this buffer.
+  /// @returns a new port or `nullptr` if the buffer no longer accepts new
+  ///          producers.
+  port_ptr make_port();
+
+  /// Prevents any new producers from connecting to the buffer. Closes the
+  /// buffer if there are no open ports.
+  void seal() {
+    lock_type guard{mtx_};
+    flags_.sealed = true;
+    if (ports_.empty())
+      do_close(error{});
+  }
+
+  // -- consumer interface -----------------------------------------------------
+
+  /// Consumes up to `demand` items from the buffer.
+  /// @tparam Policy Either `instant_error_t`, `delay_error_t` or
+  ///                `ignore_errors_t`.
+  /// @returns a tuple indicating whether the consumer may call pull again and
+  ///          how many items were consumed. When returning `false` for the
+  ///          first tuple element, the function has called `on_complete` or
+  ///          `on_error` on the observer.
+  template <class Policy, class Observer>
+  std::pair<bool, size_t> pull(Policy policy, size_t demand, Observer& dst) {
+    lock_type guard{mtx_};
+    return pull_unsafe(guard, policy, demand, dst);
+  }
+
+  /// Checks whether there is any pending data in the buffer.
+  bool has_data() const noexcept {
+    lock_type guard{mtx_};
+    return !buf_.empty();
+  }
+
+  /// Checks whether the there is data available or whether the producers have
+  /// closed or aborted the flow.
+  bool has_consumer_event() const noexcept {
+    lock_type guard{mtx_};
+    return !buf_.empty() || flags_.closed;
+  }
+
+  /// Returns how many items are currently available. This may be greater than
+  /// the `capacity`.
+  size_t available() const noexcept {
+    lock_type guard{mtx_};
+    return buf_.size();
+  }
+
+  /// Returns the error from the producers or a default-constructed error if
+  /// no producer has called abort yet.
+  error abort_reason() const {
+    lock_type guard{mtx_};
+    return err_;
+  }
+
+  /// Returns the number of currently connected producers.
+  size_t num_producers() const noexcept {
+    lock_type guard{mtx_};
+    return ports_.size();
+  }
+
+  /// Closes the buffer by request of the consumer.
+  void cancel() {
+    lock_type guard{mtx_};
+    if (!flags_.canceled) {
+      flags_.canceled = true;
+      consumer_ = nullptr;
+      for (auto* port : ports_)
+        if (port->producer_)
+          port->producer_->on_consumer_cancel();
+    }
+  }
+
+  /// Consumer callback for the initial handshake between producers and the
+  /// consumer.
+  void set_consumer(consumer_ptr consumer) {
+    CAF_ASSERT(consumer != nullptr);
+    lock_type guard{mtx_};
+    if (consumer_)
+      CAF_RAISE_ERROR(std::logic_error, "MPSC buffer already has a consumer");
+    consumer_ = std::move(consumer);
+    if (flags_.closed) {
+      consumer_->on_producer_wakeup();
+      return;
+    }
+    for (auto* port : ports_) {
+      if (port->producer_) {
+        port->producer_->on_consumer_ready();
+        ready();
+      }
+    }
+    if (!buf_.empty())
+      consumer_->on_producer_wakeup();
+    distribute();
+  }
+
+  /// Returns the capacity as passed to the constructor of the buffer.
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // -- unsafe interface for manual locking ------------------------------------
+
+  /// Returns the mutex for this object.
+  auto& mtx() const noexcept {
+    return mtx_;
+  }
+
+  /// Returns how many items are currently available.
+  /// @pre 'mtx()' is locked.
+  size_t available_unsafe() const noexcept {
+    return buf_.size();
+  }
+
+  /// Returns the error from the producers.
+  /// @pre 'mtx()' is locked.
+  const error& abort_reason_unsafe() const noexcept {
+    return err_;
+  }
+
+  /// Blocks until there is at least one item available or the producers
+  /// stopped.
+  /// @pre the consumer calls `cv.notify_all()` in its `on_producer_wakeup`
+  void await_consumer_ready(lock_type& guard, std::condition_variable& cv) {
+    while (!flags_.closed && buf_.empty()) {
+      cv.wait(guard);
+    }
+  }
+
+  /// Blocks until there is at least one item available, the producers stopped,
+  /// or a timeout occurs.
+  /// @pre the consumer calls `cv.notify_all()` in its `on_producer_wakeup`
+  template <class TimePoint>
+  bool await_consumer_ready(lock_type& guard, std::condition_variable& cv,
+                            TimePoint timeout) {
+    while (!flags_.closed && buf_.empty())
+      if (cv.wait_until(guard, timeout) == std::cv_status::timeout)
+        return false;
+    return true;
+  }
+
+  template <class Policy, class Observer>
+  std::pair<bool, size_t>
+  pull_unsafe(lock_type& guard, Policy, size_t demand, Observer& dst) {
+    CAF_ASSERT(consumer_ != nullptr);
+    CAF_ASSERT(consumer_buf_.empty());
+    if constexpr (std::is_same_v<Policy, prioritize_errors_t>) {
+      if (err_) {
+        consumer_ = nullptr;
+        dst.on_error(err_);
+        return {false, 0};
+      }
+    }
+    auto next_n = [this, &demand] { return std::min(demand, buf_.size()); };
+    size_t consumed = 0;
+    for (auto n = next_n(); n > 0; n = next_n()) {
+      using std::make_move_iterator;
+      consumer_buf_.assign(make_move_iterator(buf_.begin()),
+                           make_move_iterator(buf_.begin() + n));
+      buf_.erase(buf_.begin(), buf_.begin() + n);
+      // Excess items were pushed without demand. Hence, they must not return
+      // any demand to the pool when consuming them.
+      auto excess = buf_.size() + n - credited_;
+      if (n > excess) {
+        auto released = n - excess;
+        credited_ -= released;
+        free_ += released;
+        distribute();
+      }
+      guard.unlock();
+      auto items = std::span<const T>{consumer_buf_.data(), n};
+      for (auto& item : items)
+        dst.on_next(item);
+      demand -= n;
+      consumed += n;
+      consumer_buf_.clear();
+      guard.lock();
+    }
+    if (!buf_.empty() || !flags_.closed) {
+      return {true, consumed};
+    }
+    consumer_ = nullptr;
+    if (!err_)
+      dst.on_complete();
+    else
+      dst.on_error(err_);
+    return {false, consumed};
+  }
+
+private:
+  // -- port callbacks ---------------------------------------------------------
+
+  size_t port_push(port_type* port, std::span<const T> items) {
+    lock_type guard{mtx_};
+    CAF_ASSERT(!port->closed_);
+    if (flags_.closed || flags_.canceled)
+      return 0;
+    buf_.insert(buf_.end(), items.begin(), items.end());
+    if (buf_.size() == items.size() && consumer_)
+      consumer_->on_producer_wakeup();
+    auto used = std::min(port->demand_, items.size());
+    port->demand_ -= used;
+    credited_ += used;
+    if (capacity_ > buf_.size())
+      return capacity_ - buf_.size();
+    else
+      return 0;
+  }
+
+  void port_set_producer(port_type* port, producer_ptr producer) {
+    lock_type guard{mtx_};
+    if (port->producer_)
+      CAF_RAISE_ERROR(std::logic_error,
+                      "MPSC buffer port already has a producer");
+    if (port->closed_)
+      return;
+    port->producer_ = std::move(producer);
+    if (consumer_) {
+      port->producer_->on_consumer_ready();
+      ready();
+      distribute();
+    } else if (flags_.canceled || flags_.closed) {
+      port->producer_->on_consumer_cancel();
+    }
+  }
+
+  void port_close(port_type* port, error reason) {
+    lock_type guard{mtx_};
+    if (port->closed_)
+      return;
+    port->closed_ = true;
+    free_ += port->demand_;
+    port->demand_ = 0;
+    port->producer_ = nullptr;
+    ports_.erase(std::find(ports_.begin(), ports_.end(), port));
+    if (reason) {
+      for (auto* other : ports_)
+        if (other->producer_)
+          other->producer_->on_consumer_cancel();
+      do_close(std::move(reason));
+    } else if (ports_.empty() && flags_.sealed) {
+      do_close(error{});
+    } else {
+      distribute();
+    }
+  }
+
+  // -- utility functions ------------------------------------------------------
+
+  void ready() {
+    if (!flags_.ready) {
+      flags_.ready = true;
+      consumer_->on_producer_ready();
+    }
+  }
+
+  void do_close(error reason) {
+    if (!flags_.closed) {
+      flags_.closed = true;
+      err_ = std::move(reason);
+      if (buf_.empty() && consumer_)
+        consumer_->on_producer_wakeup();
+    }
+  }
+
+  /// Hands out free capacity to producers in round-robin order.
+  /// @pre 'mtx_' is locked.
+  void distribute() {
+    if (!consumer_ || flags_.closed || free_ == 0 || ports_.empty())
+      return;
+    auto num_ports = ports_.size();
+    auto share = std::max(capacity_ / num_ports, size_t{1});
+    auto threshold = std::min(min_pull_size_, share);
+    for (size_t i = 0; i < num_ports && free_ > 0; ++i) {
+      auto* port = ports_[(next_ + i) % num_ports];
+      if (!port->producer_ || port->demand_ >= share)
+        continue;
+      auto n = std::min(share - port->demand_, free_);
+      // Batch small amounts of demand unless the producer is idle.
+      if (n < threshold && port->demand_ > 0)
+        continue;
+      port->demand_ += n;
+      free_ -= n;
+      port->producer_->on_consumer_demand(n);
+    }
+    next_ = (next_ + 1) % num_ports;
+  }
+
+  /// Guards access to all other member variables, including the state of the
+  /// ports.
+  mutable std::mutex mtx_;
+
+  /// Caches in-flight items.
+  std::vector<T> buf_;
+
+  /// Stores how many items the buffer may hold at any time.
+  size_t capacity_;
+
+  /// Configures the minimum amount of demand that we signal to a producer
+  /// unless it has no demand at all.
+  size_t min_pull_size_;
+
+  /// Capacity that is neither in use nor signaled to any of the producers.
+  size_t free_;
+
+  /// Number of items in `buf_` that were pushed by producers with demand.
+  size_t credited_ = 0;
+
+  /// Round-robin offset into `ports_` for fair distribution of demand.
+  size_t next_ = 0;
+
+  /// Stores various status flags.
+  flags flags_;
+
+  /// Stores the abort reason.
+  error err_;
+
+  /// Callback handle to the consumer.
+  consumer_ptr consumer_;
+
+  /// Stores all open ports. Ports remove themselves from this list when
+  /// closing and keep the buffer alive until then.
+  std::vector<port_type*> ports_;
+
+  /// Caches items before passing them to the consumer (without lock).
+  std::vector<T> consumer_buf_;
+};
+
+/// @relates mpsc_buffer
+template <class T>
+using mpsc_buffer_ptr = intrusive_ptr<mpsc_buffer<T>>;
+
+/// Write handle of a single producer to an @ref mpsc_buffer. Offers the same
+/// interface to producers as an @ref spsc_buffer.
+template <class T>
+class mpsc_buffer_port : public ref_counted {
+public:
+  // -- friends ----------------------------------------------------------------
+
+  friend class mpsc_buffer<T>;
+
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using buffer_ptr = mpsc_buffer_ptr<T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit mpsc_buffer_port(buffer_ptr buf) : buf_(std::move(buf)) {
+    // nop
+  }
+
+  ~mpsc_buffer_port() override {
+    buf_->port_close(this, error{});
+  }
+
+  // -- producer interface -----------------------------------------------------
+
+  /// Appends to the buffer and calls `on_producer_wakeup` on the consumer if
+  /// the buffer becomes non-empty.
+  /// @returns the remaining capacity of the buffer after inserting the items.
+  size_t push(std::span<const T> items) {
+    return buf_->port_push(this, items);
+  }
+
+  size_t push(const T& item) {
+    return push(std::span{&item, 1});
+  }
+
+  /// Closes this port. The buffer closes once all ports are closed.
+  void close() {
+    buf_->port_close(this, error{});
+  }
+
+  /// Closes this port and aborts the buffer, i.e., the consumer receives
+  /// `reason` and all other producers get canceled.
+  void abort(error reason) {
+    if (!reason)
+      reason = make_error(sec::runtime_error);
+    buf_->port_close(this, std::move(reason));
+  }
+
+  /// Producer callback for the initial handshake between producer and consumer.
+  void set_producer(producer_ptr producer) {
+    CAF_ASSERT(producer != nullptr);
+    buf_->port_set_producer(this, std::move(producer));
+  }
+
+  /// Returns the capacity of the shared buffer.
+  size_t capacity() const noexcept {
+    return buf_->capacity();
+  }
+
+  /// Returns the shared buffer.
+  const buffer_ptr& buffer() const noexcept {
+    return buf_;
+  }
+
+private:
+  /// Points to the shared buffer.
+  buffer_ptr buf_;
+
+  /// Callback handle to the producer. Guarded by the mutex of the buffer.
+  producer_ptr producer_;
+
+  /// Demand that we have signaled to the producer but that it did not use yet.
+  /// Guarded by the mutex of the buffer.
+  size_t demand_ = 0;
+
+  /// Stores whether this port has been closed. Guarded by the mutex of the
+  /// buffer.
+  bool closed_ = false;
+};
+
+/// @relates mpsc_buffer_port
+template <class T>
+using mpsc_buffer_port_ptr = intrusive_ptr<mpsc_buffer_port<T>>;
+
+template <class T>
+typename mpsc_buffer<T>::port_ptr mpsc_buffer<T>::make_port() {
+  auto res = port_ptr{};
+  {
+    lock_type guard{mtx_};
+    if (flags_.closed || flags_.sealed)
+      return res;
+    res.emplace(this);
+    ports_.push_back(res.get());
+  }
+  return res;
+}
+
+/// @relates mpsc_buffer
+template <class T, bool IsProducer>
+struct mpsc_resource_ctrl : ref_counted {
+  using buffer_ptr = mpsc_buffer_ptr<T>;
+
+  explicit mpsc_resource_ctrl(buffer_ptr ptr) : buf(std::move(ptr)) {
+    // nop
+  }
+
+  ~mpsc_resource_ctrl() {
+    if constexpr (IsProducer) {
+      buf->seal();
+    } else {
+      if (buf)
+        buf->cancel();
+    }
+  }
+
+  buffer_ptr try_open() {
+    auto res = buffer_ptr{};
+    std::unique_lock guard{mtx};
+    if (buf) {
+      res.swap(buf);
+    }
+    return res;
+  }
+
+  mutable std::mutex mtx;
+  buffer_ptr buf;
+};
+
+/// Grants read access to the first consumer that calls `open` on the resource.
+/// Cancels consumption of items on the buffer if the resources gets destroyed
+/// before opening it.
+/// @relates mpsc_buffer
+template <class T>
+class mpsc_consumer_resource {
+public:
+  using value_type = T;
+
+  using buffer_type = mpsc_buffer<T>;
+
+  using buffer_ptr = mpsc_buffer_ptr<T>;
+
+  explicit mpsc_consumer_resource(buffer_ptr buf) {
+    ctrl_.emplace(std::move(buf));
+  }
+
+  mpsc_consumer_resource() = default;
+
+  mpsc_consumer_resource(mpsc_consumer_resource&&) = default;
+
+  mpsc_consumer_resource(const mpsc_consumer_resource&) = default;
+
+  mpsc_consumer_resource& operator=(mpsc_consumer_resource&&) = default;
+
+  mpsc_consumer_resource& operator=(const mpsc_consumer_resource&) = default;
+
+  mpsc_consumer_resource& operator=(std::nullptr_t) {
+    ctrl_ = nullptr;
+    return *this;
+  }
+
+  /// Tries to open the resource for reading from the buffer. The first `open`
+  /// wins on concurrent access.
+  /// @returns a pointer to the buffer on success, `nullptr` otherwise.
+  buffer_ptr try_open() {
+    if (ctrl_) {
+      auto res = ctrl_->try_open();
+      ctrl_ = nullptr;
+      return res;
+    } else {
+      return nullptr;
+    }
+  }
+
+  /// Convenience function for calling
+  /// `ctx->make_observable().from_resource(*this)`.
+  template <class Coordinator>
+  auto observe_on(Coordinator* ctx) const {
+    return ctx->make_observable().from_resource(*this);
+  }
+
+  /// Calls `try_open` and on success immediately calls `cancel` on the buffer.
+  void cancel() {
+    if (auto buf = try_open())
+      buf->cancel();
+  }
+
+  [[nodiscard]] bool valid() const noexcept {
+    return ctrl_ != nullptr;
+  }
+
+  explicit operator bool() const noexcept {
+    return valid();
+  }
+
+  bool operator!() const noexcept {
+    return !valid();
+  }
+
+  friend bool operator==(const mpsc_consumer_resource& lhs,
+                         const mpsc_consumer_resource& rhs) {
+    return lhs.ctrl_ == rhs.ctrl_;
+  }
+
+  friend bool operator!=(const mpsc_consumer_resource& lhs,
+                         const mpsc_consumer_resource& rhs) {
+    return lhs.ctrl_ != rhs.ctrl_;
+  }
+
+private:
+  intrusive_ptr<mpsc_resource_ctrl<T, false>> ctrl_;
+};
+
+/// Grants write access to an @ref mpsc_buffer. Unlike a
+/// @ref producer_resource, each copy of this resource may be opened once,
+/// i.e., copying the resource allows multiple producers to write to the same
+/// buffer. The buffer closes after all copies of the resource have been
+/// destroyed or opened and all producers closed their port.
+/// @relates mpsc_buffer
+template <class T>
+class mpsc_producer_resource {
+public:
+  using value_type = T;
+
+  using buffer_type = mpsc_buffer<T>;
+
+  using buffer_ptr = mpsc_buffer_ptr<T>;
+
+  using port_type = mpsc_buffer_port<T>;
+
+  using port_ptr = mpsc_buffer_port_ptr<T>;
+
+  explicit mpsc_producer_resource(buffer_ptr buf) {
+    ctrl_.emplace(std::move(buf));
+  }
+
+  mpsc_producer_resource() = default;
+
+  mpsc_producer_resource(mpsc_producer_resource&&) = default;
+
+  mpsc_producer_resource(const mpsc_producer_resource&) = default;
+
+  mpsc_producer_resource& operator=(mpsc_producer_resource&&) = default;
+
+  mpsc_producer_resource& operator=(const mpsc_producer_resource&) = default;
+
+  mpsc_producer_resource& operator=(std::nullptr_t) {
+    ctrl_ = nullptr;
+    return *this;
+  }
+
+  /// Tries to open a new port for writing to the buffer. Invalidates this
+  /// resource but leaves other copies of it untouched.
+  /// @returns a pointer to a new port on success, `nullptr` otherwise.
+  port_ptr try_open() {
+    if (ctrl_) {
+      auto res = ctrl_->buf->make_port();
+      ctrl_ = nullptr;
+      return res;
+    } else {
+      return nullptr;
+    }
+  }
+
+  /// Calls `try_open` and on success immediately calls `close` on the port.
+  void close() {
+    if (auto port = try_open())
+      port->close();
+  }
+
+  /// Calls `try_open` and on success immediately calls `abort` on the port.
+  void abort(error reason) {
+    if (auto port = try_open())
+      port->abort(std::move(reason));
+  }
+
+  [[nodiscard]] bool valid() const noexcept {
+    return ctrl_ != nullptr;
+  }
+
+  explicit operator bool() const noexcept {
+    return valid();
+  }
+
+  bool operator!() const noexcept {
+    return !valid();
+  }
+
+  friend bool operator==(const mpsc_producer_resource& lhs,
+                         const mpsc_producer_resource& rhs) {
+    return lhs.ctrl_ == rhs.ctrl_;
+  }
+
+  friend bool operator!=(const mpsc_producer_resource& lhs,
+                         const mpsc_producer_resource& rhs) {
+    return lhs.ctrl_ != rhs.ctrl_;
+  }
+
+private:
+  intrusive_ptr<mpsc_resource_ctrl<T, true>> ctrl_;
+};
+
+template <class T>
+using mpsc_resource_pair
+  = std::pair<mpsc_consumer_resource<T>, mpsc_producer_resource<T>>;
+
+/// Creates an @ref mpsc_buffer and returns two resources connected by that
+/// buffer.
+template <class T>
+mpsc_resource_pair<T>
+make_mpsc_buffer_resource(size_t buffer_size, size_t min_request_size) {
+  using buffer_type = mpsc_buffer<T>;
+  auto buf = make_counted<buffer_type>(buffer_size, min_request_size);
+  return {async::mpsc_consumer_resource<T>{buf},
+          async::mpsc_producer_resource<T>{buf}};
+}
+
+/// Creates an @ref mpsc_buffer and returns two resources connected by that
+/// buffer.
+template <class T>
+mpsc_resource_pair<T> make_mpsc_buffer_resource() {
+  return make_mpsc_buffer_resource<T>(defaults::flow::buffer_size,
+                                      defaults::flow::min_demand);
+}
+
+} // namespace caf::async
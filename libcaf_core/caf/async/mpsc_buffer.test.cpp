@@ -0,0 +1,316 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/async/mpsc_buffer.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/async/blocking_producer.hpp"
+#include "caf/cow_vector.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/observable_builder.hpp"
+#include "caf/scheduled_actor/flow.hpp"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+using namespace caf;
+
+namespace {
+
+class dummy_producer : public async::producer {
+public:
+  dummy_producer() = default;
+  dummy_producer(const dummy_producer&) = delete;
+  dummy_producer& operator=(const dummy_producer&) = delete;
+
+  void on_consumer_ready() override {
+    consumer_ready = true;
+  }
+
+  void on_consumer_cancel() override {
+    consumer_cancel = true;
+  }
+
+  void on_consumer_demand(size_t new_demand) override {
+    demand += new_demand;
+  }
+
+  void ref_producer() const noexcept override {
+    ++rc;
+  }
+
+  void deref_producer() const noexcept override {
+    if (--rc == 0)
+      delete this;
+  }
+
+  mutable size_t rc = 1;
+  bool consumer_ready = false;
+  bool consumer_cancel = false;
+  size_t demand = 0;
+};
+
+class dummy_consumer : public async::consumer {
+public:
+  dummy_consumer() = default;
+  dummy_consumer(const dummy_consumer&) = delete;
+  dummy_consumer& operator=(const dummy_consumer&) = delete;
+
+  void on_producer_ready() override {
+    producer_ready = true;
+  }
+
+  void on_producer_wakeup() override {
+    ++producer_wakeups;
+  }
+
+  void ref_consumer() const noexcept override {
+    ++rc;
+  }
+
+  void deref_consumer() const noexcept override {
+    if (--rc == 0)
+      delete this;
+  }
+
+  mutable size_t rc = 1;
+  bool producer_ready = false;
+  size_t producer_wakeups = 0;
+};
+
+struct dummy_observer {
+  void on_next(int x) {
+    values.push_back(x);
+  }
+
+  void on_error(error what) {
+    err = std::move(what);
+  }
+
+  void on_complete() {
+    completed = true;
+  }
+
+  std::vector<int> values;
+
+  bool completed = false;
+
+  error err;
+};
+
+using buffer_type = async::mpsc_buffer<int>;
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys;
+
+  fixture() : sys(cfg.set("caf.scheduler.max-threads", 2)) {
+    // nop
+  }
+};
+
+} // namespace
+
+WITH_FIXTURE(test::fixture::deterministic) {
+
+SCENARIO("MPSC buffers split the demand between all producers") {
+  GIVEN("an MPSC buffer with a capacity of 10 and two producers") {
+    auto buf = make_counted<buffer_type>(10, 2);
+    auto cons = make_counted<dummy_consumer>();
+    auto prod1 = make_counted<dummy_producer>();
+    auto prod2 = make_counted<dummy_producer>();
+    auto port1 = buf->make_port();
+    auto port2 = buf->make_port();
+    port1->set_producer(prod1);
+    port2->set_producer(prod2);
+    check_eq(buf->num_producers(), 2u);
+    WHEN("the consumer connects to the buffer") {
+      buf->set_consumer(cons);
+      THEN("each producer receives half of the capacity as demand") {
+        check(cons->producer_ready);
+        check(prod1->consumer_ready);
+        check(prod2->consumer_ready);
+        check_eq(prod1->demand, 5u);
+        check_eq(prod2->demand, 5u);
+      }
+    }
+    WHEN("one producer closes its port") {
+      buf->set_consumer(cons);
+      port1->close();
+      THEN("its unused demand goes to the remaining producer") {
+        check_eq(buf->num_producers(), 1u);
+        check_eq(prod2->demand, 10u);
+      }
+    }
+    WHEN("the consumer pulls items") {
+      buf->set_consumer(cons);
+      port1->push(std::vector<int>{1, 2, 3, 4, 5});
+      prod1->demand = 0;
+      check_eq(cons->producer_wakeups, 1u);
+      port2->push(6);
+      prod2->demand -= 1;
+      check_eq(cons->producer_wakeups, 1u);
+      dummy_observer obs;
+      auto [ok, consumed] = buf->pull(async::delay_errors, 20, obs);
+      THEN("the buffer returns the demand to the producers") {
+        check(ok);
+        check_eq(consumed, 6u);
+        check_eq(obs.values, std::vector<int>({1, 2, 3, 4, 5, 6}));
+        check_eq(prod1->demand, 5u);
+        // Small amounts of demand get batched for producers that still have
+        // some demand left.
+        check_eq(prod2->demand, 4u);
+      }
+    }
+    WHEN("the consumer cancels") {
+      buf->set_consumer(cons);
+      buf->cancel();
+      THEN("all producers receive on_consumer_cancel") {
+        check(prod1->consumer_cancel);
+        check(prod2->consumer_cancel);
+      }
+    }
+  }
+}
+
+SCENARIO("MPSC buffers close after all producers closed") {
+  GIVEN("an MPSC buffer resource") {
+    auto [rd, wr] = async::make_mpsc_buffer_resource<int>(10, 2);
+    auto buf = rd.try_open();
+    require(buf != nullptr);
+    auto cons = make_counted<dummy_consumer>();
+    buf->set_consumer(cons);
+    WHEN("opening two ports and closing one of them") {
+      auto port1 = async::mpsc_producer_resource<int>{wr}.try_open();
+      auto port2 = async::mpsc_producer_resource<int>{wr}.try_open();
+      require(port1 != nullptr);
+      require(port2 != nullptr);
+      wr = nullptr;
+      port1->push(1);
+      port1->close();
+      port2->push(2);
+      THEN("the buffer remains open until the last port closes") {
+        dummy_observer obs;
+        auto [ok, consumed] = buf->pull(async::delay_errors, 10, obs);
+        check(ok);
+        check_eq(consumed, 2u);
+        check(!obs.completed);
+        port2->close();
+        std::tie(ok, consumed) = buf->pull(async::delay_errors, 10, obs);
+        check(!ok);
+        check(obs.completed);
+        check_eq(obs.values, std::vector<int>({1, 2}));
+      }
+    }
+    WHEN("aborting one of the ports") {
+      auto prod = make_counted<dummy_producer>();
+      auto port1 = async::mpsc_producer_resource<int>{wr}.try_open();
+      auto port2 = async::mpsc_producer_resource<int>{wr}.try_open();
+      port2->set_producer(prod);
+      port1->abort(sec::runtime_error);
+      THEN("the consumer receives the error and other producers get canceled") {
+        check(prod->consumer_cancel);
+        dummy_observer obs;
+        auto [ok, consumed] = buf->pull(async::delay_errors, 10, obs);
+        check(!ok);
+        check_eq(consumed, 0u);
+        check_eq(obs.err, sec::runtime_error);
+      }
+    }
+    WHEN("destroying all producer resources without opening them") {
+      wr = nullptr;
+      THEN("the buffer closes immediately") {
+        dummy_observer obs;
+        auto [ok, consumed] = buf->pull(async::delay_errors, 10, obs);
+        check(!ok);
+        check(obs.completed);
+      }
+    }
+  }
+}
+
+SCENARIO("MPSC buffers connect multiple producers to a flow") {
+  GIVEN("an MPSC buffer resource") {
+    WHEN("opening the write end multiple times") {
+      THEN("the observer receives the data from all producers") {
+        using actor_t = event_based_actor;
+        auto [rd, wr] = async::make_mpsc_buffer_resource<int>(6, 2);
+        auto outputs = std::vector<int>{};
+        auto completed = false;
+        sys.spawn([rd{rd}, &outputs, &completed](actor_t* snk) {
+          snk->make_observable()
+            .from_resource(rd)
+            .do_on_complete([&completed] { completed = true; })
+            .for_each([&outputs](int x) { outputs.emplace_back(x); });
+        });
+        dispatch_messages();
+        auto port1 = async::mpsc_producer_resource<int>{wr}.try_open();
+        auto port2 = async::mpsc_producer_resource<int>{wr}.try_open();
+        wr = nullptr;
+        port1->push(std::vector<int>{1, 2, 3});
+        port2->push(std::vector<int>{4, 5, 6});
+        port1->close();
+        dispatch_messages();
+        check_eq(outputs, std::vector<int>({1, 2, 3, 4, 5, 6}));
+        check(!completed);
+        port2->push(7);
+        port2->close();
+        dispatch_messages();
+        check_eq(outputs, std::vector<int>({1, 2, 3, 4, 5, 6, 7}));
+        check(completed);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(test::fixture::deterministic)
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("blocking producers may write to the same MPSC buffer") {
+  GIVEN("an MPSC buffer resource and multiple producer threads") {
+    WHEN("consuming the buffer from an actor") {
+      THEN("the actor receives all values from all producers") {
+        auto [rd, wr] = async::make_mpsc_buffer_resource<int>(8, 2);
+        auto result = std::make_shared<std::promise<std::vector<int>>>();
+        auto values = result->get_future();
+        sys.spawn([rd{rd}, result](event_based_actor* snk) {
+          snk->make_observable()
+            .from_resource(rd)
+            .to_vector()
+            .for_each([result](const cow_vector<int>& values) {
+              result->set_value(values.std());
+            });
+        });
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+          auto out = async::make_blocking_producer(wr);
+          require(out.has_value());
+          threads.emplace_back([out{std::move(*out)}, i]() mutable {
+            for (int j = i * 500; j < (i + 1) * 500; ++j)
+              out.push(j);
+          });
+        }
+        wr = nullptr;
+        auto got = values.get();
+        for (auto& hdl : threads)
+          hdl.join();
+        auto want = std::vector<int>(4000);
+        std::iota(want.begin(), want.end(), 0);
+        std::sort(got.begin(), got.end());
+        check_eq(got, want);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
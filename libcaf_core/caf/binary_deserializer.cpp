@@ -5,6 +5,7 @@
 #include "caf/binary_deserializer.hpp"
 
 #include "caf/actor_system.hpp"
+#include "caf/detail/concepts.hpp"
 #include "caf/detail/ieee_754.hpp"
 #include "caf/detail/network_order.hpp"
 #include "caf/error.hpp"
@@ -21,6 +22,12 @@ namespace {
 template <class T>
 constexpr size_t max_value = static_cast<size_t>(std::numeric_limits<T>::max());
 
+/// Element types that support reading a sequence of values at once.
+template <class T>
+concept bulk_value = detail::one_of<T, std::byte, int8_t, uint8_t, int16_t,
+                                    uint16_t, int32_t, uint32_t, int64_t,
+                                    uint64_t, float, double>;
+
 class impl : public load_inspector_base<impl>,
              public internal::fast_pimpl<impl> {
 public:
@@ -64,6 +71,14 @@ public:
     return end_;
   }
 
+  binary_encoding encoding() const noexcept {
+    return encoding_;
+  }
+
+  void encoding(binary_encoding value) noexcept {
+    encoding_ = value;
+  }
+
   static constexpr bool has_human_readable_format() noexcept {
     return false;
   }
@@ -240,27 +255,27 @@ public:
   }
 
   bool value(int16_t& x) noexcept {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(uint16_t& x) noexcept {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(int32_t& x) noexcept {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(uint32_t& x) noexcept {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(int64_t& x) noexcept {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(uint64_t& x) noexcept {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(float& x) noexcept {
@@ -311,6 +326,28 @@ public:
     return end_sequence();
   }
 
+  bool view(std::string_view& x) noexcept {
+    auto bytes = const_byte_span{};
+    if (!view(bytes))
+      return false;
+    x = std::string_view{reinterpret_cast<const char*>(bytes.data()),
+                         bytes.size()};
+    return true;
+  }
+
+  bool view(const_byte_span& x) noexcept {
+    size_t size = 0;
+    if (!begin_sequence(size))
+      return false;
+    if (!range_check(size)) {
+      emplace_error(sec::end_of_stream);
+      return false;
+    }
+    x = const_byte_span{current_, size};
+    current_ += size;
+    return end_sequence();
+  }
+
   bool value(std::u16string& x) {
     x.clear();
     size_t str_size = 0;
@@ -429,12 +466,85 @@ public:
     return true;
   }
 
+  template <bulk_value T>
+  bool values(std::span<T> xs) {
+    if constexpr (sizeof(T) == 1) {
+      return value(as_writable_bytes(xs));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      using packed_type = typename detail::ieee_754_trait<T>::packed_type;
+      if (!range_check(xs.size() * sizeof(packed_type))) {
+        emplace_error(sec::end_of_stream);
+        return false;
+      }
+      for (auto& x : xs) {
+        packed_type tmp;
+        unsafe_int_value(tmp);
+        x = detail::unpack754(tmp);
+      }
+      return true;
+    } else if (encoding_ == binary_encoding::compact) {
+      for (auto& x : xs)
+        if (!varint_value(x))
+          return false;
+      return true;
+    } else {
+      if (!range_check(xs.size_bytes())) {
+        emplace_error(sec::end_of_stream);
+        return false;
+      }
+      detail::from_network_order(current_, xs.size(), xs.data());
+      current_ += xs.size_bytes();
+      return true;
+    }
+  }
+
 private:
   /// Checks whether we can read `read_size` more bytes.
   bool range_check(size_t read_size) const noexcept {
     return current_ + read_size <= end_;
   }
 
+  /// Reads `x` using the configured encoding.
+  template <class T>
+  bool integer_value(T& x) {
+    if (encoding_ == binary_encoding::compact)
+      return varint_value(x);
+    return int_value(x);
+  }
+
+  /// Reads `x` from a LEB128 varint. Reverses the zig-zag encoding for signed
+  /// integers.
+  template <class T>
+  bool varint_value(T& x) {
+    using unsigned_type = std::make_unsigned_t<T>;
+    constexpr auto num_bits = std::numeric_limits<unsigned_type>::digits;
+    auto y = unsigned_type{0};
+    for (int shift = 0;; shift += 7) {
+      if (!range_check(1)) {
+        emplace_error(sec::end_of_stream);
+        return false;
+      }
+      auto low7 = static_cast<uint8_t>(*current_++);
+      auto bits = static_cast<unsigned_type>(low7 & 0x7f);
+      // Reject encodings with more significant bits than T can hold.
+      if (shift >= num_bits
+          || (num_bits - shift < 7 && (bits >> (num_bits - shift)) != 0)) {
+        emplace_error(sec::malformed_message);
+        return false;
+      }
+      y |= static_cast<unsigned_type>(bits << shift);
+      if ((low7 & 0x80) == 0)
+        break;
+    }
+    if constexpr (std::is_signed_v<T>) {
+      auto sign = static_cast<unsigned_type>(0 - (y & 1));
+      x = static_cast<T>(static_cast<unsigned_type>((y >> 1) ^ sign));
+    } else {
+      x = y;
+    }
+    return true;
+  }
+
   template <class T>
   bool int_value(T& x) {
     auto tmp = std::make_unsigned_t<T>{};
@@ -477,6 +587,9 @@ private:
 
   /// The last occurred error.
   error err_;
+
+  /// Configures how to read integers.
+  binary_encoding encoding_ = binary_encoding::fixed;
 };
 
 } // namespace
@@ -536,6 +649,14 @@ const std::byte* binary_deserializer::end() const noexcept {
   return impl::cast(impl_).end();
 }
 
+binary_encoding binary_deserializer::encoding() const noexcept {
+  return impl::cast(impl_).encoding();
+}
+
+void binary_deserializer::encoding(binary_encoding value) noexcept {
+  impl::cast(impl_).encoding(value);
+}
+
 // -- overridden member functions --------------------------------------------
 
 void binary_deserializer::set_error(error stop_reason) {
@@ -697,4 +818,56 @@ bool binary_deserializer::value(weak_actor_ptr& ptr) {
   return impl::cast(impl_).value(ptr);
 }
 
+bool binary_deserializer::view(std::string_view& x) noexcept {
+  return impl::cast(impl_).view(x);
+}
+
+bool binary_deserializer::view(const_byte_span& x) noexcept {
+  return impl::cast(impl_).view(x);
+}
+
+bool binary_deserializer::values(std::span<std::byte> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<int8_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<uint8_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<int16_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<uint16_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<int32_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<uint32_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<int64_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<uint64_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<float> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_deserializer::values(std::span<double> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
 } // namespace caf
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "caf/binary_encoding.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/load_inspector_base.hpp"
@@ -11,11 +12,19 @@
 #include <concepts>
 #include <cstddef>
 #include <span>
+#include <string_view>
+#include <type_traits>
 
 namespace caf {
 
 /// Deserializes C++ objects from sequence of bytes. Does not perform
 /// run-time type checks.
+///
+/// Fields of type `std::string_view` deserialize as views into the input
+/// instead of copying the characters. These views remain valid only as long
+/// as the input buffer remains alive and unmodified. To pass such values to
+/// other actors, the input buffer must outlive all views, e.g., by storing
+/// the buffer in a `chunk` and moving the chunk alongside the views.
 class CAF_CORE_EXPORT binary_deserializer final
   : public load_inspector_base<binary_deserializer> {
 public:
@@ -43,6 +52,16 @@ public:
   /// Returns the remaining bytes.
   const_byte_span remainder() const noexcept;
 
+  /// Returns an upper bound for the number of values of type `T` in the
+  /// remaining input.
+  template <class T>
+  size_t max_remaining() const noexcept {
+    // Compact integers occupy at least one byte.
+    if (std::is_integral_v<T> && encoding() == binary_encoding::compact)
+      return remaining();
+    return remaining() / sizeof(T);
+  }
+
   /// Returns the current execution unit.
   actor_system* context() const noexcept;
 
@@ -59,6 +78,14 @@ public:
   /// Returns the end of the assigned memory block.
   const std::byte* end() const noexcept;
 
+  /// Returns how the deserializer expects integers to be encoded.
+  binary_encoding encoding() const noexcept;
+
+  /// Configures how the deserializer expects integers to be encoded. Must
+  /// match the encoding of the @ref binary_serializer that produced the input.
+  /// Defaults to `binary_encoding::fixed`.
+  void encoding(binary_encoding value) noexcept;
+
   static constexpr bool has_human_readable_format() noexcept {
     return false;
   }
@@ -154,6 +181,43 @@ public:
 
   bool value(weak_actor_ptr& ptr);
 
+  /// Points `x` to a string in the input without copying it. Accepts the same
+  /// input as `value(std::string&)`.
+  bool view(std::string_view& x) noexcept;
+
+  /// Points `x` to a sequence of bytes in the input without copying it.
+  /// Accepts the same input as loading a `byte_buffer`.
+  bool view(const_byte_span& x) noexcept;
+
+  /// Loads `std::string_view` fields as views into the input.
+  bool builtin_inspect(std::string_view& x) noexcept {
+    return view(x);
+  }
+
+  /// Reads `xs.size()` elements into `xs`. Accepts the same input as calling
+  /// `value` for each element but converts all elements in a single loop.
+  bool values(std::span<std::byte> xs);
+
+  bool values(std::span<int8_t> xs);
+
+  bool values(std::span<uint8_t> xs);
+
+  bool values(std::span<int16_t> xs);
+
+  bool values(std::span<uint16_t> xs);
+
+  bool values(std::span<int32_t> xs);
+
+  bool values(std::span<uint32_t> xs);
+
+  bool values(std::span<int64_t> xs);
+
+  bool values(std::span<uint64_t> xs);
+
+  bool values(std::span<float> xs);
+
+  bool values(std::span<double> xs);
+
 private:
   /// Storage for the implementation object.
   alignas(std::max_align_t) std::byte impl_[48];
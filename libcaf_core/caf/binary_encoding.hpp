@@ -0,0 +1,23 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include <cstdint>
+
+namespace caf {
+
+/// Configures how @ref binary_serializer and @ref binary_deserializer encode
+/// integers with more than eight bits. Both sides must agree on the encoding.
+enum class binary_encoding : uint8_t {
+  /// Encodes integers at fixed width in network byte order.
+  fixed,
+  /// Encodes unsigned integers as LEB128 varints and signed integers as
+  /// zig-zag encoded LEB128 varints. Small numbers occupy fewer bytes at the
+  /// cost of a few additional CPU cycles per integer. Floating point numbers
+  /// and the characters of UTF-16 and UTF-32 strings remain at fixed width.
+  compact,
+};
+
+} // namespace caf
@@ -7,6 +7,7 @@
 #include "caf/actor_system.hpp"
 #include "caf/byte_buffer.hpp"
 #include "caf/detail/assert.hpp"
+#include "caf/detail/concepts.hpp"
 #include "caf/detail/ieee_754.hpp"
 #include "caf/detail/network_order.hpp"
 #include "caf/detail/squashed_int.hpp"
@@ -28,6 +29,12 @@ T compress_index(bool is_present, size_t value) {
   return is_present ? static_cast<T>(value) : T{-1};
 }
 
+/// Element types that support writing a sequence of values at once.
+template <class T>
+concept bulk_value = detail::one_of<T, std::byte, int8_t, uint8_t, int16_t,
+                                    uint16_t, int32_t, uint32_t, int64_t,
+                                    uint64_t, float, double>;
+
 class impl : public save_inspector_base<impl>,
              public internal::fast_pimpl<impl> {
 public:
@@ -69,6 +76,14 @@ public:
     return write_pos_;
   }
 
+  binary_encoding encoding() const noexcept {
+    return encoding_;
+  }
+
+  void encoding(binary_encoding value) noexcept {
+    encoding_ = value;
+  }
+
   static constexpr bool has_human_readable_format() noexcept {
     return false;
   }
@@ -234,27 +249,27 @@ public:
   }
 
   bool value(int16_t x) {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(uint16_t x) {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(int32_t x) {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(uint32_t x) {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(int64_t x) {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(uint64_t x) {
-    return int_value(x);
+    return integer_value(x);
   }
 
   bool value(float x) {
@@ -372,6 +387,30 @@ public:
     return end_sequence();
   }
 
+  template <bulk_value T>
+  bool values(std::span<const T> xs) {
+    if constexpr (sizeof(T) == 1) {
+      return value(as_bytes(xs));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      using packed_type = typename detail::ieee_754_trait<T>::packed_type;
+      auto* dst = make_room(xs.size() * sizeof(packed_type));
+      for (auto x : xs) {
+        auto tmp = detail::to_network_order(detail::pack754(x));
+        memcpy(dst, &tmp, sizeof(packed_type));
+        dst += sizeof(packed_type);
+      }
+      return true;
+    } else if (encoding_ == binary_encoding::compact) {
+      for (auto x : xs)
+        varint_value(x);
+      return true;
+    } else {
+      auto* dst = make_room(xs.size_bytes());
+      detail::to_network_order(xs.data(), xs.size(), dst);
+      return true;
+    }
+  }
+
   virtual bool value(const strong_actor_ptr& ptr) {
     actor_id aid = 0;
     node_id nid;
@@ -400,6 +439,46 @@ public:
   }
 
 private:
+  /// Makes room for writing `num_bytes` at the current write position and
+  /// returns a pointer to the first byte. Advances the write position.
+  std::byte* make_room(size_t num_bytes) {
+    if (auto required = write_pos_ + num_bytes; required > buf_.size())
+      buf_.resize(required);
+    auto* result = buf_.data() + write_pos_;
+    write_pos_ += num_bytes;
+    return result;
+  }
+
+  /// Writes `x` using the configured encoding.
+  template <class T>
+  bool integer_value(T x) {
+    if (encoding_ == binary_encoding::compact)
+      return varint_value(x);
+    return int_value(x);
+  }
+
+  /// Writes `x` as LEB128 varint. Maps signed integers to unsigned integers
+  /// with zig-zag encoding first to keep small negative numbers short.
+  template <class T>
+  bool varint_value(T x) {
+    using unsigned_type = std::make_unsigned_t<T>;
+    auto y = static_cast<unsigned_type>(x);
+    if constexpr (std::is_signed_v<T>) {
+      constexpr auto msb = std::numeric_limits<unsigned_type>::digits - 1;
+      auto sign = static_cast<unsigned_type>(x >> msb);
+      y = static_cast<unsigned_type>((y << 1) ^ sign);
+    }
+    // A 64-bit integer occupies at most 10 bytes.
+    std::byte buf[10];
+    auto* i = buf;
+    while (y > 0x7f) {
+      *i++ = static_cast<std::byte>((static_cast<uint8_t>(y) & 0x7f) | 0x80);
+      y >>= 7;
+    }
+    *i++ = static_cast<std::byte>(y);
+    return value(const_byte_span{buf, static_cast<size_t>(i - buf)});
+  }
+
   template <class T>
   bool int_value(T x) {
     using unsigned_type = detail::squashed_int_t<std::make_unsigned_t<T>>;
@@ -417,6 +496,9 @@ private:
   actor_system* context_ = nullptr;
 
   error err_;
+
+  /// Configures how to write integers.
+  binary_encoding encoding_ = binary_encoding::fixed;
 };
 
 } // namespace
@@ -454,6 +536,14 @@ size_t binary_serializer::write_pos() const noexcept {
   return impl::cast(impl_).write_pos();
 }
 
+binary_encoding binary_serializer::encoding() const noexcept {
+  return impl::cast(impl_).encoding();
+}
+
+void binary_serializer::encoding(binary_encoding value) noexcept {
+  impl::cast(impl_).encoding(value);
+}
+
 // -- position management ----------------------------------------------------
 
 void binary_serializer::seek(size_t offset) noexcept {
@@ -620,4 +710,48 @@ bool binary_serializer::value(const weak_actor_ptr& ptr) {
   return impl::cast(impl_).value(std::move(ptr));
 }
 
+bool binary_serializer::values(std::span<const std::byte> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const int8_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const uint8_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const int16_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const uint16_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const int32_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const uint32_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const int64_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const uint64_t> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const float> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
+bool binary_serializer::values(std::span<const double> xs) {
+  return impl::cast(impl_).values(xs);
+}
+
 } // namespace caf
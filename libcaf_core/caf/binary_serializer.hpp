@@ -4,12 +4,14 @@
 
 #pragma once
 
+#include "caf/binary_encoding.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/save_inspector_base.hpp"
 
 #include <concepts>
 #include <cstddef>
+#include <span>
 
 namespace caf {
 
@@ -43,6 +45,13 @@ public:
 
   size_t write_pos() const noexcept;
 
+  /// Returns how the serializer encodes integers.
+  binary_encoding encoding() const noexcept;
+
+  /// Configures how the serializer encodes integers. Defaults to
+  /// `binary_encoding::fixed`.
+  void encoding(binary_encoding value) noexcept;
+
   static constexpr bool has_human_readable_format() noexcept {
     return false;
   }
@@ -140,9 +149,33 @@ public:
 
   bool value(const weak_actor_ptr& ptr);
 
+  /// Writes all elements of `xs`. Produces the same output as calling `value`
+  /// for each element but converts all elements in a single loop.
+  bool values(std::span<const std::byte> xs);
+
+  bool values(std::span<const int8_t> xs);
+
+  bool values(std::span<const uint8_t> xs);
+
+  bool values(std::span<const int16_t> xs);
+
+  bool values(std::span<const uint16_t> xs);
+
+  bool values(std::span<const int32_t> xs);
+
+  bool values(std::span<const uint32_t> xs);
+
+  bool values(std::span<const int64_t> xs);
+
+  bool values(std::span<const uint64_t> xs);
+
+  bool values(std::span<const float> xs);
+
+  bool values(std::span<const double> xs);
+
 private:
   /// Storage for the implementation object.
-  alignas(std::max_align_t) std::byte impl_[40];
+  alignas(std::max_align_t) std::byte impl_[48];
 };
 
 } // namespace caf
@@ -180,3 +180,10 @@
   || defined(CAF_CYGWIN) || defined(CAF_NET_BSD)
 #  define CAF_POSIX
 #endif
+
+// Defines CAF_HAS_SSE2 if the target supports SSE2 instructions, i.e., on all
+// x86-64 targets and on x86 targets that enable SSE2.
+#if defined(__SSE2__) || defined(_M_X64)                                      \
+  || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define CAF_HAS_SSE2
+#endif
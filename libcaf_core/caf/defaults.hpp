@@ -79,6 +79,10 @@ constexpr auto calibration_interval = int32_t{20};
 /// adjusting batch sizes. A higher factor discounts older observations faster.
 constexpr auto smoothing_factor = 0.6f;
 
+/// Upper bound for the time a consumer should need to process all elements that
+/// are in flight. Only applies while the consumer is the bottleneck.
+constexpr auto target_latency = timespan{100'000'000}; // 100ms
+
 } // namespace caf::defaults::stream::size_policy
 
 namespace caf::defaults::stream::token_policy {
@@ -110,8 +114,17 @@ constexpr auto relaxed_sleep_duration = timespan{10'000'000};
 
 } // namespace caf::defaults::work_stealing
 
+namespace caf::defaults::logger {
+
+constexpr auto deferred_formatting = false;
+constexpr auto thread_buffer_size = size_t{64 * 1024};
+constexpr auto rate_limit_summary_interval = timespan{1'000'000'000};
+
+} // namespace caf::defaults::logger
+
 namespace caf::defaults::logger::file {
 
+constexpr auto binary = false;
 constexpr auto format = std::string_view{"%r %c %p %a %t %M %F:%L %m%n"};
 constexpr auto path
   = std::string_view{"actor_log_[PID]_[TIMESTAMP]_[NODE].log"};
@@ -153,6 +166,10 @@ constexpr auto buffer_size = size_t{128};
 /// Limits the number of concurrent subscriptions for operators such as `merge`.
 constexpr auto max_concurrent = size_t{8};
 
+/// Limits how many groups operators such as `group_by` keep open at the same
+/// time.
+constexpr auto max_groups = size_t{1024};
+
 } // namespace caf::defaults::flow
 
 namespace caf::defaults::net {
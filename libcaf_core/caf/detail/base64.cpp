@@ -4,7 +4,11 @@
 
 #include "caf/detail/base64.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
+#include <utility>
 
 namespace caf::detail {
 
@@ -27,65 +31,101 @@ constexpr const char encoding_tbl[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
                                       "abcdefghijklmnopqrstuvwxyz"
                                       "0123456789+/";
 
+// Maps each 12-bit value to its two output characters. This allows us to
+// encode a group of three bytes with two lookups.
+constexpr auto encoding_pair_tbl = [] {
+  std::array<char, 8192> result{};
+  for (size_t i = 0; i < 4096; ++i) {
+    result[2 * i] = encoding_tbl[i >> 6];
+    result[2 * i + 1] = encoding_tbl[i & 0x3F];
+  }
+  return result;
+}();
+
+// Maps each input character to its 6-bit value. Ignores the high bit of each
+// character and maps invalid characters to 0.
+constexpr auto decoding_byte_tbl = [] {
+  std::array<uint32_t, 256> result{};
+  for (size_t i = 0; i < 256; ++i)
+    result[i] = decoding_tbl[i & 0x7F];
+  return result;
+}();
+
+// Encodes `num_groups` groups of three bytes from `in` to `out`.
+void encode_groups(const uint8_t* in, size_t num_groups, char* out) noexcept {
+  for (size_t i = 0; i < num_groups; ++i, in += 3, out += 4) {
+    auto bits = (uint32_t{in[0]} << 16) | (uint32_t{in[1]} << 8) | in[2];
+    memcpy(out, encoding_pair_tbl.data() + 2 * (bits >> 12), 2);
+    memcpy(out + 2, encoding_pair_tbl.data() + 2 * (bits & 0xFFF), 2);
+  }
+}
+
+// Encodes the last one or two bytes of an input and adds padding.
+void encode_tail(const uint8_t* in, size_t size, char* out) noexcept {
+  uint8_t buf[] = {0, 0, 0};
+  memcpy(buf, in, size);
+  encode_groups(buf, 1, out);
+  out[3] = '=';
+  if (size == 1)
+    out[2] = '=';
+}
+
+// Decodes `num_groups` groups of four characters from `in` to `out`.
+void decode_groups(const uint8_t* in, size_t num_groups,
+                   uint8_t* out) noexcept {
+  const auto* tbl = decoding_byte_tbl.data();
+  for (size_t i = 0; i < num_groups; ++i, in += 4, out += 3) {
+    auto bits = (tbl[in[0]] << 18) | (tbl[in[1]] << 12) | (tbl[in[2]] << 6)
+                | tbl[in[3]];
+    out[0] = static_cast<uint8_t>(bits >> 16);
+    out[1] = static_cast<uint8_t>(bits >> 8);
+    out[2] = static_cast<uint8_t>(bits);
+  }
+}
+
+// Returns how many bytes the padding in the last group removes from the
+// decoded output.
+size_t padding(const uint8_t* last_group) noexcept {
+  if (last_group[2] == '=')
+    return 2;
+  if (last_group[3] == '=')
+    return 1;
+  return 0;
+}
+
+// Grows `out` by `n` elements and returns a pointer to the first new element.
+template <class Storage>
+auto* grow(Storage& out, size_t n) {
+  auto old_size = out.size();
+  out.resize(old_size + n);
+  return reinterpret_cast<uint8_t*>(out.data() + old_size);
+}
+
 template <class Storage>
 void encode_impl(std::string_view in, Storage& out) {
-  using value_type = typename Storage::value_type;
-  // Consumes three characters from the input at once.
-  auto consume = [&out](const char* str) {
-    int buf[] = {
-      (str[0] & 0xfc) >> 2,
-      ((str[0] & 0x03) << 4) + ((str[1] & 0xf0) >> 4),
-      ((str[1] & 0x0f) << 2) + ((str[2] & 0xc0) >> 6),
-      str[2] & 0x3f,
-    };
-    for (auto x : buf)
-      out.push_back(static_cast<value_type>(encoding_tbl[x]));
-  };
-  // Iterate the input in chunks of three bytes.
-  auto ptr = in.data();
-  const auto end = ptr + in.size();
-  for (; std::distance(ptr, end) >= 3; ptr += 3)
-    consume(ptr);
-  // Deal with any leftover: pad the input with zeros and then fixup the output.
-  if (ptr != end) {
-    char buf[] = {0, 0, 0};
-    std::copy(ptr, end, buf);
-    consume(buf);
-    for (auto j = out.end() - (3 - (in.size() % 3)); j != out.end(); ++j)
-      *j = static_cast<value_type>('=');
-  }
+  auto* first = reinterpret_cast<const uint8_t*>(in.data());
+  auto num_groups = in.size() / 3;
+  auto tail = in.size() % 3;
+  auto* pos = reinterpret_cast<char*>(
+    grow(out, (num_groups + (tail != 0 ? 1 : 0)) * 4));
+  encode_groups(first, num_groups, pos);
+  if (tail != 0)
+    encode_tail(first + num_groups * 3, tail, pos + num_groups * 4);
 }
 
 template <class Storage>
 bool decode_impl(std::string_view in, Storage& out) {
-  using value_type = typename Storage::value_type;
   // Short-circuit empty inputs.
   if (in.empty())
     return true;
   // Refuse invalid inputs: Base64 always produces character groups of size 4.
   if (in.size() % 4 != 0)
     return false;
-  // Consume four characters from the input at once.
-  auto val = [](char c) { return decoding_tbl[c & 0x7F]; };
-  for (auto i = in.begin(); i != in.end(); i += 4) {
-    // clang-format off
-    auto bits =   (val(i[0]) << 18)
-                | (val(i[1]) << 12)
-                | (val(i[2]) << 6)
-                | (val(i[3]));
-    // clang-format on
-    out.push_back(static_cast<value_type>((bits & 0xFF0000) >> 16));
-    out.push_back(static_cast<value_type>((bits & 0x00FF00) >> 8));
-    out.push_back(static_cast<value_type>((bits & 0x0000FF)));
-  }
+  auto* first = reinterpret_cast<const uint8_t*>(in.data());
+  auto num_groups = in.size() / 4;
+  decode_groups(first, num_groups, grow(out, num_groups * 3));
   // Fix up the output buffer if the input contained padding.
-  auto s = in.size();
-  if (in[s - 2] == '=') {
-    out.pop_back();
-    out.pop_back();
-  } else if (in[s - 1] == '=') {
-    out.pop_back();
-  }
+  out.resize(out.size() - padding(first + in.size() - 4));
   return true;
 }
 
@@ -123,4 +163,104 @@ bool base64::decode(const_byte_span bytes, byte_buffer& out) {
   return decode_impl(to_string_view(bytes), out);
 }
 
+// -- streaming ----------------------------------------------------------------
+
+void base64::encoder::append(const_byte_span bytes, std::string& out) {
+  append_impl(bytes, out);
+}
+
+void base64::encoder::append(const_byte_span bytes, byte_buffer& out) {
+  append_impl(bytes, out);
+}
+
+void base64::encoder::finish(std::string& out) {
+  finish_impl(out);
+}
+
+void base64::encoder::finish(byte_buffer& out) {
+  finish_impl(out);
+}
+
+template <class Storage>
+void base64::encoder::append_impl(const_byte_span bytes, Storage& out) {
+  auto* first = reinterpret_cast<const uint8_t*>(bytes.data());
+  auto size = bytes.size();
+  // Complete the group in the buffer first.
+  if (size_ > 0) {
+    while (size_ < 3 && size > 0) {
+      buf_[size_++] = *first++;
+      --size;
+    }
+    if (size_ < 3)
+      return;
+    encode_groups(buf_, 1, reinterpret_cast<char*>(grow(out, 4)));
+    size_ = 0;
+  }
+  auto num_groups = size / 3;
+  encode_groups(first, num_groups,
+                reinterpret_cast<char*>(grow(out, num_groups * 4)));
+  size_ = size % 3;
+  memcpy(buf_, first + num_groups * 3, size_);
+}
+
+template <class Storage>
+void base64::encoder::finish_impl(Storage& out) {
+  if (size_ > 0)
+    encode_tail(buf_, size_, reinterpret_cast<char*>(grow(out, 4)));
+  size_ = 0;
+}
+
+void base64::decoder::append(std::string_view in, std::string& out) {
+  append_impl(in, out);
+}
+
+void base64::decoder::append(std::string_view in, byte_buffer& out) {
+  append_impl(in, out);
+}
+
+bool base64::decoder::finish(std::string& out) {
+  return finish_impl(out);
+}
+
+bool base64::decoder::finish(byte_buffer& out) {
+  return finish_impl(out);
+}
+
+template <class Storage>
+void base64::decoder::append_impl(std::string_view in, Storage& out) {
+  auto* first = reinterpret_cast<const uint8_t*>(in.data());
+  auto size = in.size();
+  while (size > 0) {
+    // Only the last group may contain padding. Hence, we can only decode a
+    // complete group after receiving more input.
+    if (size_ == 4) {
+      decode_groups(buf_, 1, grow(out, 3));
+      size_ = 0;
+    }
+    if (size_ == 0 && size > 4) {
+      auto num_groups = (size - 1) / 4;
+      decode_groups(first, num_groups, grow(out, num_groups * 3));
+      first += num_groups * 4;
+      size -= num_groups * 4;
+    }
+    auto n = std::min(size, 4 - size_);
+    memcpy(buf_ + size_, first, n);
+    size_ += n;
+    first += n;
+    size -= n;
+  }
+}
+
+template <class Storage>
+bool base64::decoder::finish_impl(Storage& out) {
+  auto size = std::exchange(size_, 0);
+  if (size == 0)
+    return true;
+  if (size != 4)
+    return false;
+  decode_groups(buf_, 1, grow(out, 3));
+  out.resize(out.size() - padding(buf_));
+  return true;
+}
+
 } // namespace caf::detail
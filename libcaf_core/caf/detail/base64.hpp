@@ -8,14 +8,78 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/core_export.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
 
 namespace caf::detail {
 
+/// Encodes and decodes Base64 as defined in RFC 4648.
 class CAF_CORE_EXPORT base64 {
 public:
+  /// Encodes input that arrives in chunks. Since Base64 encodes groups of
+  /// three bytes, the encoder buffers up to two bytes between calls to
+  /// `append`. The output for all chunks is equal to calling `base64::encode`
+  /// on the concatenated input.
+  class CAF_CORE_EXPORT encoder {
+  public:
+    /// Encodes `bytes` and appends the result to `out`.
+    void append(const_byte_span bytes, std::string& out);
+
+    /// @copydoc append
+    void append(const_byte_span bytes, byte_buffer& out);
+
+    /// Encodes any buffered input, adds padding if necessary and resets the
+    /// encoder.
+    void finish(std::string& out);
+
+    /// @copydoc finish
+    void finish(byte_buffer& out);
+
+  private:
+    template <class Storage>
+    void append_impl(const_byte_span bytes, Storage& out);
+
+    template <class Storage>
+    void finish_impl(Storage& out);
+
+    uint8_t buf_[3];
+
+    size_t size_ = 0;
+  };
+
+  /// Decodes input that arrives in chunks. The decoder buffers incomplete
+  /// character groups between calls to `append` as well as the last complete
+  /// group, because only the last group of the input may contain padding.
+  class CAF_CORE_EXPORT decoder {
+  public:
+    /// Decodes `in` and appends the result to `out`.
+    void append(std::string_view in, std::string& out);
+
+    /// @copydoc append
+    void append(std::string_view in, byte_buffer& out);
+
+    /// Decodes any buffered input and resets the decoder. Returns `false` if
+    /// the size of the input was not a multiple of four.
+    bool finish(std::string& out);
+
+    /// @copydoc finish
+    bool finish(byte_buffer& out);
+
+  private:
+    template <class Storage>
+    void append_impl(std::string_view in, Storage& out);
+
+    template <class Storage>
+    bool finish_impl(Storage& out);
+
+    uint8_t buf_[4];
+
+    size_t size_ = 0;
+  };
+
   static void encode(std::string_view str, std::string& out);
 
   static void encode(std::string_view str, byte_buffer& out);
@@ -29,3 +29,57 @@ TEST("decoding") {
   check_eq(base64::decode("aHR0cHM6Ly9hY3Rvci1mcmFtZXdvcmsub3Jn"sv),
            "https://actor-framework.org"s);
 }
+
+TEST("decoding ignores the high bit and maps invalid characters to zero") {
+  check_eq(base64::decode("QUJD"sv), base64::decode("\xd1UJD"sv));
+  check_eq(base64::decode("AAAA"sv), base64::decode("*AA!"sv));
+  check_eq(base64::decode("QUJ"sv), std::nullopt);
+}
+
+TEST("encoding and decoding large inputs") {
+  for (auto size : {size_t{1024}, size_t{1024 * 1024}}) {
+    auto data = std::string(size + size % 7, '\0');
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<char>(i * 31 + i / 256);
+    auto encoded = base64::encode(data);
+    check_eq(encoded.size(), (data.size() + 2) / 3 * 4);
+    check_eq(base64::decode(encoded), data);
+  }
+}
+
+TEST("encoding and decoding in chunks") {
+  auto data = std::string(100, '\0');
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i * 17);
+  for (size_t chunk_size = 1; chunk_size < 12; ++chunk_size) {
+    for (size_t len = 0; len < data.size(); len += 7) {
+      auto input = std::string_view{data}.substr(0, len);
+      auto expected = base64::encode(input);
+      // Encode in chunks.
+      base64::encoder enc;
+      auto encoded = std::string{};
+      for (size_t i = 0; i < len; i += chunk_size) {
+        auto chunk = input.substr(i, chunk_size);
+        enc.append(as_bytes(std::span{chunk}), encoded);
+      }
+      enc.finish(encoded);
+      if (!check_eq(encoded, expected))
+        return;
+      // Decode in chunks.
+      base64::decoder dec;
+      auto decoded = byte_buffer{};
+      for (size_t i = 0; i < encoded.size(); i += chunk_size)
+        dec.append(std::string_view{encoded}.substr(i, chunk_size), decoded);
+      check(dec.finish(decoded));
+      if (!check_eq(to_string_view(decoded), input))
+        return;
+    }
+  }
+}
+
+TEST("the chunked decoder rejects inputs with incomplete groups") {
+  base64::decoder dec;
+  auto decoded = std::string{};
+  dec.append("QUJDQQ"sv, decoded);
+  check(!dec.finish(decoded));
+}
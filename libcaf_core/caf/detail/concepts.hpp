@@ -11,6 +11,7 @@
 #include <functional>
 #include <iterator>
 #include <optional>
+#include <span>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -115,6 +116,24 @@ template <class T>
 concept has_push_back
   = requires(T& t) { t.push_back(std::declval<typename T::value_type>()); };
 
+/// Checks whether the inspector `F` can save all elements of the contiguous
+/// container `T` at once by calling `values`.
+template <class F, class T>
+concept has_bulk_save = requires(F& f, const T& xs) {
+  { f.values(std::span{xs}) } -> std::same_as<bool>;
+};
+
+/// Checks whether the inspector `F` can load all elements of the resizable,
+/// contiguous container `T` at once by calling `values`.
+template <class F, class T>
+concept has_bulk_load = requires(F& f, T& xs) {
+  xs.resize(size_t{0});
+  {
+    f.template max_remaining<typename T::value_type>()
+  } -> std::convertible_to<size_t>;
+  { f.values(std::span{xs}) } -> std::same_as<bool>;
+};
+
 template <class T>
 struct is_result_oracle : std::false_type {};
 
@@ -0,0 +1,187 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/file_writer.hpp"
+
+#include "caf/config.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+#ifdef CAF_WINDOWS
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace caf::detail {
+
+file_writer::file_writer(std::string path, async::file_sink_options opts)
+  : path_(std::move(path)), opts_(opts) {
+  // nop
+}
+
+file_writer::~file_writer() {
+  if (file_ != nullptr)
+    fclose(file_);
+}
+
+error file_writer::open() {
+  if (file_ != nullptr)
+    return {};
+  if (opts_.buffer_size == 0)
+    return make_error(sec::invalid_argument, "buffer size must be positive");
+  file_ = fopen(path_.c_str(), opts_.append ? "ab" : "wb");
+  if (file_ == nullptr)
+    return make_error(sec::cannot_open_file);
+  // We write entire blocks from our own buffer, so the buffer of the C library
+  // would only add an extra copy.
+  setvbuf(file_, nullptr, _IONBF, 0);
+  if (opts_.append && fseek(file_, 0, SEEK_END) == 0) {
+    if (auto pos = ftell(file_); pos > 0)
+      file_size_ = static_cast<size_t>(pos);
+  }
+  // Continue after the rotated files of earlier runs instead of overriding
+  // them.
+  if (opts_.max_file_size > 0) {
+    std::error_code ec;
+    while (std::filesystem::exists(rotated_path(last_index_ + 1), ec))
+      ++last_index_;
+  }
+  buf_.reserve(opts_.buffer_size);
+  last_sync_ = clock_type::now();
+  return {};
+}
+
+error file_writer::write(const_byte_span bytes) {
+  if (auto err = rotate_if_needed(bytes.size()))
+    return err;
+  if (auto err = append(bytes))
+    return err;
+  return after_write();
+}
+
+error file_writer::write_line(std::string_view str) {
+  if (auto err = rotate_if_needed(str.size() + 1))
+    return err;
+  auto newline = std::byte{'\n'};
+  if (auto err = append(as_bytes(std::span{str})))
+    return err;
+  if (auto err = append(const_byte_span{&newline, 1}))
+    return err;
+  return after_write();
+}
+
+error file_writer::flush() {
+  if (buf_.empty())
+    return {};
+  auto err = write_through(buf_);
+  buf_.clear();
+  return err;
+}
+
+error file_writer::sync() {
+  if (auto err = flush())
+    return err;
+  return sync_file();
+}
+
+error file_writer::close() {
+  if (file_ == nullptr)
+    return {};
+  auto err = flush();
+  if (!err && (opts_.sync_bytes > 0 || opts_.sync_interval.count() > 0))
+    err = sync_file();
+  fclose(file_);
+  file_ = nullptr;
+  return err;
+}
+
+error file_writer::append(const_byte_span bytes) {
+  if (file_ == nullptr)
+    return make_error(sec::runtime_error, "cannot write to a closed file");
+  file_size_ += bytes.size();
+  total_bytes_ += bytes.size();
+  unsynced_ += bytes.size();
+  auto block_size = opts_.buffer_size;
+  while (!bytes.empty()) {
+    // Skip the buffer for input that covers at least one entire block.
+    if (buf_.empty() && bytes.size() >= block_size) {
+      auto n = bytes.size() - bytes.size() % block_size;
+      if (auto err = write_through(bytes.subspan(0, n)))
+        return err;
+      bytes = bytes.subspan(n);
+      continue;
+    }
+    auto n = std::min(bytes.size(), block_size - buf_.size());
+    buf_.insert(buf_.end(), bytes.begin(), bytes.begin() + n);
+    bytes = bytes.subspan(n);
+    if (buf_.size() == block_size) {
+      if (auto err = flush())
+        return err;
+    }
+  }
+  return {};
+}
+
+error file_writer::write_through(const_byte_span bytes) {
+  if (fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size())
+    return make_error(sec::runtime_error, "failed to write to file");
+  return {};
+}
+
+error file_writer::sync_file() {
+  unsynced_ = 0;
+  last_sync_ = clock_type::now();
+#if defined(CAF_WINDOWS)
+  auto res = _commit(_fileno(file_));
+#elif defined(CAF_LINUX)
+  auto fd = fileno(file_);
+  auto res = opts_.sync_data_only ? fdatasync(fd) : fsync(fd);
+#else
+  auto res = fsync(fileno(file_));
+#endif
+  if (res != 0)
+    return make_error(sec::runtime_error, "failed to synchronize file");
+  return {};
+}
+
+error file_writer::rotate_if_needed(size_t size) {
+  if (opts_.max_file_size == 0 || file_size_ == 0
+      || file_size_ + size <= opts_.max_file_size)
+    return {};
+  if (auto err = close())
+    return err;
+  auto rotated = rotated_path(last_index_ + 1);
+  if (std::rename(path_.c_str(), rotated.c_str()) != 0)
+    return make_error(sec::runtime_error, "failed to rotate file");
+  ++last_index_;
+  ++rotations_;
+  // Always start the new file from scratch, even when appending.
+  file_ = fopen(path_.c_str(), "wb");
+  if (file_ == nullptr)
+    return make_error(sec::cannot_open_file);
+  setvbuf(file_, nullptr, _IONBF, 0);
+  file_size_ = 0;
+  return {};
+}
+
+std::string file_writer::rotated_path(size_t index) const {
+  auto result = path_;
+  result += '.';
+  result += std::to_string(index);
+  return result;
+}
+
+error file_writer::after_write() {
+  if (opts_.sync_bytes > 0 && unsynced_ >= opts_.sync_bytes)
+    return sync();
+  if (opts_.sync_interval.count() > 0 && unsynced_ > 0
+      && clock_type::now() - last_sync_ >= opts_.sync_interval)
+    return sync();
+  return {};
+}
+
+} // namespace caf::detail
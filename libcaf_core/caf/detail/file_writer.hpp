@@ -0,0 +1,125 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/async/file_sink_options.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace caf::detail {
+
+/// Writes to a file in large blocks and synchronizes the file with the storage
+/// device according to its @ref async::file_sink_options.
+class CAF_CORE_EXPORT file_writer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = std::chrono::steady_clock;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  file_writer(std::string path, async::file_sink_options opts);
+
+  file_writer(const file_writer&) = delete;
+
+  file_writer& operator=(const file_writer&) = delete;
+
+  ~file_writer();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the options for this writer.
+  const async::file_sink_options& options() const noexcept {
+    return opts_;
+  }
+
+  /// Returns the size of the current file, including buffered bytes.
+  size_t file_size() const noexcept {
+    return file_size_;
+  }
+
+  /// Returns the number of bytes that the writer received in total.
+  size_t total_bytes() const noexcept {
+    return total_bytes_;
+  }
+
+  /// Returns the number of bytes in the write buffer.
+  size_t buffered() const noexcept {
+    return buf_.size();
+  }
+
+  /// Returns how many times the writer has started a new file.
+  size_t rotations() const noexcept {
+    return rotations_;
+  }
+
+  /// Checks whether the writer received bytes since the last synchronization.
+  bool dirty() const noexcept {
+    return unsynced_ > 0;
+  }
+
+  /// Checks whether the file is open.
+  bool is_open() const noexcept {
+    return file_ != nullptr;
+  }
+
+  // -- I/O --------------------------------------------------------------------
+
+  /// Opens the file.
+  error open();
+
+  /// Writes `bytes` to the file. Starts a new file first if `bytes` does not
+  /// fit into the current file.
+  error write(const_byte_span bytes);
+
+  /// Writes `str`, followed by a newline character, to the file. Starts a new
+  /// file first if the line does not fit into the current file.
+  error write_line(std::string_view str);
+
+  /// Writes all buffered bytes to the file.
+  error flush();
+
+  /// Writes all buffered bytes to the file and then synchronizes the file with
+  /// the storage device.
+  error sync();
+
+  /// Flushes all buffered bytes and closes the file. Also synchronizes the
+  /// file if the options enable synchronizing.
+  error close();
+
+private:
+  error append(const_byte_span bytes);
+
+  error write_through(const_byte_span bytes);
+
+  error sync_file();
+
+  error rotate_if_needed(size_t size);
+
+  error after_write();
+
+  std::string rotated_path(size_t index) const;
+
+  std::string path_;
+  async::file_sink_options opts_;
+  FILE* file_ = nullptr;
+  byte_buffer buf_;
+  size_t file_size_ = 0;
+  size_t total_bytes_ = 0;
+  size_t unsynced_ = 0;
+  size_t rotations_ = 0;
+  size_t last_index_ = 0;
+  clock_type::time_point last_sync_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,174 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/file_writer.hpp"
+
+#include "caf/test/scenario.hpp"
+#include "caf/test/temp_directory.hpp"
+#include "caf/test/test.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct fixture {
+  static std::string read_file(const std::string& file_path) {
+    std::ifstream in{file_path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{in},
+                       std::istreambuf_iterator<char>{}};
+  }
+
+  static const_byte_span bytes_of(std::string_view str) {
+    return as_bytes(std::span{str});
+  }
+
+  test::temp_directory dir{"caf-file-writer-test"};
+  std::string path = dir.file("out.txt");
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("a file writer collects small writes in its buffer") {
+  GIVEN("a file writer with a buffer size of 8") {
+    auto opts = async::file_sink_options{};
+    opts.buffer_size = 8;
+    detail::file_writer uut{path, opts};
+    require_eq(uut.open(), error{});
+    WHEN("writing less than 8 bytes") {
+      THEN("the writer keeps the bytes in its buffer") {
+        check_eq(uut.write(bytes_of("abc")), error{});
+        check_eq(uut.buffered(), 3u);
+        check_eq(fs::file_size(path), 0u);
+        check_eq(uut.flush(), error{});
+        check_eq(uut.buffered(), 0u);
+        check_eq(read_file(path), "abc");
+      }
+    }
+    WHEN("writing more than 8 bytes") {
+      THEN("the writer writes entire blocks to the file") {
+        check_eq(uut.write(bytes_of("abcdef")), error{});
+        check_eq(uut.write(bytes_of("ghijklmnopqrstu")), error{});
+        check_eq(read_file(path), "abcdefghijklmnop");
+        check_eq(uut.buffered(), 5u);
+        check_eq(uut.close(), error{});
+        check_eq(read_file(path), "abcdefghijklmnopqrstu");
+        check_eq(uut.total_bytes(), 21u);
+      }
+    }
+  }
+}
+
+SCENARIO("a file writer synchronizes the file after writing N bytes") {
+  GIVEN("a file writer that synchronizes every 10 bytes") {
+    auto opts = async::file_sink_options{};
+    opts.sync_bytes = 10;
+    detail::file_writer uut{path, opts};
+    require_eq(uut.open(), error{});
+    WHEN("writing lines") {
+      THEN("the writer flushes and synchronizes after 10 bytes") {
+        check_eq(uut.write_line("abcd"), error{});
+        check(uut.dirty());
+        check_eq(fs::file_size(path), 0u);
+        check_eq(uut.write_line("efgh"), error{});
+        check(!uut.dirty());
+        check_eq(read_file(path), "abcd\nefgh\n");
+        check_eq(uut.write_line("ijkl"), error{});
+        check(uut.dirty());
+        check_eq(read_file(path), "abcd\nefgh\n");
+      }
+    }
+  }
+}
+
+SCENARIO("a file writer rotates files that reach their maximum size") {
+  GIVEN("a file writer with a maximum file size of 10") {
+    auto opts = async::file_sink_options{};
+    opts.max_file_size = 10;
+    detail::file_writer uut{path, opts};
+    require_eq(uut.open(), error{});
+    WHEN("writing lines that exceed the maximum size") {
+      THEN("the writer starts a new file without splitting lines") {
+        for (auto line : {"abcd"sv, "efgh"sv, "ijkl"sv, "mnopqrstuvwxyz"sv})
+          check_eq(uut.write_line(line), error{});
+        check_eq(uut.close(), error{});
+        check_eq(uut.rotations(), 2u);
+        check_eq(read_file(path + ".1"), "abcd\nefgh\n");
+        check_eq(read_file(path + ".2"), "ijkl\n");
+        check_eq(read_file(path), "mnopqrstuvwxyz\n");
+      }
+    }
+  }
+}
+
+SCENARIO("a file writer keeps rotated files of earlier runs") {
+  GIVEN("rotated files of a previous file writer") {
+    auto opts = async::file_sink_options{};
+    opts.max_file_size = 10;
+    opts.append = true;
+    {
+      detail::file_writer uut{path, opts};
+      require_eq(uut.open(), error{});
+      for (auto line : {"abcd"sv, "efgh"sv, "ijkl"sv})
+        check_eq(uut.write_line(line), error{});
+      check_eq(uut.close(), error{});
+    }
+    WHEN("reopening the file in append mode and rotating again") {
+      THEN("the writer continues with the next index") {
+        detail::file_writer uut{path, opts};
+        require_eq(uut.open(), error{});
+        check_eq(uut.file_size(), 5u);
+        for (auto line : {"mnop"sv, "qrst"sv})
+          check_eq(uut.write_line(line), error{});
+        check_eq(uut.close(), error{});
+        check_eq(uut.rotations(), 1u);
+        check_eq(read_file(path + ".1"), "abcd\nefgh\n");
+        check_eq(read_file(path + ".2"), "ijkl\nmnop\n");
+        check_eq(read_file(path), "qrst\n");
+      }
+    }
+  }
+}
+
+SCENARIO("a file writer may append to an existing file") {
+  GIVEN("an existing file") {
+    {
+      std::ofstream out{path, std::ios::binary};
+      out << "abc\n";
+    }
+    WHEN("opening a file writer in append mode") {
+      THEN("the writer keeps the content of the file") {
+        auto opts = async::file_sink_options{};
+        opts.append = true;
+        detail::file_writer uut{path, opts};
+        require_eq(uut.open(), error{});
+        check_eq(uut.file_size(), 4u);
+        check_eq(uut.write_line("def"), error{});
+        check_eq(uut.close(), error{});
+        check_eq(read_file(path), "abc\ndef\n");
+      }
+    }
+  }
+  GIVEN("a file writer with a buffer size of 0") {
+    WHEN("opening the file") {
+      THEN("the writer reports an error") {
+        auto opts = async::file_sink_options{};
+        opts.buffer_size = 0;
+        detail::file_writer uut{path, opts};
+        check_eq(uut.open(), sec::invalid_argument);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
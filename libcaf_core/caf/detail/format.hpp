@@ -11,76 +11,27 @@
 //       The wrappers should also add support for types that provide an
 //       `inspect` overload.
 
+#include "caf/chunked_string.hpp"
 #include "caf/deep_to_string.hpp"
 #include "caf/detail/build_config.hpp"
 #include "caf/detail/concepts.hpp"
+#include "caf/detail/core_export.hpp"
 #include "caf/detail/is_complete.hpp"
 #include "caf/detail/source_location.hpp"
 #include "caf/inspector_access_type.hpp"
 
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
-
-#ifdef CAF_USE_STD_FORMAT
-
-#  include <format>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
 namespace caf::detail {
 
-template <class T>
-decltype(auto) fmt_fwd(T&& arg) {
-  using arg_t = std::decay_t<T>;
-  if constexpr (std::is_default_constructible_v<std::formatter<arg_t, char>>) {
-    return std::forward<T>(arg);
-  } else {
-    static_assert(
-      !std::is_same_v<
-        decltype(inspect_access_type<stringification_inspector, arg_t>()),
-        inspector_access_type::none>,
-      "stringification using std::formatter or caf::inspect not available");
-    return deep_to_string(arg);
-  }
-}
-
-template <class OutputIt, class... Args>
-auto format_to(OutputIt out, std::string_view fstr, Args&&... args) {
-  // Note: make_format_args expects all args to be references, and since
-  // fmt_fwd returns by value in case of inspector stringification, we need this
-  // helper function to wrap the call.
-  auto format_to_helper = [&out, &fstr](const auto&... ts) {
-    return std::vformat_to(out, fstr, std::make_format_args(ts...));
-  };
-  return format_to_helper(fmt_fwd(args)...);
-}
-
-template <class... Args>
-std::string format(std::string_view fstr, Args&&... args) {
-  // Note: make_format_args expects all args to be references, and since
-  // fmt_fwd returns by value in case of inspector stringification, we need this
-  // helper function to wrap the call.
-  auto format_helper = [&fstr](const auto&... ts) {
-    return std::vformat(fstr, std::make_format_args(ts...));
-  };
-  return format_helper(fmt_fwd(args)...);
-}
-
-} // namespace caf::detail
-
-#else // here comes the poor man's version
-
-#  include "caf/chunked_string.hpp"
-#  include "caf/deep_to_string.hpp"
-#  include "caf/detail/core_export.hpp"
-
-#  include <array>
-#  include <cstdint>
-#  include <iterator>
-#  include <memory>
-#  include <span>
-#  include <string_view>
-#  include <type_traits>
-#  include <variant>
-
-namespace caf::detail {
+// Runtime formatting that does not depend on std::format. Also formats the
+// deferred log records of the logger.
 
 using format_arg
   = std::variant<bool, char, int64_t, uint64_t, double, const char*,
@@ -134,6 +85,60 @@ CAF_CORE_EXPORT
 std::unique_ptr<compiled_format_string>
 compile_format_string(std::string_view fstr, std::span<format_arg> args);
 
+} // namespace caf::detail
+
+#ifdef CAF_USE_STD_FORMAT
+
+#  include <format>
+
+namespace caf::detail {
+
+template <class T>
+decltype(auto) fmt_fwd(T&& arg) {
+  using arg_t = std::decay_t<T>;
+  if constexpr (std::is_default_constructible_v<std::formatter<arg_t, char>>) {
+    return std::forward<T>(arg);
+  } else {
+    static_assert(
+      !std::is_same_v<
+        decltype(inspect_access_type<stringification_inspector, arg_t>()),
+        inspector_access_type::none>,
+      "stringification using std::formatter or caf::inspect not available");
+    return deep_to_string(arg);
+  }
+}
+
+template <class OutputIt, class... Args>
+auto format_to(OutputIt out, std::string_view fstr, Args&&... args) {
+  // Note: make_format_args expects all args to be references, and since
+  // fmt_fwd returns by value in case of inspector stringification, we need this
+  // helper function to wrap the call.
+  auto format_to_helper = [&out, &fstr](const auto&... ts) {
+    return std::vformat_to(out, fstr, std::make_format_args(ts...));
+  };
+  return format_to_helper(fmt_fwd(args)...);
+}
+
+template <class... Args>
+std::string format(std::string_view fstr, Args&&... args) {
+  // Note: make_format_args expects all args to be references, and since
+  // fmt_fwd returns by value in case of inspector stringification, we need this
+  // helper function to wrap the call.
+  auto format_helper = [&fstr](const auto&... ts) {
+    return std::vformat(fstr, std::make_format_args(ts...));
+  };
+  return format_helper(fmt_fwd(args)...);
+}
+
+} // namespace caf::detail
+
+#else // here comes the poor man's version
+
+#  include <array>
+#  include <iterator>
+
+namespace caf::detail {
+
 template <class OutputIt, class... Args>
 auto format_to(OutputIt out, std::string_view fstr, Args&&... raw_args) {
   std::array<format_arg, sizeof...(Args)> args{make_format_arg(raw_args)...};
@@ -11,6 +11,7 @@
 #include "caf/detail/parser/read_number.hpp"
 #include "caf/pec.hpp"
 
+#include <bit>
 #include <cstring>
 #include <iterator>
 #include <memory>
@@ -18,6 +19,10 @@
 #include <numeric>
 #include <streambuf>
 
+#ifdef CAF_HAS_SSE2
+#  include <emmintrin.h>
+#endif
+
 CAF_PUSH_UNUSED_LABEL_WARNING
 
 #include "caf/detail/parser/fsm.hpp"
@@ -187,6 +192,70 @@ struct in_situ_unescaper {
   }
 };
 
+// Drops all strings for skipping over parts of the input.
+struct skip_unescaper {
+  std::string_view operator()(std::pmr::memory_resource*, const char*,
+                              const char*, bool) const {
+    return {};
+  }
+};
+
+// Returns the position of the first quote, backslash or newline in the range
+// [first, last), or `last` if the range contains none of these characters.
+// Scans 16 bytes at once with SSE2 and 8 bytes at once otherwise.
+const char* find_string_delimiter(const char* first,
+                                  const char* last) noexcept {
+#ifdef CAF_HAS_SSE2
+  auto quotes = _mm_set1_epi8('"');
+  auto backslashes = _mm_set1_epi8('\\');
+  auto newlines = _mm_set1_epi8('\n');
+  while (last - first >= 16) {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    auto hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quotes),
+                                          _mm_cmpeq_epi8(block, backslashes)),
+                             _mm_cmpeq_epi8(block, newlines));
+    if (auto mask = _mm_movemask_epi8(hits); mask != 0)
+      return first + std::countr_zero(static_cast<unsigned>(mask));
+    first += 16;
+  }
+#else
+  // Sets the high bit of each byte in `x` that is zero.
+  auto zero_bytes = [](uint64_t x) {
+    return (x - 0x0101010101010101) & ~x & 0x8080808080808080;
+  };
+  while (last - first >= 8) {
+    uint64_t block;
+    memcpy(&block, first, sizeof(block));
+    auto hits = zero_bytes(block ^ 0x2222222222222222)   // '"'
+                | zero_bytes(block ^ 0x5C5C5C5C5C5C5C5C) // '\\'
+                | zero_bytes(block ^ 0x0A0A0A0A0A0A0A0A); // '\n'
+    if (hits != 0)
+      break; // Let the loop below find the exact position.
+    first += 8;
+  }
+#endif
+  for (; first != last; ++first)
+    if (*first == '"' || *first == '\\' || *first == '\n')
+      return first;
+  return last;
+}
+
+// Skips over characters that have no special meaning in a JSON string. After
+// calling this function, `ps.next()` returns the next quote, backslash or
+// newline (or the end of the input). Does nothing for non-contiguous input.
+template <class ParserState>
+void skip_string_chars(ParserState& ps) {
+  using iterator_t = typename ParserState::iterator_type;
+  if constexpr (std::contiguous_iterator<iterator_t>) {
+    auto* first = std::to_address(ps.i);
+    auto* last = std::to_address(ps.e);
+    auto* pos = find_string_delimiter(first + 1, last);
+    auto n = pos - first - 1;
+    ps.i += n;
+    ps.column += static_cast<int32_t>(n);
+  }
+}
+
 // Note: Iterator `last` must not point to the end iterator.
 template <class Escaper, class Consumer, class Iterator>
 void assign_value(Escaper escaper, Consumer& consumer, Iterator first,
@@ -309,6 +378,40 @@ obj_consumer val_consumer::begin_object() {
   return {&obj};
 }
 
+// Discards all values for skipping over parts of the input.
+struct skip_consumer {
+  std::pmr::memory_resource* storage = nullptr;
+
+  template <class T>
+  void value(T) {
+    // nop
+  }
+
+  skip_consumer begin_array() {
+    return {};
+  }
+
+  skip_consumer begin_object() {
+    return {};
+  }
+
+  skip_consumer begin_member() {
+    return {};
+  }
+
+  skip_consumer begin_key() {
+    return {};
+  }
+
+  skip_consumer begin_val() {
+    return {};
+  }
+
+  skip_consumer begin_value() {
+    return {};
+  }
+};
+
 template <class ParserState, class Consumer>
 void read_json_null_or_nan(ParserState& ps, Consumer consumer) {
   enum { nil, is_null, is_nan };
@@ -368,12 +471,12 @@ void read_json_string(ParserState& ps, unit_t, Unescaper escaper,
   state(read_chars) {
     transition(escape, '\\')
     transition(done, '"', assign_value(escaper, consumer, first, ps.i, false))
-    transition(read_chars, any_char)
+    transition(read_chars, any_char, skip_string_chars(ps))
   }
   state(read_chars_after_escape) {
     transition(escape, '\\')
     transition(done, '"', assign_value(escaper, consumer, first, ps.i, true))
-    transition(read_chars_after_escape, any_char)
+    transition(read_chars_after_escape, any_char, skip_string_chars(ps))
   }
   state(escape) {
     transition(read_chars_after_escape, "\"\\/bfnrtv")
@@ -447,10 +550,10 @@ void read_json_string(ParserState& ps, std::vector<char>& scratch_space,
   // clang-format on
 }
 
-template <class ParserState, class ScratchSpace, class Unescaper>
+template <class ParserState, class ScratchSpace, class Unescaper,
+          class Consumer>
 void read_member(ParserState& ps, ScratchSpace& scratch_space,
-                 Unescaper unescaper, size_t nesting_level,
-                 member_consumer consumer) {
+                 Unescaper unescaper, size_t nesting_level, Consumer consumer) {
   // clang-format off
   start();
   state(init) {
@@ -472,10 +575,11 @@ void read_member(ParserState& ps, ScratchSpace& scratch_space,
   // clang-format on
 }
 
-template <class ParserState, class ScratchSpace, class Unescaper>
+template <class ParserState, class ScratchSpace, class Unescaper,
+          class Consumer>
 void read_json_object(ParserState& ps, ScratchSpace& scratch_space,
                       Unescaper unescaper, size_t nesting_level,
-                      obj_consumer consumer) {
+                      Consumer consumer) {
   if (nesting_level >= max_nesting_level) {
     ps.code = pec::nested_too_deeply;
     return;
@@ -511,10 +615,11 @@ void read_json_object(ParserState& ps, ScratchSpace& scratch_space,
   // clang-format on
 }
 
-template <class ParserState, class ScratchSpace, class Unescaper>
+template <class ParserState, class ScratchSpace, class Unescaper,
+          class Consumer>
 void read_json_array(ParserState& ps, ScratchSpace& scratch_space,
                      Unescaper unescaper, size_t nesting_level,
-                     arr_consumer consumer) {
+                     Consumer consumer) {
   if (nesting_level >= max_nesting_level) {
     ps.code = pec::nested_too_deeply;
     return;
@@ -550,10 +655,10 @@ void read_json_array(ParserState& ps, ScratchSpace& scratch_space,
   // clang-format on
 }
 
-template <class ParserState, class ScratchSpace, class Unescaper>
+template <class ParserState, class ScratchSpace, class Unescaper,
+          class Consumer>
 void read_value(ParserState& ps, ScratchSpace& scratch_space,
-                Unescaper unescaper, size_t nesting_level,
-                val_consumer consumer) {
+                Unescaper unescaper, size_t nesting_level, Consumer consumer) {
   // clang-format off
   start();
   state(init) {
@@ -651,7 +756,8 @@ value* parse(string_parser_state& ps, std::pmr::memory_resource* storage) {
   parser::regular_unescaper unescaper;
   std::pmr::polymorphic_allocator<value> alloc{storage};
   auto result = new (alloc.allocate(1)) value();
-  parser::read_value(ps, scratch_space, unescaper, 0, {storage, result});
+  parser::read_value(ps, scratch_space, unescaper, 0,
+                     parser::val_consumer{storage, result});
   return result;
 }
 
@@ -661,7 +767,8 @@ value* parse(file_parser_state& ps, std::pmr::memory_resource* storage) {
   parser::regular_unescaper unescaper;
   std::pmr::polymorphic_allocator<value> alloc{storage};
   auto result = new (alloc.allocate(1)) value();
-  parser::read_value(ps, scratch_space, unescaper, 0, {storage, result});
+  parser::read_value(ps, scratch_space, unescaper, 0,
+                     parser::val_consumer{storage, result});
   return result;
 }
 
@@ -671,17 +778,35 @@ value* parse_shallow(string_parser_state& ps,
   parser::shallow_unescaper unescaper;
   std::pmr::polymorphic_allocator<value> alloc{storage};
   auto result = new (alloc.allocate(1)) value();
-  parser::read_value(ps, scratch_space, unescaper, 0, {storage, result});
+  parser::read_value(ps, scratch_space, unescaper, 0,
+                     parser::val_consumer{storage, result});
   return result;
 }
 
+std::string_view parse_string(string_parser_state& ps,
+                              std::pmr::memory_resource* storage) {
+  unit_t scratch_space;
+  parser::shallow_unescaper unescaper;
+  std::string_view result;
+  parser::read_json_string(ps, scratch_space, unescaper,
+                           parser::key_consumer{storage, &result});
+  return result;
+}
+
+void skip(string_parser_state& ps) {
+  unit_t scratch_space;
+  parser::skip_unescaper unescaper;
+  parser::read_value(ps, scratch_space, unescaper, 0, parser::skip_consumer{});
+}
+
 value* parse_in_situ(mutable_string_parser_state& ps,
                      std::pmr::memory_resource* storage) {
   unit_t scratch_space;
   parser::in_situ_unescaper unescaper;
   std::pmr::polymorphic_allocator<value> alloc{storage};
   auto result = new (alloc.allocate(1)) value();
-  parser::read_value(ps, scratch_space, unescaper, 0, {storage, result});
+  parser::read_value(ps, scratch_space, unescaper, 0,
+                     parser::val_consumer{storage, result});
   return result;
 }
 
@@ -475,6 +475,15 @@ value* parse(file_parser_state& ps, std::pmr::memory_resource* storage);
 value* parse_shallow(string_parser_state& ps,
                      std::pmr::memory_resource* storage);
 
+// Parses a single string and makes a shallow copy whenever possible. Strings
+// with escaped characters are decoded to `storage`.
+std::string_view parse_string(string_parser_state& ps,
+                              std::pmr::memory_resource* storage);
+
+// Skips over the next value in the input without building any nodes. Checks
+// the syntax of the skipped value but does not decode any strings.
+void skip(string_parser_state& ps);
+
 // Parses the input and makes a shallow copy of all strings. Strings with
 // escaped characters are decoded in place.
 value* parse_in_situ(mutable_string_parser_state& ps,
@@ -0,0 +1,47 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/log_rate_limiter.hpp"
+
+#include <algorithm>
+
+namespace caf::detail {
+
+log_rate_limiter::log_rate_limiter(double rate, size_t burst,
+                                   size_t sample) noexcept
+  : interval_(rate > 0 ? static_cast<int64_t>(1e9 / rate) : 0),
+    burst_(std::max(burst, size_t{1})),
+    tolerance_(interval_ * static_cast<int64_t>(burst_ - 1)),
+    sample_(std::max(sample, size_t{1})) {
+  // nop
+}
+
+bool log_rate_limiter::admit(clock_type::time_point now) noexcept {
+  if (sample_ > 1
+      && calls_.fetch_add(1, std::memory_order_relaxed) % sample_ != 0) {
+    suppress();
+    return false;
+  }
+  if (interval_ == 0)
+    return true;
+  using std::chrono::nanoseconds;
+  auto t = std::chrono::duration_cast<nanoseconds>(now.time_since_epoch())
+             .count();
+  auto tat = tat_.load(std::memory_order_relaxed);
+  for (;;) {
+    // An event may pass if the bucket has at least one token left, i.e., if
+    // the theoretical arrival time does not run ahead of `t` by more than
+    // `burst - 1` intervals.
+    auto next = std::max(tat, t);
+    if (next - t > tolerance_) {
+      suppress();
+      return false;
+    }
+    if (tat_.compare_exchange_weak(tat, next + interval_,
+                                   std::memory_order_relaxed))
+      return true;
+  }
+}
+
+} // namespace caf::detail
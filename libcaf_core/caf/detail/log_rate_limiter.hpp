@@ -0,0 +1,105 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf::detail {
+
+/// Limits the number of log events for a single component and log level by
+/// sampling every n-th event and by applying a token bucket. The token bucket
+/// uses the generic cell rate algorithm, which only needs a single atomic
+/// timestamp and thus allows many threads to share one limiter without
+/// locking.
+class CAF_CORE_EXPORT log_rate_limiter {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = std::chrono::steady_clock;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// @param rate The maximum number of events per second or 0 for disabling
+  ///             the token bucket.
+  /// @param burst The maximum number of events that may pass at once.
+  /// @param sample Only every `sample`-th event may pass.
+  log_rate_limiter(double rate, size_t burst, size_t sample) noexcept;
+
+  log_rate_limiter(const log_rate_limiter&) = delete;
+
+  log_rate_limiter& operator=(const log_rate_limiter&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the minimum time between two events in nanoseconds or 0 if the
+  /// token bucket is disabled.
+  int64_t interval() const noexcept {
+    return interval_;
+  }
+
+  /// Returns how many events may pass at once.
+  size_t burst() const noexcept {
+    return burst_;
+  }
+
+  /// Returns the sampling rate.
+  size_t sample() const noexcept {
+    return sample_;
+  }
+
+  // -- rate limiting ----------------------------------------------------------
+
+  /// Checks whether the next event may pass.
+  /// @threadsafe
+  bool admit() noexcept {
+    return admit(clock_type::now());
+  }
+
+  /// Checks whether the next event may pass at time `now`.
+  /// @threadsafe
+  bool admit(clock_type::time_point now) noexcept;
+
+  /// Returns the number of suppressed events since the last call and resets
+  /// the counter.
+  /// @threadsafe
+  uint64_t take_suppressed() noexcept {
+    return suppressed_.exchange(0, std::memory_order_relaxed);
+  }
+
+private:
+  void suppress() noexcept {
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Minimum time between two events in nanoseconds.
+  int64_t interval_;
+
+  /// Maximum number of events that may pass at once.
+  size_t burst_;
+
+  /// Maximum time in nanoseconds that the theoretical arrival time may run
+  /// ahead of the clock.
+  int64_t tolerance_;
+
+  /// Lets only every n-th event pass.
+  size_t sample_;
+
+  /// Counts calls to `admit` for sampling.
+  std::atomic<uint64_t> calls_ = 0;
+
+  /// Theoretical arrival time of the next event in nanoseconds.
+  std::atomic<int64_t> tat_ = 0;
+
+  /// Counts suppressed events.
+  std::atomic<uint64_t> suppressed_ = 0;
+};
+
+} // namespace caf::detail
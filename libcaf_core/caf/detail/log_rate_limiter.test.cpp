@@ -0,0 +1,86 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/log_rate_limiter.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+using detail::log_rate_limiter;
+
+namespace {
+
+// Returns the indexes of all events that pass `uut` at time `t`.
+std::vector<int> admitted(log_rate_limiter& uut, int num,
+                          log_rate_limiter::clock_type::time_point t) {
+  std::vector<int> result;
+  for (int i = 0; i < num; ++i)
+    if (uut.admit(t))
+      result.push_back(i);
+  return result;
+}
+
+} // namespace
+
+TEST("a rate limiter without limits admits all events") {
+  auto uut = log_rate_limiter{0, 0, 0};
+  check_eq(uut.interval(), 0);
+  check_eq(uut.burst(), 1u);
+  check_eq(uut.sample(), 1u);
+  check_eq(admitted(uut, 10, {}).size(), 10u);
+  check_eq(uut.take_suppressed(), 0u);
+}
+
+TEST("a rate limiter with sampling admits every n-th event") {
+  auto uut = log_rate_limiter{0, 0, 3};
+  check_eq(admitted(uut, 10, {}), std::vector{0, 3, 6, 9});
+  check_eq(uut.take_suppressed(), 6u);
+  check_eq(uut.take_suppressed(), 0u);
+}
+
+TEST("a rate limiter with a token bucket admits bursts up to its size") {
+  auto uut = log_rate_limiter{10, 3, 1};
+  check_eq(uut.interval(), 100'000'000);
+  auto t0 = log_rate_limiter::clock_type::time_point{} + 1s;
+  SECTION("the bucket starts full") {
+    check_eq(admitted(uut, 5, t0), std::vector{0, 1, 2});
+    check_eq(uut.take_suppressed(), 2u);
+  }
+  SECTION("the bucket refills one token per interval") {
+    check_eq(admitted(uut, 5, t0).size(), 3u);
+    check_eq(admitted(uut, 5, t0 + 50ms).size(), 0u);
+    check_eq(admitted(uut, 5, t0 + 100ms).size(), 1u);
+    check_eq(admitted(uut, 5, t0 + 300ms).size(), 2u);
+    check_eq(uut.take_suppressed(), 14u);
+  }
+  SECTION("the bucket never holds more tokens than its burst size") {
+    check_eq(admitted(uut, 5, t0).size(), 3u);
+    check_eq(admitted(uut, 5, t0 + 10s).size(), 3u);
+  }
+}
+
+TEST("a rate limiter applies sampling before the token bucket") {
+  auto uut = log_rate_limiter{10, 2, 2};
+  auto t0 = log_rate_limiter::clock_type::time_point{} + 1s;
+  check_eq(admitted(uut, 10, t0), std::vector{0, 2});
+  check_eq(uut.take_suppressed(), 8u);
+}
+
+TEST("threads may share a rate limiter") {
+  auto uut = log_rate_limiter{10, 100, 1};
+  auto t0 = log_rate_limiter::clock_type::time_point{} + 1s;
+  std::atomic<size_t> count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([&] { count += admitted(uut, 1000, t0).size(); });
+  for (auto& thread : threads)
+    thread.join();
+  check_eq(count.load(), 100u);
+  check_eq(uut.take_suppressed(), 3900u);
+}
@@ -0,0 +1,191 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/log_record.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/format.hpp"
+#include "caf/log/event.hpp"
+
+#include <bit>
+#include <sstream>
+
+namespace caf::detail {
+
+namespace {
+
+// Appends `x` in little endian byte order to `buf`.
+template <class T>
+void append_le(byte_buffer& buf, T x) {
+  for (size_t i = 0; i < sizeof(T); ++i)
+    buf.push_back(static_cast<std::byte>((x >> (i * 8)) & 0xFF));
+}
+
+// Appends the size of `str` followed by its characters to `buf`.
+void append_str(byte_buffer& buf, std::string_view str) {
+  append_le(buf, static_cast<uint32_t>(str.size()));
+  auto* bytes = reinterpret_cast<const std::byte*>(str.data());
+  buf.insert(buf.end(), bytes, bytes + str.size());
+}
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+log_record::log_record(const log_record_header& hdr,
+                       std::thread::id tid) noexcept
+  : level_(hdr.level),
+    loc_(source_location::current(hdr.file_name, hdr.function_name,
+                                  static_cast<int>(hdr.line))),
+    aid_(hdr.aid),
+    ts_(hdr.ts),
+    tid_(tid),
+    num_args_(hdr.num_args) {
+  auto* pos = reinterpret_cast<const std::byte*>(&hdr + 1);
+  fmt_ = std::string_view{reinterpret_cast<const char*>(pos), hdr.fmt_size};
+  pos += hdr.fmt_size;
+  component_ = std::string_view{reinterpret_cast<const char*>(pos),
+                                hdr.component_size};
+  pos += hdr.component_size;
+  auto get = [&pos](auto& val) {
+    memcpy(&val, pos, sizeof(val));
+    pos += sizeof(val);
+    return val;
+  };
+  for (size_t i = 0; i < num_args_; ++i) {
+    auto tag = static_cast<log_record_arg_tag>(*pos++);
+    switch (tag) {
+      case log_record_arg_tag::boolean: {
+        uint8_t val;
+        args_[i] = get(val) != 0;
+        break;
+      }
+      case log_record_arg_tag::character: {
+        char val;
+        args_[i] = get(val);
+        break;
+      }
+      case log_record_arg_tag::integer: {
+        int64_t val;
+        args_[i] = get(val);
+        break;
+      }
+      case log_record_arg_tag::unsigned_integer: {
+        uint64_t val;
+        args_[i] = get(val);
+        break;
+      }
+      case log_record_arg_tag::floating_point: {
+        double val;
+        args_[i] = get(val);
+        break;
+      }
+      default: { // log_record_arg_tag::string
+        uint32_t len;
+        get(len);
+        args_[i] = std::string_view{reinterpret_cast<const char*>(pos), len};
+        pos += len;
+      }
+    }
+  }
+}
+
+log_record::log_record(unsigned level, std::string_view component,
+                       const source_location& loc, actor_id aid, timestamp ts,
+                       std::thread::id tid, std::string_view msg) noexcept
+  : level_(level),
+    component_(component),
+    loc_(loc),
+    aid_(aid),
+    ts_(ts),
+    tid_(tid),
+    fmt_(msg),
+    formatted_(true) {
+  // nop
+}
+
+// -- conversion ---------------------------------------------------------------
+
+std::string log_record::message() const {
+  if (formatted_)
+    return std::string{fmt_};
+  std::array<format_arg, max_args> xs;
+  for (size_t i = 0; i < num_args_; ++i)
+    std::visit([&xs, i](auto val) { xs[i] = val; }, args_[i]);
+  auto compiled = compile_format_string(fmt_, std::span{xs.data(), num_args_});
+  std::string result;
+  result.reserve(fmt_.size());
+  while (!compiled->at_end()) {
+    auto chunk = compiled->next();
+    result.insert(result.end(), chunk.begin(), chunk.end());
+  }
+  return result;
+}
+
+log::event_ptr log_record::to_event() const {
+  return log::event::make(level_, component_, loc_, aid_, ts_, tid_,
+                          message());
+}
+
+void log_record::save_binary(byte_buffer& buf) const {
+  // Reserve space for the size prefix.
+  auto start = buf.size();
+  append_le(buf, uint32_t{0});
+  append_le(buf, static_cast<uint32_t>(level_));
+  append_le(buf, static_cast<uint32_t>(loc_.line()));
+  append_le(buf, static_cast<uint8_t>(formatted_ ? 1 : 0));
+  append_le(buf, static_cast<uint8_t>(num_args_));
+  append_le(buf, static_cast<uint64_t>(ts_.time_since_epoch().count()));
+  append_le(buf, static_cast<uint64_t>(aid_));
+  std::ostringstream tid;
+  tid << tid_;
+  append_str(buf, tid.str());
+  append_str(buf, component_);
+  append_str(buf, loc_.file_name());
+  append_str(buf, loc_.function_name());
+  append_str(buf, fmt_);
+  for (const auto& arg : args()) {
+    auto fn = [&buf](auto val) {
+      using val_t = decltype(val);
+      auto put_tag = [&buf](log_record_arg_tag tag) {
+        buf.push_back(static_cast<std::byte>(tag));
+      };
+      if constexpr (std::is_same_v<val_t, bool>) {
+        put_tag(log_record_arg_tag::boolean);
+        append_le(buf, static_cast<uint8_t>(val));
+      } else if constexpr (std::is_same_v<val_t, char>) {
+        put_tag(log_record_arg_tag::character);
+        append_le(buf, static_cast<uint8_t>(val));
+      } else if constexpr (std::is_same_v<val_t, int64_t>) {
+        put_tag(log_record_arg_tag::integer);
+        append_le(buf, static_cast<uint64_t>(val));
+      } else if constexpr (std::is_same_v<val_t, uint64_t>) {
+        put_tag(log_record_arg_tag::unsigned_integer);
+        append_le(buf, val);
+      } else if constexpr (std::is_same_v<val_t, double>) {
+        put_tag(log_record_arg_tag::floating_point);
+        append_le(buf, std::bit_cast<uint64_t>(val));
+      } else {
+        put_tag(log_record_arg_tag::string);
+        append_str(buf, val);
+      }
+    };
+    std::visit(fn, arg);
+  }
+  // Fill in the size prefix.
+  auto size = static_cast<uint32_t>(buf.size() - start - sizeof(uint32_t));
+  for (size_t i = 0; i < sizeof(uint32_t); ++i)
+    buf[start + i] = static_cast<std::byte>((size >> (i * 8)) & 0xFF);
+}
+
+// -- binary log files ---------------------------------------------------------
+
+void save_binary_log_header(byte_buffer& buf, timestamp t0) {
+  auto* magic = reinterpret_cast<const std::byte*>(binary_log_magic.data());
+  buf.insert(buf.end(), magic, magic + binary_log_magic.size());
+  append_le(buf, binary_log_version);
+  append_le(buf, static_cast<uint64_t>(t0.time_since_epoch().count()));
+}
+
+} // namespace caf::detail
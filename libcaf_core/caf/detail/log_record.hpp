@@ -0,0 +1,275 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/concepts.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/source_location.hpp"
+#include "caf/fwd.hpp"
+#include "caf/timestamp.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+namespace caf::detail {
+
+/// Checks whether `T` is a string type that a log record stores by copying
+/// its characters.
+template <class T>
+concept log_string = one_of<std::decay_t<T>, std::string, std::string_view,
+                            const char*, char*>;
+
+/// Checks whether the logger can store a copy of `T` in a log record and
+/// format it later. All other types require formatting on the calling thread.
+template <class T>
+concept deferrable_log_arg
+  = one_of<std::decay_t<T>, bool, char, float, double>
+    || (std::integral<std::decay_t<T>>
+        && !one_of<std::decay_t<T>, wchar_t, char8_t, char16_t, char32_t>)
+    || log_string<T>;
+
+/// An argument of a log record. Strings point into the record.
+using log_record_arg
+  = std::variant<bool, char, int64_t, uint64_t, double, std::string_view>;
+
+/// Tags the type of an encoded argument in a log record.
+enum class log_record_arg_tag : uint8_t {
+  boolean,
+  character,
+  integer,
+  unsigned_integer,
+  floating_point,
+  string,
+};
+
+/// Fixed-size part of a log record in a @ref log_ring. The format string, the
+/// component name and the encoded arguments follow the header.
+struct log_record_header {
+  /// Points to an event that the logger formatted on the calling thread. All
+  /// other members except the timestamp are unused for these records.
+  log::event* event;
+
+  /// The time when the event was logged.
+  timestamp ts;
+
+  /// The ID of the actor that logged the event.
+  actor_id aid;
+
+  /// The size of the name of the component that generated the event.
+  uint32_t component_size;
+
+  /// The name of the file in which the event was generated.
+  const char* file_name;
+
+  /// The name of the function in which the event was generated.
+  const char* function_name;
+
+  /// The line number at which the event was generated.
+  uint32_t line;
+
+  /// The severity level of the event.
+  uint32_t level;
+
+  /// The size of the format string.
+  uint32_t fmt_size;
+
+  /// The number of arguments that follow the format string.
+  uint32_t num_args;
+};
+
+/// A decoded log record with deferred formatting.
+class CAF_CORE_EXPORT log_record {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// The maximum number of arguments for a single record.
+  static constexpr size_t max_args = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  log_record() = default;
+
+  /// Decodes the record that starts with `hdr`.
+  /// @pre `hdr.event == nullptr`
+  log_record(const log_record_header& hdr, std::thread::id tid) noexcept;
+
+  /// Creates a record for an already formatted message.
+  log_record(unsigned level, std::string_view component,
+             const source_location& loc, actor_id aid, timestamp ts,
+             std::thread::id tid, std::string_view msg) noexcept;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the severity level of the event.
+  unsigned level() const noexcept {
+    return level_;
+  }
+
+  /// Returns the name of the component that generated the event.
+  std::string_view component() const noexcept {
+    return component_;
+  }
+
+  /// Returns the source location of the logging call.
+  const source_location& location() const noexcept {
+    return loc_;
+  }
+
+  /// Returns the ID of the actor that generated the event.
+  actor_id aid() const noexcept {
+    return aid_;
+  }
+
+  /// Returns the timestamp of the event.
+  timestamp ts() const noexcept {
+    return ts_;
+  }
+
+  /// Returns the ID of the thread that generated the event.
+  std::thread::id thread_id() const noexcept {
+    return tid_;
+  }
+
+  /// Returns the format string or the message if `formatted()` is `true`.
+  std::string_view fmt() const noexcept {
+    return fmt_;
+  }
+
+  /// Returns whether `fmt()` returns an already formatted message.
+  bool formatted() const noexcept {
+    return formatted_;
+  }
+
+  /// Returns the arguments for the format string.
+  std::span<const log_record_arg> args() const noexcept {
+    return {args_.data(), num_args_};
+  }
+
+  // -- conversion -------------------------------------------------------------
+
+  /// Formats the message of the event.
+  std::string message() const;
+
+  /// Creates a log event with the formatted message.
+  log::event_ptr to_event() const;
+
+  /// Appends the record in the binary log file format to `buf`.
+  void save_binary(byte_buffer& buf) const;
+
+private:
+  unsigned level_ = 0;
+  std::string_view component_;
+  source_location loc_;
+  actor_id aid_ = 0;
+  timestamp ts_;
+  std::thread::id tid_;
+  std::string_view fmt_;
+  bool formatted_ = false;
+  size_t num_args_ = 0;
+  std::array<log_record_arg, max_args> args_;
+};
+
+// -- binary log files ---------------------------------------------------------
+
+/// Identifies binary log files. The magic number is followed by a version
+/// number and the start time of the logger.
+constexpr std::string_view binary_log_magic = "CAF-BLOG";
+
+/// The current version of the binary log file format.
+constexpr uint32_t binary_log_version = 1;
+
+/// Appends the header of a binary log file to `buf`.
+CAF_CORE_EXPORT void save_binary_log_header(byte_buffer& buf, timestamp t0);
+
+// -- encoding -----------------------------------------------------------------
+
+/// Returns the number of bytes for storing `x` in a log record.
+template <deferrable_log_arg T>
+size_t log_record_arg_size(const T& x) noexcept {
+  if constexpr (log_string<T>)
+    return 1 + sizeof(uint32_t) + std::string_view{x}.size();
+  else if constexpr (one_of<T, bool, char>)
+    return 2;
+  else
+    return 1 + sizeof(uint64_t);
+}
+
+/// Returns the number of bytes that `encode_log_record` writes for a record
+/// with component name `component`, format string `fmt` and arguments `xs`.
+template <class... Ts>
+size_t log_record_size(std::string_view component, std::string_view fmt,
+                       const Ts&... xs) noexcept {
+  return sizeof(log_record_header) + fmt.size() + component.size()
+         + (log_record_arg_size(xs) + ... + 0);
+}
+
+/// Encodes a single argument of a log record to `out` and returns the
+/// position after the argument.
+template <deferrable_log_arg T>
+std::byte* encode_log_record_arg(std::byte* out, const T& x) noexcept {
+  auto put = [&out](log_record_arg_tag tag, const auto& val) {
+    *out++ = static_cast<std::byte>(tag);
+    memcpy(out, &val, sizeof(val));
+    out += sizeof(val);
+  };
+  if constexpr (log_string<T>) {
+    auto str = std::string_view{x};
+    put(log_record_arg_tag::string, static_cast<uint32_t>(str.size()));
+    memcpy(out, str.data(), str.size());
+    out += str.size();
+  } else if constexpr (std::is_same_v<T, bool>) {
+    put(log_record_arg_tag::boolean, static_cast<uint8_t>(x));
+  } else if constexpr (std::is_same_v<T, char>) {
+    put(log_record_arg_tag::character, x);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    put(log_record_arg_tag::floating_point, static_cast<double>(x));
+  } else if constexpr (std::is_signed_v<T>) {
+    put(log_record_arg_tag::integer, static_cast<int64_t>(x));
+  } else {
+    put(log_record_arg_tag::unsigned_integer, static_cast<uint64_t>(x));
+  }
+  return out;
+}
+
+/// Encodes a log record to `out`, which must have at least
+/// `log_record_size(component, fmt, xs...)` bytes and must be suitably aligned
+/// for @ref log_record_header. The record stores copies of all strings, since
+/// the logger may decode it after the caller has returned.
+template <class... Ts>
+void encode_log_record(std::byte* out, unsigned level,
+                       std::string_view component, const source_location& loc,
+                       actor_id aid, std::string_view fmt,
+                       const Ts&... xs) noexcept {
+  static_assert(sizeof...(Ts) <= log_record::max_args);
+  auto* hdr = new (out) log_record_header;
+  hdr->event = nullptr;
+  hdr->ts = make_timestamp();
+  hdr->aid = aid;
+  hdr->component_size = static_cast<uint32_t>(component.size());
+  hdr->file_name = loc.file_name();
+  hdr->function_name = loc.function_name();
+  hdr->line = static_cast<uint32_t>(loc.line());
+  hdr->level = level;
+  hdr->fmt_size = static_cast<uint32_t>(fmt.size());
+  hdr->num_args = static_cast<uint32_t>(sizeof...(Ts));
+  out += sizeof(log_record_header);
+  memcpy(out, fmt.data(), fmt.size());
+  out += fmt.size();
+  memcpy(out, component.data(), component.size());
+  out += component.size();
+  ((out = encode_log_record_arg(out, xs)), ...);
+}
+
+} // namespace caf::detail
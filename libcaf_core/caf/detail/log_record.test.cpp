@@ -0,0 +1,198 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/log_record.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/format.hpp"
+#include "caf/log/event.hpp"
+#include "caf/log/level.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+using detail::log_record;
+using detail::log_record_header;
+
+namespace {
+
+// Stores an encoded log record in a properly aligned buffer.
+struct encoded_record {
+  template <class... Ts>
+  encoded_record(std::string_view fmt, const Ts&... xs)
+    : buf((detail::log_record_size("foo", fmt, xs...) + 7) / 8) {
+    detail::encode_log_record(data(), log::level::debug, "foo", loc, 42, fmt,
+                              xs...);
+  }
+
+  std::byte* data() {
+    return reinterpret_cast<std::byte*>(buf.data());
+  }
+
+  log_record decode() {
+    auto* hdr = reinterpret_cast<const log_record_header*>(data());
+    return log_record{*hdr, std::this_thread::get_id()};
+  }
+
+  detail::source_location loc = detail::source_location::current();
+  std::vector<uint64_t> buf;
+};
+
+template <class... Ts>
+std::string deferred_format(std::string_view fmt, const Ts&... xs) {
+  return encoded_record{fmt, xs...}.decode().message();
+}
+
+// Reads integers and strings from a record in the binary log file format.
+struct binary_reader {
+  const_byte_span bytes;
+
+  template <class T>
+  T read() {
+    uint64_t result = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+      result |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+    bytes = bytes.subspan(sizeof(T));
+    return static_cast<T>(result);
+  }
+
+  std::string read_str() {
+    auto len = read<uint32_t>();
+    auto result = std::string{reinterpret_cast<const char*>(bytes.data()),
+                              len};
+    bytes = bytes.subspan(len);
+    return result;
+  }
+};
+
+} // namespace
+
+TEST("log records store copies of their arguments") {
+  auto str = "hello"s;
+  auto rec = encoded_record{"{} {} {} {} {} {}", true, 'x', -7, 8u, 2.5, str};
+  str = "world";
+  auto uut = rec.decode();
+  check_eq(uut.level(), log::level::debug);
+  check_eq(uut.component(), "foo");
+  check_eq(uut.aid(), 42u);
+  check_eq(uut.location().line(), rec.loc.line());
+  check_eq(uut.location().file_name(), rec.loc.file_name());
+  check(uut.thread_id() == std::this_thread::get_id());
+  check_eq(uut.fmt(), "{} {} {} {} {} {}");
+  check(!uut.formatted());
+  if (check_eq(uut.args().size(), 6u)) {
+    check_eq(std::get<bool>(uut.args()[0]), true);
+    check_eq(std::get<char>(uut.args()[1]), 'x');
+    check_eq(std::get<int64_t>(uut.args()[2]), -7);
+    check_eq(std::get<uint64_t>(uut.args()[3]), 8u);
+    check_eq(std::get<double>(uut.args()[4]), test::approx{2.5});
+    check_eq(std::get<std::string_view>(uut.args()[5]), "hello");
+  }
+  check_eq(uut.message(), detail::format("{} {} {} {} {} {}", true, 'x', -7,
+                                        8u, 2.5, "hello"s));
+}
+
+TEST("log records store a copy of the component name") {
+  auto component = "caf.foo"s;
+  auto loc = detail::source_location::current();
+  auto buf = std::vector<uint64_t>(
+    (detail::log_record_size(component, "{}", 1) + 7) / 8);
+  auto* ptr = reinterpret_cast<std::byte*>(buf.data());
+  detail::encode_log_record(ptr, log::level::debug, component, loc, 42, "{}",
+                            1);
+  component = "caf.bar";
+  auto* hdr = reinterpret_cast<const log_record_header*>(ptr);
+  auto uut = log_record{*hdr, std::this_thread::get_id()};
+  check_eq(uut.component(), "caf.foo");
+  check_eq(uut.message(), "1");
+}
+
+TEST("log records format their arguments like the logger") {
+  auto cstr = "abc";
+  auto sv = "def"sv;
+  check_eq(deferred_format("no arguments"), "no arguments");
+  check_eq(deferred_format("{{}}"), "{}");
+  check_eq(deferred_format("{} {} {}", cstr, sv, "ghi"),
+           detail::format("{} {} {}", cstr, sv, "ghi"));
+  check_eq(deferred_format("{1} {0}", 1, 2), detail::format("{1} {0}", 1, 2));
+  check_eq(deferred_format("{:x} {:#o}", 42, 42u),
+           detail::format("{:x} {:#o}", 42, 42u));
+  check_eq(deferred_format("{:.3f}", 2.5), detail::format("{:.3f}", 2.5));
+  check_eq(deferred_format("{:5}|{:<5}|", 42, "ab"),
+           detail::format("{:5}|{:<5}|", 42, "ab"));
+  check_eq(deferred_format("{}", int8_t{-1}), detail::format("{}", int8_t{-1}));
+  check_eq(deferred_format("{}", uint64_t{18446744073709551615u}),
+           "18446744073709551615");
+}
+
+TEST("formatted log records return their message as-is") {
+  auto loc = detail::source_location::current();
+  auto ts = make_timestamp();
+  auto uut = log_record{log::level::info, "foo", loc, 7, ts, std::thread::id{},
+                        "{} stays"};
+  check(uut.formatted());
+  check_eq(uut.message(), "{} stays");
+  auto event = uut.to_event();
+  check_eq(event->level(), log::level::info);
+  check_eq(event->component(), "foo");
+  check_eq(event->line_number(), loc.line());
+  check_eq(event->actor_id(), 7u);
+  check_eq(event->timestamp(), ts);
+  check(event->thread_id() == std::thread::id{});
+  check_eq(to_string(event->message()), "{} stays");
+}
+
+TEST("log records convert to events with the original timestamp") {
+  auto rec = encoded_record{"value: {}", 23};
+  auto uut = rec.decode();
+  auto event = uut.to_event();
+  check_eq(event->timestamp(), uut.ts());
+  check(event->thread_id() == std::this_thread::get_id());
+  check_eq(to_string(event->message()), "value: 23");
+}
+
+TEST("log records use a portable encoding in binary log files") {
+  auto rec = encoded_record{"{}: {}", "answer", -42};
+  auto uut = rec.decode();
+  auto buf = byte_buffer{};
+  uut.save_binary(buf);
+  auto reader = binary_reader{buf};
+  check_eq(reader.read<uint32_t>(), buf.size() - 4);
+  check_eq(reader.read<uint32_t>(), log::level::debug);
+  check_eq(reader.read<uint32_t>(), rec.loc.line());
+  check_eq(reader.read<uint8_t>(), 0u); // flags
+  check_eq(reader.read<uint8_t>(), 2u); // number of arguments
+  check_eq(reader.read<int64_t>(), uut.ts().time_since_epoch().count());
+  check_eq(reader.read<uint64_t>(), 42u);
+  check(!reader.read_str().empty()); // thread ID
+  check_eq(reader.read_str(), "foo");
+  check_eq(reader.read_str(), rec.loc.file_name());
+  check_eq(reader.read_str(), rec.loc.function_name());
+  check_eq(reader.read_str(), "{}: {}");
+  check_eq(reader.read<uint8_t>(), 5u); // string
+  check_eq(reader.read_str(), "answer");
+  check_eq(reader.read<uint8_t>(), 2u); // integer
+  check_eq(reader.read<int64_t>(), -42);
+  check(reader.bytes.empty());
+}
+
+TEST("binary log files start with a magic number") {
+  auto t0 = make_timestamp();
+  auto buf = byte_buffer{};
+  detail::save_binary_log_header(buf, t0);
+  auto reader = binary_reader{buf};
+  auto magic = std::string{reinterpret_cast<const char*>(buf.data()), 8};
+  check_eq(magic, "CAF-BLOG");
+  reader.bytes = reader.bytes.subspan(8);
+  check_eq(reader.read<uint32_t>(), detail::binary_log_version);
+  check_eq(reader.read<int64_t>(), t0.time_since_epoch().count());
+  check(reader.bytes.empty());
+}
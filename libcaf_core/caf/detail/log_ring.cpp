@@ -0,0 +1,132 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/log_ring.hpp"
+
+#include "caf/log/event.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+
+namespace caf::detail {
+
+namespace {
+
+// Each slot starts with its size, stored as 64-bit integer to keep the record
+// header aligned. A size of 0 marks the unused bytes at the end of the ring
+// when a slot did not fit into the remaining space.
+constexpr size_t slot_header_size = sizeof(uint64_t);
+
+constexpr uint64_t wrap_marker = 0;
+
+constexpr size_t slot_size(size_t record_size) noexcept {
+  auto n = slot_header_size + record_size;
+  return (n + slot_header_size - 1) & ~(slot_header_size - 1);
+}
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+log_ring::log_ring(size_t capacity)
+  : capacity_(std::bit_ceil(std::max(capacity, size_t{1024}))),
+    buf_(std::make_unique<uint64_t[]>(capacity_ / sizeof(uint64_t))),
+    tid_(std::this_thread::get_id()),
+    closed_(false),
+    wr_pos_(0),
+    rd_pos_(0) {
+  // nop
+}
+
+log_ring::~log_ring() {
+  // Release any event that the consumer did not pick up.
+  while (front() != nullptr)
+    pop();
+}
+
+// -- producer API -------------------------------------------------------------
+
+bool log_ring::push(log::event_ptr&& event) {
+  auto* buf = reserve(sizeof(log_record_header));
+  if (buf == nullptr)
+    return false;
+  auto* hdr = new (buf) log_record_header{};
+  hdr->ts = event->timestamp();
+  hdr->event = event.release();
+  commit();
+  return true;
+}
+
+std::byte* log_ring::reserve(size_t size) {
+  auto total = slot_size(size);
+  // Records larger than half of the ring may never fit if they require a
+  // wrap-around.
+  if (total > capacity_ / 2)
+    return nullptr;
+  auto pos = wr_pos_.load(std::memory_order_relaxed);
+  auto remainder = capacity_ - (pos & (capacity_ - 1));
+  auto padding = remainder < total ? remainder : size_t{0};
+  auto required = padding + total;
+  while (capacity_ - (pos - cached_rd_pos_) < required) {
+    cached_rd_pos_ = rd_pos_.load(std::memory_order_acquire);
+    if (capacity_ - (pos - cached_rd_pos_) >= required)
+      break;
+    if (closed_.load(std::memory_order_relaxed))
+      return nullptr;
+    std::this_thread::yield();
+  }
+  if (closed_.load(std::memory_order_relaxed))
+    return nullptr;
+  if (padding > 0) {
+    memcpy(slot(pos), &wrap_marker, slot_header_size);
+    pos += padding;
+  }
+  auto len = static_cast<uint64_t>(total);
+  memcpy(slot(pos), &len, slot_header_size);
+  reserved_pos_ = pos + total;
+  return slot(pos) + slot_header_size;
+}
+
+void log_ring::commit() noexcept {
+  wr_pos_.store(reserved_pos_, std::memory_order_release);
+}
+
+// -- consumer API -------------------------------------------------------------
+
+const log_record_header* log_ring::front() noexcept {
+  auto pos = rd_pos_.load(std::memory_order_relaxed);
+  if (pos == cached_wr_pos_) {
+    cached_wr_pos_ = wr_pos_.load(std::memory_order_acquire);
+    if (pos == cached_wr_pos_)
+      return nullptr;
+  }
+  uint64_t size;
+  memcpy(&size, slot(pos), slot_header_size);
+  if (size == wrap_marker) {
+    // The producer always commits the marker together with the next slot.
+    pos += capacity_ - (pos & (capacity_ - 1));
+    rd_pos_.store(pos, std::memory_order_release);
+  }
+  return reinterpret_cast<const log_record_header*>(slot(pos)
+                                                    + slot_header_size);
+}
+
+log::event_ptr log_ring::pop() noexcept {
+  auto pos = rd_pos_.load(std::memory_order_relaxed);
+  uint64_t size;
+  memcpy(&size, slot(pos), slot_header_size);
+  auto* hdr = reinterpret_cast<log_record_header*>(slot(pos)
+                                                   + slot_header_size);
+  auto result = log::event_ptr{hdr->event, false};
+  rd_pos_.store(pos + size, std::memory_order_release);
+  return result;
+}
+
+void log_ring::close() noexcept {
+  closed_.store(true, std::memory_order_relaxed);
+}
+
+} // namespace caf::detail
@@ -0,0 +1,131 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/log_record.hpp"
+#include "caf/detail/source_location.hpp"
+#include "caf/fwd.hpp"
+#include "caf/ref_counted.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+namespace caf::detail {
+
+/// A lock-free ring buffer for log records with a single producer and a single
+/// consumer. When formatting log events in the logger thread, each thread that
+/// logs owns one ring and the logger thread consumes the records of all rings.
+///
+/// The producer stores each record in a contiguous slot and waits for the
+/// consumer if the ring is full.
+class CAF_CORE_EXPORT log_ring : public ref_counted {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a ring for the calling thread with at least `capacity` bytes.
+  explicit log_ring(size_t capacity);
+
+  log_ring(const log_ring&) = delete;
+
+  log_ring& operator=(const log_ring&) = delete;
+
+  ~log_ring() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the ID of the thread that created this ring.
+  std::thread::id thread_id() const noexcept {
+    return tid_;
+  }
+
+  /// Returns the size of the ring in bytes.
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // -- producer API -----------------------------------------------------------
+
+  /// Stores a log record for formatting the event later. Returns `false` if
+  /// the record does not fit into the ring or if the ring has been closed.
+  template <class... Ts>
+  bool push(unsigned level, std::string_view component,
+            const source_location& loc, actor_id aid, std::string_view fmt,
+            const Ts&... xs) {
+    auto* buf = reserve(log_record_size(component, fmt, xs...));
+    if (buf == nullptr)
+      return false;
+    encode_log_record(buf, level, component, loc, aid, fmt, xs...);
+    commit();
+    return true;
+  }
+
+  /// Stores an event that has been formatted on the calling thread. Returns
+  /// `false` if the ring has been closed.
+  bool push(log::event_ptr&& event);
+
+  // -- consumer API -----------------------------------------------------------
+
+  /// Returns the header of the next record or `nullptr` if the ring is empty.
+  const log_record_header* front() noexcept;
+
+  /// Removes the next record from the ring and returns its event if the
+  /// producer pushed a formatted event.
+  /// @pre `front() != nullptr`
+  log::event_ptr pop() noexcept;
+
+  /// Rejects all future records and wakes up producers that wait for space.
+  void close() noexcept;
+
+private:
+  /// Returns a pointer to `size` bytes in the ring or `nullptr` if the record
+  /// does not fit or if the ring has been closed.
+  std::byte* reserve(size_t size);
+
+  /// Makes the reserved slot visible to the consumer.
+  void commit() noexcept;
+
+  /// Returns a pointer to the slot at `pos`.
+  std::byte* slot(size_t pos) noexcept {
+    return reinterpret_cast<std::byte*>(buf_.get()) + (pos & (capacity_ - 1));
+  }
+
+  /// The size of the ring in bytes. Always a power of two.
+  size_t capacity_;
+
+  /// Stores the slots.
+  std::unique_ptr<uint64_t[]> buf_;
+
+  /// The thread that created the ring.
+  std::thread::id tid_;
+
+  /// Signals that the ring rejects all future records.
+  std::atomic<bool> closed_;
+
+  /// Points to the end of the last committed slot.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> wr_pos_;
+
+  /// Points to the end of the reserved slot. Only used by the producer.
+  size_t reserved_pos_ = 0;
+
+  /// Caches the last known read position. Only used by the producer.
+  size_t cached_rd_pos_ = 0;
+
+  /// Points to the beginning of the next slot.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> rd_pos_;
+
+  /// Caches the last known write position. Only used by the consumer.
+  size_t cached_wr_pos_ = 0;
+};
+
+/// @relates log_ring
+using log_ring_ptr = intrusive_ptr<log_ring>;
+
+} // namespace caf::detail
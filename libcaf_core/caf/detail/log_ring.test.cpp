@@ -0,0 +1,149 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/log_ring.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/log/event.hpp"
+#include "caf/log/level.hpp"
+
+#include <string>
+#include <thread>
+
+using namespace caf;
+using namespace std::literals;
+
+using detail::log_record;
+using detail::log_ring;
+using detail::log_ring_ptr;
+
+namespace {
+
+constexpr auto loc = detail::source_location{};
+
+// Removes the next record from the ring and returns its message.
+std::string pop_message(log_ring& ring) {
+  auto* hdr = ring.front();
+  if (hdr == nullptr)
+    return "<empty>";
+  std::string result;
+  if (hdr->event != nullptr) {
+    auto event = ring.pop();
+    result = to_string(event->message());
+  } else {
+    result = log_record{*hdr, ring.thread_id()}.message();
+    ring.pop();
+  }
+  return result;
+}
+
+} // namespace
+
+TEST("log rings have at least 1 KiB and a capacity that is a power of two") {
+  check_eq(log_ring{0}.capacity(), 1024u);
+  check_eq(log_ring{1024}.capacity(), 1024u);
+  check_eq(log_ring{1025}.capacity(), 2048u);
+  check(log_ring{0}.thread_id() == std::this_thread::get_id());
+}
+
+TEST("log rings store deferred records in FIFO order") {
+  auto uut = log_ring{1024};
+  check_eq(uut.front(), nullptr);
+  check(uut.push(log::level::debug, "foo", loc, 1, "first: {}", 1));
+  // The ring must not keep references to the component name.
+  check(uut.push(log::level::info, "bar"s, loc, 2, "second: {}", "two"));
+  if (auto* hdr = uut.front(); check_ne(hdr, nullptr)) {
+    check_eq(hdr->level, log::level::debug);
+    check_eq(log_record(*hdr, uut.thread_id()).component(), "foo");
+    check_eq(hdr->aid, 1u);
+  }
+  check_eq(pop_message(uut), "first: 1");
+  if (auto* hdr = uut.front(); check_ne(hdr, nullptr))
+    check_eq(log_record(*hdr, uut.thread_id()).component(), "bar");
+  check_eq(pop_message(uut), "second: two");
+  check_eq(uut.front(), nullptr);
+}
+
+TEST("log rings transfer ownership of formatted events") {
+  auto event = log::event::make(log::level::warning, "foo", loc, 0, "hello");
+  auto* ptr = event.get();
+  auto uut = log_ring{1024};
+  check(uut.push(log::event_ptr{event}));
+  check(!event->unique());
+  if (auto* hdr = uut.front(); check_ne(hdr, nullptr)) {
+    check_eq(hdr->event, ptr);
+    check_eq(hdr->ts, event->timestamp());
+  }
+  auto popped = uut.pop();
+  check_eq(popped.get(), ptr);
+  popped = nullptr;
+  check(event->unique());
+}
+
+TEST("log rings release pending events when destroyed") {
+  auto event = log::event::make(log::level::warning, "foo", loc, 0, "hello");
+  {
+    auto uut = log_ring{1024};
+    check(uut.push(log::event_ptr{event}));
+    check(!event->unique());
+  }
+  check(event->unique());
+}
+
+TEST("log rings wrap around at the end of the buffer") {
+  auto uut = log_ring{1024};
+  for (int i = 0; i < 1000; ++i) {
+    auto str = std::to_string(i);
+    if (!check(uut.push(log::level::debug, "foo", loc, 0, "{} {}", i, str)))
+      return;
+    check_eq(pop_message(uut), str + ' ' + str);
+  }
+  check_eq(uut.front(), nullptr);
+}
+
+TEST("log rings reject records that exceed half of their capacity") {
+  auto uut = log_ring{1024};
+  auto str = std::string(600, 'x');
+  check(!uut.push(log::level::debug, "foo", loc, 0, "{}", str));
+  check_eq(uut.front(), nullptr);
+}
+
+TEST("closed log rings reject all records") {
+  auto uut = log_ring{1024};
+  uut.close();
+  check(!uut.push(log::level::debug, "foo", loc, 0, "{}", 1));
+  auto event = log::event::make(log::level::warning, "foo", loc, 0, "hello");
+  check(!uut.push(log::event_ptr{event}));
+  check_eq(uut.front(), nullptr);
+  check(event->unique());
+}
+
+TEST("the consumer of a log ring receives all records in order") {
+  constexpr int num_records = 100'000;
+  auto uut = make_counted<log_ring>(1024);
+  auto producer = std::thread{[ring = uut] {
+    for (int i = 0; i < num_records; ++i) {
+      if (i % 10 == 0) {
+        auto msg = std::to_string(i);
+        ring->push(log::event::make(log::level::debug, "foo", loc, 0, msg));
+      } else {
+        ring->push(log::level::debug, "foo", loc, 0, "{}", i);
+      }
+    }
+  }};
+  auto next = 0;
+  auto in_order = true;
+  while (next < num_records) {
+    if (uut->front() == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    in_order = in_order && pop_message(*uut) == std::to_string(next);
+    ++next;
+  }
+  producer.join();
+  check(in_order);
+  check_eq(uut->front(), nullptr);
+}
@@ -5,6 +5,11 @@
 #pragma once
 
 #include "caf/config.hpp"
+#include "caf/detail/squashed_int.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 
 namespace caf::detail {
 
@@ -51,4 +56,31 @@ T from_network_order(T value) {
   return to_network_order(value);
 }
 
+/// Converts `count` integers from `src` to network byte order and writes them
+/// to `dst`. The loop only uses unaligned loads and stores of single integers,
+/// which allows the compiler to vectorize the byte swapping.
+template <class T>
+void to_network_order(const T* src, size_t count, std::byte* dst) {
+  using unsigned_type = squashed_int_t<std::make_unsigned_t<T>>;
+  for (size_t i = 0; i < count; ++i) {
+    unsigned_type tmp;
+    memcpy(&tmp, src + i, sizeof(T));
+    tmp = to_network_order(tmp);
+    memcpy(dst + i * sizeof(T), &tmp, sizeof(T));
+  }
+}
+
+/// Reads `count` integers in network byte order from `src` and writes them to
+/// `dst` in native byte order.
+template <class T>
+void from_network_order(const std::byte* src, size_t count, T* dst) {
+  using unsigned_type = squashed_int_t<std::make_unsigned_t<T>>;
+  for (size_t i = 0; i < count; ++i) {
+    unsigned_type tmp;
+    memcpy(&tmp, src + i * sizeof(T), sizeof(T));
+    tmp = from_network_order(tmp);
+    memcpy(dst + i, &tmp, sizeof(T));
+  }
+}
+
 } // namespace caf::detail
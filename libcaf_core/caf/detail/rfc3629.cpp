@@ -4,6 +4,16 @@
 
 #include "caf/detail/rfc3629.hpp"
 
+#include "caf/config.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#ifdef CAF_HAS_SSE2
+#  include <emmintrin.h>
+#endif
+
 namespace {
 
 // Convenient literal for std::byte.
@@ -37,6 +47,41 @@ constexpr bool is_continuation_byte(std::byte value) noexcept {
   return head<2>(value) == 0b1000'0000_b;
 }
 
+// Returns the position of the first non-ASCII byte in the range [first, last),
+// or `last` if the range contains only ASCII characters. Checks 32 bytes per
+// step with SSE2 and 8 bytes per step otherwise.
+const std::byte* skip_ascii(const std::byte* first,
+                            const std::byte* last) noexcept {
+#ifdef CAF_HAS_SSE2
+  auto load = [](const std::byte* ptr) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  };
+  // The mask has a bit set for each byte with the high bit set.
+  while (last - first >= 32) {
+    auto block = _mm_or_si128(load(first), load(first + 16));
+    if (_mm_movemask_epi8(block) != 0)
+      break;
+    first += 32;
+  }
+  while (last - first >= 16) {
+    if (auto mask = _mm_movemask_epi8(load(first)); mask != 0)
+      return first + std::countr_zero(static_cast<unsigned>(mask));
+    first += 16;
+  }
+#else
+  while (last - first >= 8) {
+    uint64_t block;
+    memcpy(&block, first, sizeof(block));
+    if ((block & 0x8080808080808080) != 0)
+      break; // Let the loop below find the exact position.
+    first += 8;
+  }
+#endif
+  while (first != last && head<1>(*first) == 0b0000'0000_b)
+    ++first;
+  return first;
+}
+
 // The following code is based on the algorithm described in
 // http://unicode.org/mail-arch/unicode-ml/y2003-m02/att-0467/01-The_Algorithm_to_Valide_an_UTF-8_String
 // Returns a pair consisting of an iterator to the of the valid  range, and a
@@ -45,11 +90,14 @@ constexpr bool is_continuation_byte(std::byte value) noexcept {
 std::pair<const std::byte*, bool> validate_rfc3629(const std::byte* first,
                                                    const std::byte* last) {
   while (first != last) {
+    // First bit is zero: ASCII character. Since most text consists of long
+    // runs of ASCII characters, we skip over them in bulk.
+    if (head<1>(*first) == 0b0000'0000_b) {
+      first = skip_ascii(first, last);
+      continue;
+    }
     auto checkpoint = first;
     auto x = *first++;
-    // First bit is zero: ASCII character.
-    if (head<1>(x) == 0b0000'0000_b)
-      continue;
     // 110b'xxxx: 2-byte sequence.
     if (head<3>(x) == 0b1100'0000_b) {
       // No non-shortest form.
@@ -222,3 +222,26 @@ TEST("rfc3629::validate stops at the first invalid byte") {
     check_eq(rfc3629::validate(data), res_t{10, false});
   }
 }
+
+TEST("rfc3629::validate finds invalid bytes in long ASCII runs") {
+  // Covers all offsets relative to the blocks of the bulk ASCII check.
+  for (size_t len = 1; len < 80; ++len) {
+    for (size_t pos = 0; pos < len; ++pos) {
+      // Invalid byte.
+      auto str = std::string(len, 'x');
+      str[pos] = static_cast<char>(0xff);
+      if (!check_eq(rfc3629::validate(str), res_t{pos, false}))
+        return;
+      // Incomplete sequence at the end.
+      str.resize(pos);
+      str += "\xe2\x82";
+      if (!check_eq(rfc3629::validate(str), res_t{pos, true}))
+        return;
+      // Multibyte sequence in between ASCII characters.
+      str = std::string(len, 'x');
+      str.insert(pos, "\xe2\x82\xac");
+      if (!check_eq(rfc3629::validate(str), res_t{str.size(), false}))
+        return;
+    }
+  }
+}
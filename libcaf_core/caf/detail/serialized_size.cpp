@@ -0,0 +1,234 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/serialized_size.hpp"
+
+#include "caf/actor_control_block.hpp"
+#include "caf/node_id.hpp"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace caf::detail {
+
+namespace {
+
+template <class T>
+constexpr size_t max_value = static_cast<size_t>(std::numeric_limits<T>::max());
+
+/// Returns the size of a variant index for `num_types` alternatives in the
+/// binary format.
+constexpr size_t index_size(size_t num_types) noexcept {
+  if (num_types < max_value<int8_t>)
+    return sizeof(int8_t);
+  else if (num_types < max_value<int16_t>)
+    return sizeof(int16_t);
+  else if (num_types < max_value<int32_t>)
+    return sizeof(int32_t);
+  else
+    return sizeof(int64_t);
+}
+
+} // namespace
+
+serialized_size_inspector::~serialized_size_inspector() {
+  // nop
+}
+
+actor_system* serialized_size_inspector::sys() const noexcept {
+  return sys_;
+}
+
+bool serialized_size_inspector::has_human_readable_format() const noexcept {
+  return false;
+}
+
+void serialized_size_inspector::set_error(error stop_reason) {
+  err_ = std::move(stop_reason);
+}
+
+error& serialized_size_inspector::get_error() noexcept {
+  return err_;
+}
+
+bool serialized_size_inspector::begin_object(type_id_t, std::string_view) {
+  return true;
+}
+
+bool serialized_size_inspector::end_object() {
+  return true;
+}
+
+bool serialized_size_inspector::begin_field(std::string_view) {
+  return true;
+}
+
+bool serialized_size_inspector::begin_field(std::string_view, bool) {
+  result_ += sizeof(uint8_t);
+  return true;
+}
+
+bool serialized_size_inspector::begin_field(std::string_view,
+                                            std::span<const type_id_t> types,
+                                            size_t) {
+  result_ += index_size(types.size());
+  return true;
+}
+
+bool serialized_size_inspector::begin_field(std::string_view, bool,
+                                            std::span<const type_id_t> types,
+                                            size_t) {
+  result_ += index_size(types.size());
+  return true;
+}
+
+bool serialized_size_inspector::end_field() {
+  return true;
+}
+
+bool serialized_size_inspector::begin_tuple(size_t) {
+  return true;
+}
+
+bool serialized_size_inspector::end_tuple() {
+  return true;
+}
+
+bool serialized_size_inspector::begin_key_value_pair() {
+  return true;
+}
+
+bool serialized_size_inspector::end_key_value_pair() {
+  return true;
+}
+
+bool serialized_size_inspector::begin_sequence(size_t list_size) {
+  // Mirrors the varbyte encoding of binary_serializer::begin_sequence.
+  auto x = static_cast<uint32_t>(list_size);
+  while (x > 0x7f) {
+    ++result_;
+    x >>= 7;
+  }
+  ++result_;
+  return true;
+}
+
+bool serialized_size_inspector::end_sequence() {
+  return true;
+}
+
+bool serialized_size_inspector::begin_associative_array(size_t size) {
+  return begin_sequence(size);
+}
+
+bool serialized_size_inspector::end_associative_array() {
+  return end_sequence();
+}
+
+bool serialized_size_inspector::value(std::byte) {
+  result_ += sizeof(std::byte);
+  return true;
+}
+
+bool serialized_size_inspector::value(bool) {
+  result_ += sizeof(uint8_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(int8_t) {
+  result_ += sizeof(int8_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(uint8_t) {
+  result_ += sizeof(uint8_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(int16_t) {
+  result_ += sizeof(int16_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(uint16_t) {
+  result_ += sizeof(uint16_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(int32_t) {
+  result_ += sizeof(int32_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(uint32_t) {
+  result_ += sizeof(uint32_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(int64_t) {
+  result_ += sizeof(int64_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(uint64_t) {
+  result_ += sizeof(uint64_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(float) {
+  result_ += sizeof(uint32_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(double) {
+  result_ += sizeof(uint64_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(long double x) {
+  // The binary serializer falls back to a string representation for this type.
+  std::ostringstream oss;
+  oss << std::setprecision(std::numeric_limits<long double>::digits) << x;
+  auto tmp = oss.str();
+  return value(std::string_view{tmp});
+}
+
+bool serialized_size_inspector::value(std::string_view x) {
+  begin_sequence(x.size());
+  result_ += x.size();
+  return true;
+}
+
+bool serialized_size_inspector::value(const std::u16string& x) {
+  begin_sequence(x.size());
+  result_ += x.size() * sizeof(uint16_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(const std::u32string& x) {
+  begin_sequence(x.size());
+  result_ += x.size() * sizeof(uint32_t);
+  return true;
+}
+
+bool serialized_size_inspector::value(const_byte_span x) {
+  result_ += x.size();
+  return true;
+}
+
+bool serialized_size_inspector::value(const strong_actor_ptr& ptr) {
+  auto nid = ptr != nullptr ? ptr->node() : node_id{};
+  result_ += sizeof(actor_id);
+  return inspect(*this, nid);
+}
+
+bool serialized_size_inspector::list(const std::vector<bool>& xs) {
+  // Inspecting a vector of booleans writes one byte per element.
+  begin_sequence(xs.size());
+  result_ += xs.size();
+  return true;
+}
+
+} // namespace caf::detail
@@ -0,0 +1,157 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+#include "caf/fwd.hpp"
+#include "caf/serializer.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace caf::detail {
+
+/// Computes how many bytes a @ref binary_serializer produces for a sequence of
+/// objects without writing any of them. Allows callers to allocate a buffer of
+/// the exact size before serializing.
+class CAF_CORE_EXPORT serialized_size_inspector final : public serializer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = serializer;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit serialized_size_inspector(actor_system* sys = nullptr) noexcept
+    : sys_(sys) {
+    // nop
+  }
+
+  ~serialized_size_inspector() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of bytes for all objects inspected so far.
+  size_t result() const noexcept {
+    return result_;
+  }
+
+  actor_system* sys() const noexcept override;
+
+  bool has_human_readable_format() const noexcept override;
+
+  // -- overrides --------------------------------------------------------------
+
+  void set_error(error stop_reason) override;
+
+  error& get_error() noexcept override;
+
+  bool begin_object(type_id_t type, std::string_view name) override;
+
+  bool end_object() override;
+
+  bool begin_field(std::string_view) override;
+
+  bool begin_field(std::string_view name, bool is_present) override;
+
+  bool begin_field(std::string_view name, std::span<const type_id_t> types,
+                   size_t index) override;
+
+  bool begin_field(std::string_view name, bool is_present,
+                   std::span<const type_id_t> types, size_t index) override;
+
+  bool end_field() override;
+
+  bool begin_tuple(size_t size) override;
+
+  bool end_tuple() override;
+
+  bool begin_key_value_pair() override;
+
+  bool end_key_value_pair() override;
+
+  bool begin_sequence(size_t size) override;
+
+  bool end_sequence() override;
+
+  bool begin_associative_array(size_t size) override;
+
+  bool end_associative_array() override;
+
+  bool value(std::byte x) override;
+
+  bool value(bool x) override;
+
+  bool value(int8_t x) override;
+
+  bool value(uint8_t x) override;
+
+  bool value(int16_t x) override;
+
+  bool value(uint16_t x) override;
+
+  bool value(int32_t x) override;
+
+  bool value(uint32_t x) override;
+
+  bool value(int64_t x) override;
+
+  bool value(uint64_t x) override;
+
+  using super::value;
+
+  bool value(float x) override;
+
+  bool value(double x) override;
+
+  bool value(long double x) override;
+
+  bool value(std::string_view x) override;
+
+  bool value(const std::u16string& x) override;
+
+  bool value(const std::u32string& x) override;
+
+  bool value(const_byte_span x) override;
+
+  /// Counts the bytes for `ptr` without registering the actor at the actor
+  /// registry, because computing the size must not have any side effects.
+  bool value(const strong_actor_ptr& ptr) override;
+
+  using super::list;
+
+  bool list(const std::vector<bool>& xs) override;
+
+private:
+  size_t result_ = 0;
+
+  actor_system* sys_;
+
+  error err_;
+};
+
+/// Returns the number of bytes that a @ref binary_serializer produces for
+/// `xs`. The result is only a hint if the inspection fails, e.g., because one
+/// of the objects has an `inspect` overload that may fail.
+template <class T, class... Ts>
+  requires(!std::derived_from<T, actor_system>)
+size_t serialized_size(const T& x, const Ts&... xs) {
+  serialized_size_inspector f;
+  static_cast<void>(f.apply(x) && (f.apply(xs) && ...));
+  return f.result();
+}
+
+/// @copydoc serialized_size
+template <class... Ts>
+size_t serialized_size(actor_system& sys, const Ts&... xs) {
+  serialized_size_inspector f{&sys};
+  static_cast<void>((f.apply(xs) && ...));
+  return f.result();
+}
+
+} // namespace caf::detail
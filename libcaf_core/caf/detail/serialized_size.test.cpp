@@ -0,0 +1,100 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/serialized_size.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/exit_reason.hpp"
+#include "caf/message.hpp"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+using caf::detail::serialized_size;
+
+namespace {
+
+// Returns the number of bytes that a binary serializer writes for `xs`.
+template <class... Ts>
+size_t binary_size(const Ts&... xs) {
+  byte_buffer buf;
+  binary_serializer sink{buf};
+  if (!(sink.apply(xs) && ...))
+    return 0;
+  return buf.size();
+}
+
+} // namespace
+
+TEST("the serialized size of builtin types matches the binary format") {
+  check_eq(serialized_size(int8_t{1}), binary_size(int8_t{1}));
+  check_eq(serialized_size(int64_t{1}), binary_size(int64_t{1}));
+  check_eq(serialized_size(true), binary_size(true));
+  check_eq(serialized_size(3.14f), binary_size(3.14f));
+  check_eq(serialized_size(3.14), binary_size(3.14));
+  check_eq(serialized_size(3.14L), binary_size(3.14L));
+  check_eq(serialized_size(""s), binary_size(""s));
+  check_eq(serialized_size("hello world"s), binary_size("hello world"s));
+  check_eq(serialized_size(u"hello"s), binary_size(u"hello"s));
+  check_eq(serialized_size(U"hello"s), binary_size(U"hello"s));
+  check_eq(serialized_size(1, "two"s, 3.0), binary_size(1, "two"s, 3.0));
+}
+
+TEST("the serialized size of sequences includes the size prefix") {
+  for (auto n : {size_t{0}, size_t{127}, size_t{128}, size_t{20'000}}) {
+    auto xs = std::vector<int32_t>(n);
+    check_eq(serialized_size(xs), binary_size(xs));
+    auto str = std::string(n, 'x');
+    check_eq(serialized_size(str), binary_size(str));
+    auto bits = std::vector<bool>(n + 3);
+    check_eq(serialized_size(bits), binary_size(bits));
+  }
+  auto nested = std::vector<std::vector<std::string>>{{"a", "bc"}, {}, {"d"}};
+  check_eq(serialized_size(nested), binary_size(nested));
+  auto dict = std::map<std::string, int>{{"one", 1}, {"two", 2}};
+  check_eq(serialized_size(dict), binary_size(dict));
+}
+
+TEST("the serialized size of optional values and variants") {
+  auto none = std::optional<int32_t>{};
+  check_eq(serialized_size(none), binary_size(none));
+  auto some = std::optional<int32_t>{42};
+  check_eq(serialized_size(some), binary_size(some));
+  auto var = std::variant<int32_t, std::string>{"hello"s};
+  check_eq(serialized_size(var), binary_size(var));
+}
+
+TEST("the serialized size of messages") {
+  check_eq(serialized_size(message{}), binary_size(message{}));
+  auto msg = make_message(1, "two"s, 3.0, std::vector<config_value>{});
+  check_eq(serialized_size(msg), binary_size(msg));
+}
+
+WITH_FIXTURE(test::fixture::deterministic) {
+
+TEST("the serialized size of actor handles") {
+  auto hdl = sys.spawn([] { return behavior{[](int) {}}; });
+  auto msg = make_message(hdl);
+  byte_buffer buf;
+  binary_serializer sink{sys, buf};
+  require(sink.apply(msg));
+  check_eq(detail::serialized_size(sys, msg), buf.size());
+  check_eq(serialized_size(actor{}), binary_size(actor{}));
+  anon_send_exit(hdl, exit_reason::user_shutdown);
+  dispatch_messages();
+}
+
+} // WITH_FIXTURE(test::fixture::deterministic)
@@ -0,0 +1,103 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/spill_file.hpp"
+
+#include "caf/config.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#ifndef CAF_WINDOWS
+#  include <sys/types.h>
+#endif
+
+namespace caf::detail {
+
+namespace {
+
+// Unlike fseek, these functions accept offsets beyond 2 GB on platforms with
+// a 32-bit long.
+int seek(FILE* file, size_t pos) {
+#ifdef CAF_WINDOWS
+  return _fseeki64(file, static_cast<__int64>(pos), SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(pos), SEEK_SET);
+#endif
+}
+
+} // namespace
+
+spill_file::spill_file(std::string path) : path_(std::move(path)) {
+  // nop
+}
+
+spill_file::~spill_file() {
+  if (file_ != nullptr) {
+    fclose(file_);
+    std::remove(path_.c_str());
+  }
+}
+
+error spill_file::append(const_byte_span bytes) {
+  if (bytes.size() > std::numeric_limits<uint32_t>::max())
+    return make_error(sec::invalid_argument, "record too large");
+  if (file_ == nullptr) {
+    file_ = fopen(path_.c_str(), "w+b");
+    if (file_ == nullptr)
+      return make_error(sec::cannot_open_file);
+  }
+  // Once all records have been read, we start over at the beginning of the
+  // file to keep it small.
+  if (size_ == 0)
+    read_pos_ = write_pos_ = 0;
+  auto len = static_cast<uint32_t>(bytes.size());
+  if (seek(file_, write_pos_) != 0
+      || fwrite(&len, 1, prefix_size, file_) != prefix_size
+      || fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size())
+    return make_error(sec::runtime_error, "failed to write to spill file");
+  write_pos_ += prefix_size + bytes.size();
+  ++size_;
+  return {};
+}
+
+error spill_file::read(byte_buffer& buf) {
+  CAF_ASSERT(!empty());
+  uint32_t len = 0;
+  if (seek(file_, read_pos_) != 0
+      || fread(&len, 1, prefix_size, file_) != prefix_size)
+    return make_error(sec::runtime_error, "failed to read from spill file");
+  buf.resize(len);
+  if (fread(buf.data(), 1, len, file_) != len)
+    return make_error(sec::runtime_error, "failed to read from spill file");
+  read_pos_ += prefix_size + len;
+  --size_;
+  return {};
+}
+
+error spill_file::compact() {
+  if (read_pos_ == 0)
+    return {};
+  // Copy the unread records chunk by chunk. The destination range always ends
+  // before the source range begins, so we never overwrite unread bytes.
+  std::byte chunk[4096];
+  auto src = read_pos_;
+  auto dst = size_t{0};
+  while (src < write_pos_) {
+    auto n = std::min(sizeof(chunk), write_pos_ - src);
+    if (seek(file_, src) != 0 || fread(chunk, 1, n, file_) != n
+        || seek(file_, dst) != 0 || fwrite(chunk, 1, n, file_) != n)
+      return make_error(sec::runtime_error, "failed to compact spill file");
+    src += n;
+    dst += n;
+  }
+  read_pos_ = 0;
+  write_pos_ = dst;
+  return {};
+}
+
+} // namespace caf::detail
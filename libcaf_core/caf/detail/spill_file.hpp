@@ -0,0 +1,84 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace caf::detail {
+
+/// An append-only segment file that stores length-prefixed records and reads
+/// them back in FIFO order. Creates the file on the first write and removes it
+/// on destruction.
+class CAF_CORE_EXPORT spill_file {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Size of the length prefix for each record. We store the prefix in native
+  /// byte order, because the file never leaves the host.
+  static constexpr size_t prefix_size = sizeof(uint32_t);
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit spill_file(std::string path);
+
+  spill_file(const spill_file&) = delete;
+
+  spill_file& operator=(const spill_file&) = delete;
+
+  ~spill_file();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of records that wait for reading.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Checks whether all records have been read.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the number of bytes in the file that belong to unread records.
+  size_t pending_bytes() const noexcept {
+    return write_pos_ - read_pos_;
+  }
+
+  /// Returns the number of bytes in the file, including the space of records
+  /// that have already been read.
+  size_t file_size() const noexcept {
+    return write_pos_;
+  }
+
+  // -- I/O --------------------------------------------------------------------
+
+  /// Appends a record to the end of the file.
+  error append(const_byte_span bytes);
+
+  /// Reads the next record into `buf`.
+  /// @pre `!empty()`
+  error read(byte_buffer& buf);
+
+  /// Moves all unread records to the beginning of the file to reclaim the
+  /// space of records that have already been read.
+  error compact();
+
+private:
+  std::string path_;
+  FILE* file_ = nullptr;
+  size_t read_pos_ = 0;
+  size_t write_pos_ = 0;
+  size_t size_ = 0;
+};
+
+} // namespace caf::detail
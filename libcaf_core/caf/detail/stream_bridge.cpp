@@ -11,18 +11,6 @@
 
 namespace caf::detail {
 
-namespace {
-
-/// Configures how many (full) batches the bridge must be able to cache at the
-/// very least.
-constexpr size_t min_batch_buffering = 5;
-
-/// Configures how many batches we request in one go. This is to avoid sending
-/// one demand message for each batch we receive.
-constexpr size_t min_batch_request_threshold = 3;
-
-} // namespace
-
 void stream_bridge_sub::ack(uint64_t src_flow_id,
                             uint32_t max_items_per_batch) {
   auto lg = log::core::trace("src_flow_id = {}, max_items_per_batch = {}",
@@ -35,12 +23,11 @@ void stream_bridge_sub::ack(uint64_t src_flow_id,
   }
   // Update our state. Streams operate on batches, so we translate the
   // user-defined bounds on per-item level to a rough equivalent on batches.
-  // Batches may be "under-full", so this isn't perfect in practice.
+  // The controller refines this estimate later based on the actual batch size,
+  // the size of the elements and the processing rate of the consumer.
   src_flow_id_ = src_flow_id;
-  max_in_flight_batches_ = std::max(min_batch_buffering,
-                                    max_in_flight_ / max_items_per_batch);
-  low_batches_threshold_ = std::max(min_batch_request_threshold,
-                                    request_threshold_ / max_items_per_batch);
+  credit_.init(max_items_per_batch, self_->steady_time());
+  on_calibrated();
   // Go get some data.
   in_flight_batches_ = max_in_flight_batches_;
   unsafe_send_as(self_, src_,
@@ -82,10 +69,12 @@ void stream_bridge_sub::push(const async::batch& input) {
   }
   // Push batch downstream or buffer it.
   --in_flight_batches_;
+  if (credit_.on_batch(input, buf_.size(), self_->steady_time()))
+    on_calibrated();
   if (demand_ > 0) {
     CAF_ASSERT(buf_.empty());
     --demand_;
-    out_.on_next(input);
+    deliver(input);
     do_check_credit();
   } else {
     buf_.push_back(input);
@@ -96,7 +85,7 @@ void stream_bridge_sub::push() {
   auto lg = log::core::trace("");
   while (!buf_.empty() && demand_ > 0) {
     --demand_;
-    out_.on_next(buf_.front());
+    deliver(buf_.front());
     buf_.pop_front();
   }
   do_check_credit();
@@ -142,7 +131,11 @@ void stream_bridge_sub::do_abort(const error& reason) {
 }
 
 void stream_bridge_sub::do_check_credit() {
-  auto capacity = max_in_flight_batches_ - in_flight_batches_ - buf_.size();
+  // Note: the controller may lower the credit while batches are in flight.
+  auto used = in_flight_batches_ + buf_.size();
+  if (used >= max_in_flight_batches_)
+    return;
+  auto capacity = max_in_flight_batches_ - used;
   if (capacity >= low_batches_threshold_) {
     in_flight_batches_ += capacity;
     unsafe_send_as(self_, src_,
@@ -151,14 +144,31 @@ void stream_bridge_sub::do_check_credit() {
   }
 }
 
+void stream_bridge_sub::on_calibrated() {
+  max_in_flight_batches_ = credit_.max_in_flight_batches();
+  low_batches_threshold_ = credit_.request_threshold();
+  if (metrics_.batch_size != nullptr) {
+    metrics_.batch_size->value(static_cast<int64_t>(credit_.batch_size()));
+    metrics_.max_in_flight_batches->value(
+      static_cast<int64_t>(max_in_flight_batches_));
+  }
+}
+
+void stream_bridge_sub::deliver(const async::batch& input) {
+  credit_.on_consumed(input.size());
+  out_.on_next(input);
+}
+
 stream_bridge::stream_bridge(scheduled_actor* self, strong_actor_ptr src,
                              uint64_t stream_id, size_t buf_capacity,
-                             size_t request_threshold)
+                             size_t request_threshold,
+                             stream_bridge_metrics metrics)
   : super(self),
     src_(std::move(src)),
     stream_id_(stream_id),
     buf_capacity_(buf_capacity),
-    request_threshold_(request_threshold) {
+    request_threshold_(request_threshold),
+    metrics_(metrics) {
   // nop
 }
 
@@ -172,7 +182,7 @@ disposable stream_bridge::subscribe(flow::observer<async::batch> out) {
                  stream_open_msg{stream_id_, self->ctrl(), local_id});
   auto sub = make_counted<stream_bridge_sub>(self, std::move(src_), out,
                                              local_id, buf_capacity_,
-                                             request_threshold_);
+                                             request_threshold_, metrics_);
   self->register_flow_state(local_id, sub);
   out.on_subscribe(flow::subscription{sub});
   return sub->as_disposable();
@@ -5,9 +5,11 @@
 #pragma once
 
 #include "caf/actor_control_block.hpp"
+#include "caf/detail/stream_credit_controller.hpp"
 #include "caf/flow/observer.hpp"
 #include "caf/flow/op/hot.hpp"
 #include "caf/flow/subscription.hpp"
+#include "caf/telemetry/gauge.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -15,17 +17,27 @@
 
 namespace caf::detail {
 
+/// Optional metrics for reporting the credit of a stream bridge.
+struct stream_bridge_metrics {
+  /// Tracks the average number of items per batch from upstream.
+  telemetry::int_gauge* batch_size = nullptr;
+
+  /// Tracks how many batches the bridge allows in flight.
+  telemetry::int_gauge* max_in_flight_batches = nullptr;
+};
+
 class stream_bridge_sub : public flow::subscription::impl_base {
 public:
   stream_bridge_sub(scheduled_actor* self, strong_actor_ptr src,
                     flow::observer<async::batch> out, uint64_t snk_flow_id,
-                    size_t max_in_flight, size_t request_threshold)
+                    size_t max_in_flight, size_t request_threshold,
+                    stream_bridge_metrics metrics = {})
     : self_(self),
       src_(std::move(src)),
       out_(std::move(out)),
       snk_flow_id_(snk_flow_id),
-      max_in_flight_(max_in_flight),
-      request_threshold_(request_threshold) {
+      credit_(max_in_flight, request_threshold),
+      metrics_(metrics) {
     // nop
   }
 
@@ -60,6 +72,10 @@ private:
 
   void do_check_credit();
 
+  void on_calibrated();
+
+  void deliver(const async::batch& input);
+
   scheduled_actor* self_;
   strong_actor_ptr src_;
 
@@ -75,8 +91,8 @@ private:
   size_t demand_ = 0;
   std::deque<async::batch> buf_;
 
-  size_t max_in_flight_;
-  size_t request_threshold_;
+  stream_credit_controller credit_;
+  stream_bridge_metrics metrics_;
 };
 
 using stream_bridge_sub_ptr = intrusive_ptr<stream_bridge_sub>;
@@ -87,7 +103,8 @@ public:
 
   explicit stream_bridge(scheduled_actor* self, strong_actor_ptr src,
                          uint64_t stream_id, size_t buf_capacity,
-                         size_t request_threshold);
+                         size_t request_threshold,
+                         stream_bridge_metrics metrics = {});
 
   disposable subscribe(flow::observer<async::batch> out) override;
 
@@ -98,6 +115,7 @@ private:
   uint64_t stream_id_;
   size_t buf_capacity_;
   size_t request_threshold_;
+  stream_bridge_metrics metrics_;
 };
 
 } // namespace caf::detail
@@ -0,0 +1,112 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/stream_credit_controller.hpp"
+
+#include "caf/async/batch.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/defaults.hpp"
+#include "caf/log/core.hpp"
+
+#include <algorithm>
+
+namespace caf::detail {
+
+namespace {
+
+namespace sp = defaults::stream::size_policy;
+
+/// Folds a new observation into a moving average.
+void smooth(double& avg, double value) {
+  if (avg == 0)
+    avg = value;
+  else
+    avg = sp::smoothing_factor * value + (1 - sp::smoothing_factor) * avg;
+}
+
+} // namespace
+
+stream_credit_controller::stream_credit_controller(size_t max_in_flight,
+                                                   size_t request_threshold)
+  : max_in_flight_(max_in_flight), request_threshold_(request_threshold) {
+  // nop
+}
+
+void stream_credit_controller::init(uint32_t max_items_per_batch,
+                                    time_point now) {
+  max_items_per_batch_ = max_items_per_batch;
+  avg_batch_size_ = max_items_per_batch;
+  last_calibration_ = now;
+  update_credit();
+}
+
+bool stream_credit_controller::on_batch(const async::batch& input,
+                                        size_t buffered_batches,
+                                        time_point now) {
+  // Tracking the batch size is cheap, so we do it for every batch.
+  smooth(avg_batch_size_, static_cast<double>(input.size()));
+  if (batches_until_sample_-- > 0)
+    return false;
+  batches_until_sample_ = sp::sampling_rate - 1;
+  sample(input);
+  if (samples_until_calibration_-- > 0)
+    return false;
+  samples_until_calibration_ = sp::calibration_interval - 1;
+  calibrate(buffered_batches, now);
+  return true;
+}
+
+void stream_credit_controller::sample(const async::batch& input) {
+  if (input.size() == 0)
+    return;
+  sample_buf_.clear();
+  binary_serializer sink{sample_buf_};
+  if (!input.save(sink)) {
+    log::core::debug("failed to serialize a batch for sampling: {}",
+                     sink.get_error());
+    return;
+  }
+  smooth(bytes_per_item_, static_cast<double>(sample_buf_.size())
+                            / static_cast<double>(input.size()));
+}
+
+void stream_credit_controller::calibrate(size_t buffered_batches,
+                                         time_point now) {
+  // The number of items the consumer receives only reflects its processing
+  // rate if it falls behind. Otherwise, the rate merely reflects how fast the
+  // source produces items.
+  auto elapsed = std::chrono::duration<double>{now - last_calibration_};
+  if (buffered_batches == 0)
+    consumer_rate_ = 0;
+  else if (elapsed.count() > 0 && consumed_items_ > 0)
+    smooth(consumer_rate_, static_cast<double>(consumed_items_)
+                             / elapsed.count());
+  consumed_items_ = 0;
+  last_calibration_ = now;
+  update_credit();
+}
+
+void stream_credit_controller::update_credit() {
+  auto max_items = static_cast<double>(max_in_flight_);
+  if (bytes_per_item_ > 0)
+    max_items = std::min(max_items, sp::buffer_capacity / bytes_per_item_);
+  if (consumer_rate_ > 0) {
+    auto latency = std::chrono::duration<double>{sp::target_latency};
+    max_items = std::min(max_items, consumer_rate_ * latency.count());
+  }
+  // Batches may be "under-full", so we use the observed batch size rather than
+  // the maximum as announced by the source.
+  auto items_per_batch = std::max(avg_batch_size_, 1.0);
+  max_in_flight_batches_
+    = std::max(min_batch_buffering,
+               static_cast<size_t>(max_items / items_per_batch));
+  request_threshold_batches_
+    = std::clamp(static_cast<size_t>(request_threshold_ / items_per_batch),
+                 min_batch_request_threshold, max_in_flight_batches_);
+  log::core::debug("calibrated stream credit: batch-size = {}, "
+                   "bytes-per-item = {}, max-in-flight-batches = {}",
+                   batch_size(), bytes_per_item(), max_in_flight_batches_);
+}
+
+} // namespace caf::detail
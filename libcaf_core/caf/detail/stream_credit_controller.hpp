@@ -0,0 +1,140 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/async/fwd.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/timespan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf::detail {
+
+/// Computes how many batches an inbound stream may have in flight. The
+/// controller implements the size-based credit policy: it periodically samples
+/// the serialized size of incoming elements, tracks how full batches from the
+/// source actually are and measures how fast the consumer processes elements
+/// while it falls behind. Based on these observations, it translates the
+/// item-based bounds of the user into a batch-based credit.
+class CAF_CORE_EXPORT stream_credit_controller {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using time_point = std::chrono::steady_clock::time_point;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Configures how many (full) batches the bridge must be able to cache at the
+  /// very least.
+  static constexpr size_t min_batch_buffering = 5;
+
+  /// Configures how many batches we request in one go. This is to avoid
+  /// sending one demand message for each batch we receive.
+  static constexpr size_t min_batch_request_threshold = 3;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// @param max_in_flight Maximum number of items the sink may buffer.
+  /// @param request_threshold Minimum number of items for a new demand.
+  stream_credit_controller(size_t max_in_flight, size_t request_threshold);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the maximum number of batches that may be in flight.
+  size_t max_in_flight_batches() const noexcept {
+    return max_in_flight_batches_;
+  }
+
+  /// Returns the minimum number of batches for sending a new demand.
+  size_t request_threshold() const noexcept {
+    return request_threshold_batches_;
+  }
+
+  /// Returns the average number of items per batch.
+  size_t batch_size() const noexcept {
+    return static_cast<size_t>(avg_batch_size_ + 0.5);
+  }
+
+  /// Returns the estimated number of Bytes per item or 0 if unknown.
+  size_t bytes_per_item() const noexcept {
+    return static_cast<size_t>(bytes_per_item_ + 0.5);
+  }
+
+  /// Returns the measured processing rate of the consumer in items per second
+  /// or 0 if the consumer did not fall behind yet.
+  double consumer_rate() const noexcept {
+    return consumer_rate_;
+  }
+
+  // -- callbacks --------------------------------------------------------------
+
+  /// Initializes the controller after receiving the handshake from the source.
+  void init(uint32_t max_items_per_batch, time_point now);
+
+  /// Updates the statistics after receiving a batch from the source.
+  /// @param input The received batch.
+  /// @param buffered_batches Number of batches waiting for downstream demand.
+  /// @param now The current time.
+  /// @returns `true` if the controller re-calibrated its credit, `false`
+  ///          otherwise.
+  bool on_batch(const async::batch& input, size_t buffered_batches,
+                time_point now);
+
+  /// Updates the statistics after the consumer received some items.
+  void on_consumed(size_t num_items) noexcept {
+    consumed_items_ += num_items;
+  }
+
+private:
+  void sample(const async::batch& input);
+
+  void calibrate(size_t buffered_batches, time_point now);
+
+  void update_credit();
+
+  /// Maximum number of items the sink may buffer.
+  size_t max_in_flight_;
+
+  /// Minimum number of items for a new demand.
+  size_t request_threshold_;
+
+  /// Upper bound for the batch size as announced by the source.
+  size_t max_items_per_batch_ = 0;
+
+  /// Current credit bound in batches.
+  size_t max_in_flight_batches_ = 0;
+
+  /// Current request threshold in batches.
+  size_t request_threshold_batches_ = 0;
+
+  /// Moving average of the number of items per batch.
+  double avg_batch_size_ = 0;
+
+  /// Moving average of the serialized size per item.
+  double bytes_per_item_ = 0;
+
+  /// Moving average of the consumer rate in items per second.
+  double consumer_rate_ = 0;
+
+  /// Number of batches until sampling the next one.
+  int32_t batches_until_sample_ = 0;
+
+  /// Number of samples until re-calibrating the credit.
+  int32_t samples_until_calibration_ = 0;
+
+  /// Number of items the consumer received since the last calibration.
+  size_t consumed_items_ = 0;
+
+  /// Time of the last calibration.
+  time_point last_calibration_;
+
+  /// Scratch space for serializing sampled batches.
+  byte_buffer sample_buf_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,102 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/stream_credit_controller.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/async/batch.hpp"
+#include "caf/defaults.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using time_point = detail::stream_credit_controller::time_point;
+
+// Number of batches between two calibrations of the controller.
+constexpr auto calibration_period
+  = defaults::stream::size_policy::sampling_rate
+    * defaults::stream::size_policy::calibration_interval;
+
+auto make_int_batch(size_t size) {
+  return async::make_batch(std::vector<int32_t>(size, 42));
+}
+
+} // namespace
+
+TEST("the controller translates the item-based bounds to batches") {
+  auto uut = detail::stream_credit_controller{100, 30};
+  uut.init(10, time_point{});
+  check_eq(uut.batch_size(), 10u);
+  check_eq(uut.max_in_flight_batches(), 10u);
+  check_eq(uut.request_threshold(), 3u);
+  SECTION("the controller never goes below the minimum bounds") {
+    auto small = detail::stream_credit_controller{10, 0};
+    small.init(10, time_point{});
+    check_eq(small.max_in_flight_batches(), 5u);
+    check_eq(small.request_threshold(), 3u);
+  }
+}
+
+TEST("the controller adjusts the credit to under-full batches") {
+  auto uut = detail::stream_credit_controller{101, 31};
+  uut.init(10, time_point{});
+  check_eq(uut.max_in_flight_batches(), 10u);
+  auto input = make_int_batch(2);
+  // The first batch triggers a calibration, then the controller waits for the
+  // next calibration period.
+  check(uut.on_batch(input, 0, time_point{}));
+  for (int i = 1; i < calibration_period; ++i)
+    check(!uut.on_batch(input, 0, time_point{}));
+  check(uut.on_batch(input, 0, time_point{}));
+  check_eq(uut.batch_size(), 2u);
+  check_eq(uut.max_in_flight_batches(), 50u);
+  check_eq(uut.request_threshold(), 15u);
+}
+
+TEST("the controller limits the credit by the size of the elements") {
+  auto uut = detail::stream_credit_controller{1000, 100};
+  uut.init(10, time_point{});
+  check_eq(uut.max_in_flight_batches(), 100u);
+  // Each element occupies roughly 1 KB on the wire and the controller allows
+  // up to 64 KB in flight.
+  auto item = std::string(1000, 'x');
+  auto input = async::make_batch(std::vector<std::string>(10, item));
+  check(uut.on_batch(input, 0, time_point{}));
+  check_ge(uut.bytes_per_item(), 1000u);
+  check_le(uut.bytes_per_item(), 1010u);
+  check_eq(uut.max_in_flight_batches(), 6u);
+  check_eq(uut.request_threshold(), 6u);
+}
+
+TEST("the controller limits the credit by the rate of a slow consumer") {
+  auto t0 = time_point{};
+  auto uut = detail::stream_credit_controller{5000, 0};
+  uut.init(10, t0);
+  auto input = make_int_batch(10);
+  check(uut.on_batch(input, 0, t0));
+  check_eq(uut.max_in_flight_batches(), 500u);
+  check_eq(uut.consumer_rate(), test::approx{0.0});
+  // The consumer processes 1000 items per second while batches pile up.
+  uut.on_consumed(1000);
+  for (int i = 1; i < calibration_period; ++i)
+    check(!uut.on_batch(input, 1, t0));
+  check(uut.on_batch(input, 1, t0 + 1s));
+  check_eq(uut.consumer_rate(), test::approx{1000.0});
+  // The default target latency of 100ms allows 100 items in flight.
+  check_eq(uut.max_in_flight_batches(), 10u);
+  SECTION("the controller drops the limit once the consumer catches up") {
+    for (int i = 1; i < calibration_period; ++i)
+      check(!uut.on_batch(input, 0, t0 + 1s));
+    check(uut.on_batch(input, 0, t0 + 2s));
+    check_eq(uut.consumer_rate(), test::approx{0.0});
+    check_eq(uut.max_in_flight_batches(), 500u);
+  }
+}
@@ -0,0 +1,84 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace caf::detail {
+
+/// Number of stripes in a @ref striped_atomic.
+constexpr size_t striped_atomic_stripes = 8;
+
+/// Returns the stripe for the calling thread. Assigns stripes to threads in
+/// round-robin order on first use.
+inline size_t striped_atomic_index() noexcept {
+  static std::atomic<size_t> next_index;
+  thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed)
+                              % striped_atomic_stripes;
+  return index;
+}
+
+/// An arithmetic value that spreads concurrent updates over multiple atomics,
+/// each on a cache line of its own. Threads only update the stripe assigned to
+/// them and readers compute the sum over all stripes. This avoids contention
+/// for values that many threads update frequently but only few threads read.
+template <class T>
+class striped_atomic {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  striped_atomic() noexcept = default;
+
+  explicit striped_atomic(value_type value) noexcept {
+    stripes_[0].value.store(value, std::memory_order_relaxed);
+  }
+
+  striped_atomic(const striped_atomic&) = delete;
+
+  striped_atomic& operator=(const striped_atomic&) = delete;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `amount` to the stripe of the calling thread.
+  void add(value_type amount) noexcept {
+    auto& value = stripes_[striped_atomic_index()].value;
+    if constexpr (std::is_integral_v<value_type>) {
+      value.fetch_add(amount, std::memory_order_relaxed);
+    } else {
+      auto val = value.load(std::memory_order_relaxed);
+      while (!value.compare_exchange_weak(val, val + amount,
+                                          std::memory_order_relaxed)) {
+        // nop
+      }
+    }
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the sum of all stripes.
+  value_type load() const noexcept {
+    value_type result = 0;
+    for (const auto& stripe : stripes_)
+      result += stripe.value.load(std::memory_order_relaxed);
+    return result;
+  }
+
+private:
+  struct alignas(CAF_CACHE_LINE_SIZE) stripe {
+    std::atomic<value_type> value = 0;
+  };
+
+  stripe stripes_[striped_atomic_stripes];
+};
+
+} // namespace caf::detail
@@ -0,0 +1,68 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/striped_atomic.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/test.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::striped_atomic;
+
+namespace {
+
+// Lets `num_threads` threads add 1 to `uut` `num_updates` times each.
+template <class T>
+void add_concurrently(striped_atomic<T>& uut, size_t num_threads,
+                      size_t num_updates) {
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.emplace_back([&uut, num_updates] {
+      for (size_t j = 0; j < num_updates; ++j)
+        uut.add(1);
+    });
+  for (auto& thread : threads)
+    thread.join();
+}
+
+} // namespace
+
+TEST("striped atomics sum up all stripes") {
+  SECTION("integer values") {
+    auto uut = striped_atomic<int64_t>{42};
+    check_eq(uut.load(), 42);
+    uut.add(8);
+    uut.add(-20);
+    check_eq(uut.load(), 30);
+  }
+  SECTION("floating point values") {
+    auto uut = striped_atomic<double>{};
+    check_eq(uut.load(), test::approx{0.0});
+    uut.add(1.5);
+    uut.add(-0.5);
+    check_eq(uut.load(), test::approx{1.0});
+  }
+}
+
+TEST("stripes are cache lines of their own") {
+  check_ge(sizeof(striped_atomic<int64_t>),
+           detail::striped_atomic_stripes * CAF_CACHE_LINE_SIZE);
+  check_eq(alignof(striped_atomic<int64_t>), size_t{CAF_CACHE_LINE_SIZE});
+}
+
+TEST("threads may update a striped atomic concurrently") {
+  for (size_t num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+    auto ints = striped_atomic<int64_t>{};
+    add_concurrently(ints, num_threads, 1000);
+    check_eq(ints.load(), static_cast<int64_t>(num_threads * 1000));
+    auto dbls = striped_atomic<double>{};
+    add_concurrently(dbls, num_threads, 1000);
+    check_eq(dbls.load(), test::approx{num_threads * 1000.0});
+  }
+}
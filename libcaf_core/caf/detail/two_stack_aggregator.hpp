@@ -0,0 +1,106 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/assert.hpp"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace caf::detail {
+
+/// A FIFO queue that maintains the aggregate of all of its elements under an
+/// associative binary operation. Pushing, popping and querying the aggregate
+/// have amortized O(1) complexity, because the queue never recomputes the
+/// aggregate from scratch. Instead, it keeps two stacks: the back stack
+/// receives new elements and stores their running aggregate, while the front
+/// stack stores the aggregates of all suffixes for the oldest elements. When
+/// popping from an empty front stack, the queue moves all elements from the
+/// back stack to the front stack.
+/// @note `F` must be associative but not necessarily commutative.
+template <class T, class F>
+class two_stack_aggregator {
+public:
+  explicit two_stack_aggregator(F fn) : fn_(std::move(fn)) {
+    // nop
+  }
+
+  /// Returns the number of elements in the queue.
+  size_t size() const noexcept {
+    return front_.size() + back_.size();
+  }
+
+  /// Returns whether the queue has no elements.
+  bool empty() const noexcept {
+    return front_.empty() && back_.empty();
+  }
+
+  /// Appends a new element to the queue.
+  void push(const T& item) {
+    if (back_agg_)
+      back_agg_ = fn_(std::move(*back_agg_), item);
+    else
+      back_agg_ = item;
+    back_.push_back(item);
+  }
+
+  /// Removes the oldest element from the queue.
+  /// @pre `!empty()`
+  void pop() {
+    CAF_ASSERT(!empty());
+    if (front_.empty())
+      flip();
+    front_.pop_back();
+  }
+
+  /// Removes all elements from the queue.
+  void clear() {
+    front_.clear();
+    back_.clear();
+    back_agg_.reset();
+  }
+
+  /// Returns the aggregate of all elements in the queue.
+  /// @pre `!empty()`
+  T value() const {
+    CAF_ASSERT(!empty());
+    if (front_.empty())
+      return *back_agg_;
+    if (!back_agg_)
+      return front_.back();
+    return fn_(front_.back(), *back_agg_);
+  }
+
+private:
+  void flip() {
+    CAF_ASSERT(front_.empty());
+    front_.reserve(back_.size());
+    // The front stack has the oldest element on top and each entry stores the
+    // aggregate of itself and all newer elements on the front stack.
+    for (auto i = back_.rbegin(); i != back_.rend(); ++i) {
+      if (front_.empty())
+        front_.push_back(std::move(*i));
+      else
+        front_.push_back(fn_(std::move(*i), front_.back()));
+    }
+    back_.clear();
+    back_agg_.reset();
+  }
+
+  /// The associative binary operation.
+  F fn_;
+
+  /// Stores suffix aggregates for the oldest elements.
+  std::vector<T> front_;
+
+  /// Stores the newest elements.
+  std::vector<T> back_;
+
+  /// Stores the aggregate of all elements in `back_`.
+  std::optional<T> back_agg_;
+};
+
+} // namespace caf::detail
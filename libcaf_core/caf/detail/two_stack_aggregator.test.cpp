@@ -0,0 +1,73 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/two_stack_aggregator.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <functional>
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+auto concat = [](const std::string& x, const std::string& y) { return x + y; };
+
+} // namespace
+
+TEST("the aggregate covers all elements in the queue") {
+  auto uut = detail::two_stack_aggregator<int, std::plus<>>{std::plus<>{}};
+  check(uut.empty());
+  uut.push(1);
+  check_eq(uut.value(), 1);
+  uut.push(2);
+  uut.push(3);
+  check_eq(uut.size(), 3u);
+  check_eq(uut.value(), 6);
+  uut.pop();
+  check_eq(uut.value(), 5);
+  uut.push(4);
+  check_eq(uut.value(), 9);
+  uut.pop();
+  uut.pop();
+  check_eq(uut.value(), 4);
+  uut.pop();
+  check(uut.empty());
+}
+
+TEST("the aggregate preserves the order of the elements") {
+  using aggregator_type = detail::two_stack_aggregator<std::string,
+                                                       decltype(concat)>;
+  auto uut = aggregator_type{concat};
+  for (auto str : {"a"s, "b"s, "c"s})
+    uut.push(str);
+  check_eq(uut.value(), "abc");
+  uut.pop();
+  check_eq(uut.value(), "bc");
+  uut.push("d");
+  check_eq(uut.value(), "bcd");
+  uut.pop();
+  uut.push("e");
+  check_eq(uut.value(), "cde");
+  uut.clear();
+  check(uut.empty());
+  uut.push("f");
+  check_eq(uut.value(), "f");
+}
+
+TEST("sliding the window computes the same result as recomputing it") {
+  auto uut = detail::two_stack_aggregator<int, std::plus<>>{std::plus<>{}};
+  for (int i = 1; i <= 100; ++i) {
+    uut.push(i);
+    if (uut.size() > 7)
+      uut.pop();
+    auto first = std::max(1, i - 6);
+    auto expected = 0;
+    for (int j = first; j <= i; ++j)
+      expected += j;
+    check_eq(uut.value(), expected);
+  }
+}
@@ -6,6 +6,7 @@
 
 #include "caf/config.hpp"
 #include "caf/flow/observable_builder.hpp"
+#include "caf/flow/stage_metrics.hpp"
 
 namespace caf::flow {
 
@@ -23,4 +24,13 @@ stream coordinator::to_stream_impl(cow_string,
   return stream{};
 }
 
+bool coordinator::launch_worker_impl(
+  detail::unique_function<void(coordinator*)>) {
+  return false;
+}
+
+stage_metrics coordinator::stage_metrics_impl(std::string_view) {
+  return {};
+}
+
 } // namespace caf::flow
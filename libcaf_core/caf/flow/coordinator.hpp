@@ -9,12 +9,14 @@
 #include "caf/async/fwd.hpp"
 #include "caf/cow_string.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/unique_function.hpp"
 #include "caf/flow/fwd.hpp"
 #include "caf/intrusive_ptr.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/timespan.hpp"
 
 #include <chrono>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -144,6 +146,16 @@ private:
   to_stream_impl(cow_string name,
                  intrusive_ptr<flow::op::base<async::batch>> batch_op,
                  type_id_t item_type, size_t max_items_per_batch);
+
+  /// Runs `init` on a new coordinator that runs concurrently to this one.
+  /// @returns `false` if this coordinator cannot launch workers, `true`
+  ///          otherwise.
+  virtual bool
+  launch_worker_impl(detail::unique_function<void(coordinator*)> init);
+
+  /// Returns the metrics for an instrumented stage of a flow.
+  /// @returns disabled metrics if this coordinator does not collect metrics.
+  virtual stage_metrics stage_metrics_impl(std::string_view name);
 };
 
 /// @relates coordinator
@@ -18,6 +18,8 @@ using coordinated_ptr = intrusive_ptr<coordinated>;
 
 class subscription;
 
+struct stage_metrics;
+
 template <class T>
 class single;
 
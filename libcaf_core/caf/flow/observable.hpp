@@ -26,17 +26,22 @@
 #include "caf/flow/op/fail.hpp"
 #include "caf/flow/op/from_resource.hpp"
 #include "caf/flow/op/from_steps.hpp"
+#include "caf/flow/op/group_by.hpp"
+#include "caf/flow/op/instrument.hpp"
 #include "caf/flow/op/interval.hpp"
 #include "caf/flow/op/merge.hpp"
 #include "caf/flow/op/never.hpp"
 #include "caf/flow/op/on_backpressure_buffer.hpp"
+#include "caf/flow/op/on_backpressure_spill.hpp"
 #include "caf/flow/op/on_error_resume_next.hpp"
+#include "caf/flow/op/parallel.hpp"
 #include "caf/flow/op/prefix_and_tail.hpp"
 #include "caf/flow/op/publish.hpp"
 #include "caf/flow/op/ref_count.hpp"
 #include "caf/flow/op/retry.hpp"
 #include "caf/flow/op/sample.hpp"
 #include "caf/flow/op/throttle_first.hpp"
+#include "caf/flow/op/window.hpp"
 #include "caf/flow/op/zip_with.hpp"
 #include "caf/flow/step/all.hpp"
 #include "caf/flow/subscription.hpp"
@@ -305,6 +310,34 @@ public:
     return add_step(step::scan<Scanner>{std::move(init), std::move(scanner)});
   }
 
+  /// @copydoc observable::window_tumbling
+  template <class F>
+  auto window_tumbling(size_t count, F fn) && {
+    return materialize().window_tumbling(count, std::move(fn));
+  }
+
+  template <class F>
+  auto window_tumbling(timespan period, F fn) && {
+    return materialize().window_tumbling(period, std::move(fn));
+  }
+
+  /// @copydoc observable::window_sliding
+  template <class F>
+  auto window_sliding(size_t count, size_t step, F fn) && {
+    return materialize().window_sliding(count, step, std::move(fn));
+  }
+
+  template <class F>
+  auto window_sliding(timespan length, timespan step, F fn) && {
+    return materialize().window_sliding(length, step, std::move(fn));
+  }
+
+  /// @copydoc observable::window_session
+  template <class F>
+  auto window_session(timespan gap, F fn) && {
+    return materialize().window_session(gap, std::move(fn));
+  }
+
   /// @copydoc observable::retry
   template <class Predicate>
   auto retry(Predicate predicate) && {
@@ -355,6 +388,16 @@ public:
     return add_step(step::do_finally<output_type, F>{std::move(f)});
   }
 
+  template <class F>
+  auto parallel(size_t num_workers, F fn) && {
+    return materialize().parallel(num_workers, std::move(fn));
+  }
+
+  template <class F>
+  auto parallel_ordered(size_t num_workers, F fn) && {
+    return materialize().parallel_ordered(num_workers, std::move(fn));
+  }
+
   /// @copydoc observable::on_backpressure_buffer
   auto on_backpressure_buffer(size_t buffer_size,
                               backpressure_overflow_strategy strategy
@@ -362,6 +405,16 @@ public:
     return materialize().on_backpressure_buffer(buffer_size, strategy);
   }
 
+  /// @copydoc observable::on_backpressure_spill
+  auto on_backpressure_spill(spill_options opts) && {
+    return materialize().on_backpressure_spill(std::move(opts));
+  }
+
+  /// @copydoc observable::instrument
+  auto instrument(std::string_view name) && {
+    return materialize().instrument(name);
+  }
+
   auto on_error_complete() && {
     return add_step(step::on_error_complete<output_type>{});
   }
@@ -465,6 +518,13 @@ public:
     return materialize().head_and_tail();
   }
 
+  /// @copydoc observable::group_by
+  template <class KeyFn>
+  auto group_by(KeyFn key_fn, size_t max_groups = defaults::flow::max_groups,
+                timespan idle_timeout = timespan{0}) && {
+    return materialize().group_by(std::move(key_fn), max_groups, idle_timeout);
+  }
+
   /// @copydoc observable::subscribe
   template <class Out>
   disposable subscribe(Out&& out) && {
@@ -717,6 +777,19 @@ transformation<step::map<F>> observable<T>::map(F f) {
   return transform(step::map(std::move(f)));
 }
 
+template <class T>
+template <class F>
+auto observable<T>::parallel(size_t num_workers, F fn) {
+  return parallel_impl(num_workers, std::move(fn),
+                       op::parallel_order::unordered);
+}
+
+template <class T>
+template <class F>
+auto observable<T>::parallel_ordered(size_t num_workers, F fn) {
+  return parallel_impl(num_workers, std::move(fn), op::parallel_order::ordered);
+}
+
 template <class T>
 transformation<step::on_error_complete<T>> observable<T>::on_error_complete() {
   return transform(step::on_error_complete<T>{});
@@ -731,6 +804,27 @@ observable<T>::on_backpressure_buffer(size_t buffer_size,
                                  strategy);
 }
 
+template <class T>
+observable<T> observable<T>::instrument(std::string_view name) {
+  auto metrics = parent()->stage_metrics_impl(name);
+  if (!metrics.enabled())
+    return *this;
+  using impl_t = op::instrument<T>;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, pimpl_, metrics);
+}
+
+template <class T>
+observable<T> observable<T>::on_backpressure_spill(spill_options opts) {
+  if (opts.buffer_size == 0 || opts.path.empty()) {
+    using impl_t = op::fail<T>;
+    return parent()->add_child_hdl(std::in_place_type<impl_t>,
+                                   make_error(sec::invalid_argument));
+  }
+  using impl_t = op::on_backpressure_spill<T>;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, *this,
+                                 std::move(opts));
+}
+
 template <class T>
 template <class ErrorHandler>
 transformation<step::on_error_return<ErrorHandler>>
@@ -864,6 +958,83 @@ observable<T> observable<T>::throttle_last(timespan period) {
   return sample(period);
 }
 
+template <class T>
+template <class F>
+observable<T> observable<T>::window_tumbling(size_t count, F fn) {
+  auto* pptr = parent();
+  if (count == 0) {
+    auto what = make_error(sec::invalid_argument,
+                           "window_tumbling requires a positive count");
+    return pptr->add_child_hdl(std::in_place_type<op::fail<T>>,
+                               std::move(what));
+  }
+  using policy_t = op::window_tumbling_policy<T, F>;
+  return pptr->add_child_hdl(std::in_place_type<op::window<policy_t>>, *this,
+                             policy_t{count, timespan{0}, std::move(fn)});
+}
+
+template <class T>
+template <class F>
+observable<T> observable<T>::window_tumbling(timespan period, F fn) {
+  auto* pptr = parent();
+  if (period <= timespan::zero()) {
+    auto what = make_error(sec::invalid_argument,
+                           "window_tumbling requires a positive period");
+    return pptr->add_child_hdl(std::in_place_type<op::fail<T>>,
+                               std::move(what));
+  }
+  using policy_t = op::window_tumbling_policy<T, F>;
+  return pptr->add_child_hdl(std::in_place_type<op::window<policy_t>>, *this,
+                             policy_t{0, period, std::move(fn)});
+}
+
+template <class T>
+template <class F>
+observable<T> observable<T>::window_sliding(size_t count, size_t step, F fn) {
+  auto* pptr = parent();
+  if (count == 0 || step == 0) {
+    auto what = make_error(sec::invalid_argument,
+                           "window_sliding requires a positive count and step");
+    return pptr->add_child_hdl(std::in_place_type<op::fail<T>>,
+                               std::move(what));
+  }
+  using policy_t = op::window_sliding_count_policy<T, F>;
+  return pptr->add_child_hdl(std::in_place_type<op::window<policy_t>>, *this,
+                             policy_t{count, step, std::move(fn)});
+}
+
+template <class T>
+template <class F>
+observable<T> observable<T>::window_sliding(timespan length, timespan step,
+                                            F fn) {
+  auto* pptr = parent();
+  if (length <= timespan::zero() || step <= timespan::zero()) {
+    auto what = make_error(
+      sec::invalid_argument,
+      "window_sliding requires a positive length and step");
+    return pptr->add_child_hdl(std::in_place_type<op::fail<T>>,
+                               std::move(what));
+  }
+  using policy_t = op::window_sliding_time_policy<T, F>;
+  return pptr->add_child_hdl(std::in_place_type<op::window<policy_t>>, *this,
+                             policy_t{length, step, std::move(fn)});
+}
+
+template <class T>
+template <class F>
+observable<T> observable<T>::window_session(timespan gap, F fn) {
+  auto* pptr = parent();
+  if (gap <= timespan::zero()) {
+    auto what = make_error(sec::invalid_argument,
+                           "window_session requires a positive gap");
+    return pptr->add_child_hdl(std::in_place_type<op::fail<T>>,
+                               std::move(what));
+  }
+  using policy_t = op::window_session_policy<T, F>;
+  return pptr->add_child_hdl(std::in_place_type<op::window<policy_t>>, *this,
+                             policy_t{gap, std::move(fn)});
+}
+
 template <class T>
 template <class Predicate>
 observable<T> observable<T>::retry(Predicate predicate) {
@@ -908,6 +1079,48 @@ auto observable<T>::merge_with_concurrency(size_t max_concurrent,
   }
 }
 
+template <class T>
+template <class F>
+auto observable<T>::parallel_impl(size_t num_workers, F fn,
+                                  op::parallel_order order) {
+  using output_type = std::decay_t<std::invoke_result_t<F&, const T&>>;
+  auto* pptr = parent();
+  if (num_workers == 0) {
+    auto what = make_error(sec::invalid_argument,
+                           "parallel operators require at least one worker");
+    return observable<output_type>{
+      pptr->add_child_hdl(std::in_place_type<op::fail<output_type>>,
+                          std::move(what))};
+  }
+  auto inputs = std::vector<async::producer_resource<T>>{};
+  auto outputs = std::vector<async::consumer_resource<output_type>>{};
+  inputs.reserve(num_workers);
+  outputs.reserve(num_workers);
+  for (size_t index = 0; index < num_workers; ++index) {
+    auto [in_pull, in_push] = async::make_spsc_buffer_resource<T>();
+    auto [out_pull, out_push] = async::make_spsc_buffer_resource<output_type>();
+    auto init = [in = std::move(in_pull), out = std::move(out_push),
+                 fn](coordinator* ctx) mutable {
+      using impl_t = op::from_resource<T>;
+      ctx->add_child_hdl(std::in_place_type<impl_t>, std::move(in))
+        .map(std::move(fn))
+        .subscribe(std::move(out));
+    };
+    using init_fn = detail::unique_function<void(coordinator*)>;
+    if (!pptr->launch_worker_impl(init_fn{std::move(init)})) {
+      // The coordinator cannot run anything concurrently. Hence, we fall back
+      // to applying `fn` locally.
+      return map(std::move(fn)).as_observable();
+    }
+    inputs.emplace_back(std::move(in_push));
+    outputs.emplace_back(std::move(out_pull));
+  }
+  using impl_t = op::parallel<T, output_type>;
+  return pptr->add_child_hdl(std::in_place_type<impl_t>, *this, order,
+                             defaults::flow::buffer_size, std::move(inputs),
+                             std::move(outputs));
+}
+
 template <class T>
 template <class F, size_t... Indexes, class... Ts>
 auto observable<T>::combine_latest_impl(
@@ -1080,6 +1293,25 @@ observable<cow_tuple<T, observable<T>>> observable<T>::head_and_tail() {
     .as_observable();
 }
 
+template <class T>
+template <class KeyFn>
+auto observable<T>::group_by(KeyFn key_fn, size_t max_groups,
+                             timespan idle_timeout) {
+  using key_type = std::decay_t<std::invoke_result_t<KeyFn&, const T&>>;
+  using impl_t = op::group_by<key_type, T, KeyFn>;
+  using tuple_t = typename impl_t::tuple_t;
+  auto* pptr = parent();
+  if (max_groups == 0) {
+    auto what = make_error(sec::invalid_argument,
+                           "group_by requires a positive group limit");
+    return observable<tuple_t>{
+      pptr->add_child_hdl(std::in_place_type<op::fail<tuple_t>>,
+                          std::move(what))};
+  }
+  return pptr->add_child_hdl(std::in_place_type<impl_t>, as_observable(),
+                             std::move(key_fn), max_groups, idle_timeout);
+}
+
 // -- observable: multicasting -------------------------------------------------
 
 template <class T>
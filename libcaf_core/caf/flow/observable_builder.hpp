@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "caf/async/mpsc_buffer.hpp"
 #include "caf/async/spsc_buffer.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/combine_latest.hpp"
@@ -150,6 +151,14 @@ public:
     return parent_->add_child_hdl(std::in_place_type<impl_t>, std::move(res));
   }
 
+  /// Creates an @ref observable that reads and emits all values from `res`,
+  /// i.e., from all producers that write to the MPSC buffer.
+  template <class T>
+  observable<T> from_resource(async::mpsc_consumer_resource<T> res) const {
+    using impl_t = op::from_resource<T, async::mpsc_consumer_resource<T>>;
+    return parent_->add_child_hdl(std::in_place_type<impl_t>, std::move(res));
+  }
+
   /// Creates an @ref observable that emits a sequence of integers spaced by the
   /// @p period.
   /// @param initial_delay Delay of the first integer after subscribing.
@@ -12,12 +12,15 @@
 #include "caf/flow/backpressure_overflow_strategy.hpp"
 #include "caf/flow/fwd.hpp"
 #include "caf/flow/op/base.hpp"
+#include "caf/flow/op/parallel_order.hpp"
+#include "caf/flow/spill_options.hpp"
 #include "caf/flow/step/fwd.hpp"
 #include "caf/fwd.hpp"
 #include "caf/intrusive_ptr.hpp"
 
 #include <concepts>
 #include <cstddef>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -123,12 +126,42 @@ public:
   template <class F>
   transformation<step::map<F>> map(F f);
 
+  /// Applies `fn` to each input on `num_workers` workers that run concurrently
+  /// to this observable and emits the results as soon as they become
+  /// available, i.e., in no particular order. Falls back to `map` if the
+  /// coordinator of this observable cannot launch workers.
+  /// @pre `num_workers > 0`
+  template <class F>
+  auto parallel(size_t num_workers, F fn);
+
+  /// Like `parallel`, but emits the results in the order of their inputs.
+  /// @pre `num_workers > 0`
+  template <class F>
+  auto parallel_ordered(size_t num_workers, F fn);
+
   /// When producing items faster than the consumer can consume them, the
   /// observable will buffer up to `buffer_size` items before raising an error.
   observable<T> on_backpressure_buffer(size_t buffer_size,
                                        backpressure_overflow_strategy strategy
                                        = backpressure_overflow_strategy::fail);
 
+  /// Like `on_backpressure_buffer`, but instead of dropping items or raising an
+  /// error, the observable writes overflowing items to a segment file at
+  /// `opts.path` and replays them from disk once the consumer catches up.
+  /// Items must be serializable with a `binary_serializer`. Raises
+  /// `sec::backpressure_overflow` if the file would exceed
+  /// `opts.max_disk_bytes`. Allows only a single subscriber.
+  observable<T> on_backpressure_spill(spill_options opts);
+
+  /// Records metrics for all items that pass through this point of the flow
+  /// under the stage name `name`: the number of items in and out, the
+  /// outstanding demand, the number of buffered items, how long items wait in
+  /// the buffer and how long the downstream observer needs to process each
+  /// item. Placing markers before and after an operator allows comparing its
+  /// input and output. Returns `*this` if the coordinator of this observable
+  /// does not collect metrics.
+  observable<T> instrument(std::string_view name);
+
   /// Recovers from errors by converting `on_error` to `on_complete` events.
   transformation<step::on_error_complete<T>> on_error_complete();
 
@@ -225,6 +258,33 @@ public:
   /// Emits the most recent item of the input observable once per interval.
   observable<T> throttle_last(timespan period);
 
+  /// Aggregates items in consecutive, non-overlapping windows of @p count items
+  /// and emits one aggregate per window. The associative binary operation
+  /// @p fn combines two aggregates into one.
+  template <class F>
+  observable<T> window_tumbling(size_t count, F fn);
+
+  /// Aggregates all items received in consecutive, non-overlapping periods of
+  /// @p period and emits one aggregate per non-empty window.
+  template <class F>
+  observable<T> window_tumbling(timespan period, F fn);
+
+  /// Aggregates the last @p count items and emits the aggregate after every
+  /// @p step items. Evicting items from the window does not require
+  /// re-computing the aggregate, i.e., @p fn runs in amortized O(1) per item.
+  template <class F>
+  observable<T> window_sliding(size_t count, size_t step, F fn);
+
+  /// Aggregates all items received in the last @p length and emits the
+  /// aggregate at regular intervals of @p step while the window is not empty.
+  template <class F>
+  observable<T> window_sliding(timespan length, timespan step, F fn);
+
+  /// Aggregates items into sessions and emits the aggregate of a session after
+  /// receiving no item for the duration of @p gap.
+  template <class F>
+  observable<T> window_session(timespan gap, F fn);
+
   /// Re-subscribes to the input observable on error for as long as the
   /// predicate returns true.
   template <class Predicate>
@@ -302,6 +362,21 @@ public:
   /// the tuple instead of wrapping it in a list.
   observable<cow_tuple<T, observable<T>>> head_and_tail();
 
+  /// Splits this observable into groups by applying @p key_fn to each item.
+  /// Emits a tuple with the key and an observable for the items of the group
+  /// whenever encountering a new key. Each group has its own demand.
+  /// @param key_fn Selects the key for an item. The key type must be hashable.
+  /// @param max_groups Limits how many groups may be open at the same time.
+  ///                   Opening a new group closes the least recently active
+  ///                   group when reaching this limit.
+  /// @param idle_timeout Closes groups that receive no item for this amount of
+  ///                     time. A zero timeout disables idle eviction.
+  /// @note Items for a key after closing its group open a new group.
+  /// @pre `max_groups > 0`
+  template <class KeyFn>
+  auto group_by(KeyFn key_fn, size_t max_groups = defaults::flow::max_groups,
+                timespan idle_timeout = timespan{0});
+
   // -- multicasting -----------------------------------------------------------
 
   /// Convert this observable into a @ref connectable observable.
@@ -443,6 +518,9 @@ private:
   template <class Out = output_type, class... Inputs>
   auto merge_with_concurrency(size_t max_concurrent, Inputs&&... xs);
 
+  template <class F>
+  auto parallel_impl(size_t num_workers, F fn, op::parallel_order order);
+
   template <class F, size_t... Indexes, class... Ts>
   auto combine_latest_impl(F&& fn, std::integer_sequence<size_t, Indexes...>,
                            Ts&&... inputs);
@@ -213,12 +213,14 @@ private:
   size_t demand_ = 0;
 };
 
-template <class T>
+/// Reads items from an asynchronous buffer. The `Resource` is either an
+/// `async::consumer_resource<T>` or an `async::mpsc_consumer_resource<T>`.
+template <class T, class Resource = async::consumer_resource<T>>
 class from_resource : public hot<T> {
 public:
   // -- member types -----------------------------------------------------------
 
-  using resource_type = async::consumer_resource<T>;
+  using resource_type = Resource;
 
   using super = hot<T>;
 
@@ -0,0 +1,411 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/action.hpp"
+#include "caf/cow_tuple.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/flow/coordinator.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/cold.hpp"
+#include "caf/flow/op/ucast.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/timespan.hpp"
+
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace caf::flow::op {
+
+/// @relates group_by
+template <class K, class T, class KeyFn>
+class group_by_sub : public subscription::impl_base,
+                     public observer_impl<T>,
+                     public ucast_sub_state_listener<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using tuple_t = cow_tuple<K, observable<T>>;
+
+  using state_type = ucast_sub_state<T>;
+
+  using time_point = coordinator::steady_time_point;
+
+  /// Stores the state for a single group.
+  struct group {
+    /// Pushes items to the observer of the group.
+    ucast_ptr<T> sink;
+
+    /// Stores how many items the sink currently buffers.
+    size_t buffered = 0;
+
+    /// Stores when the group received its last item.
+    time_point last_active;
+
+    /// Points to the position of the group in the LRU list.
+    typename std::list<K>::iterator lru_pos;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  group_by_sub(coordinator* parent, observer<tuple_t> out, KeyFn key_fn,
+               size_t max_groups, timespan idle_timeout)
+    : parent_(parent),
+      out_(std::move(out)),
+      key_fn_(std::move(key_fn)),
+      max_groups_(max_groups),
+      idle_timeout_(idle_timeout) {
+    if (idle_timeout_.count() > 0)
+      evict_action_ = make_action([this] { evict_idle(); });
+  }
+
+  ~group_by_sub() {
+    if (evict_action_)
+      evict_action_.dispose();
+    for (auto& kvp : groups_) {
+      auto& sink = kvp.second.sink;
+      sink->state().listener = nullptr;
+      sink->close();
+    }
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of currently active groups.
+  size_t num_groups() const noexcept {
+    return groups_.size();
+  }
+
+  /// Returns the number of items that wait for demand in all groups.
+  size_t buffered() const noexcept {
+    return buffered_;
+  }
+
+  // -- implementation of observer ---------------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  void ref_coordinated() const noexcept override {
+    this->ref();
+  }
+
+  void deref_coordinated() const noexcept override {
+    this->deref();
+  }
+
+  void on_subscribe(subscription sub) override {
+    if (!sub_ && out_) {
+      sub_ = std::move(sub);
+      request_inputs();
+    } else {
+      sub.cancel();
+    }
+  }
+
+  void on_next(const T& item) override {
+    if (!sub_)
+      return;
+    if (in_flight_ > 0)
+      --in_flight_;
+    auto now = parent_->steady_time();
+    auto* grp = get_or_add_group(key_fn_(item), now);
+    if (grp != nullptr) {
+      grp->last_active = now;
+      if (!grp->sink->state().push(item)) {
+        ++grp->buffered;
+        ++buffered_;
+      }
+    }
+    request_inputs();
+  }
+
+  void on_complete() override {
+    sub_.release_later();
+    shutdown(error{});
+  }
+
+  void on_error(const error& what) override {
+    sub_.release_later();
+    shutdown(what);
+  }
+
+  // -- implementation of disposable -------------------------------------------
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    if (!out_)
+      return;
+    demand_ += n;
+    emit_groups();
+  }
+
+  // -- implementation of ucast_sub_state_listener -----------------------------
+
+  void on_disposed(state_type* state, bool) override {
+    // The observer of a group has canceled its subscription. Subsequent items
+    // for this key open a new group.
+    if (auto i = by_state_.find(state); i != by_state_.end()) {
+      auto key = i->second;
+      by_state_.erase(i);
+      erase_group(key, false);
+    }
+    if (!out_ && groups_.empty())
+      sub_.cancel();
+    else
+      request_inputs();
+  }
+
+  void on_consumed_some(state_type* state, size_t old_buffer_size,
+                        size_t new_buffer_size) override {
+    if (auto i = by_state_.find(state); i != by_state_.end()) {
+      auto delta = old_buffer_size - new_buffer_size;
+      auto& grp = groups_.find(i->second)->second;
+      grp.buffered -= delta;
+      buffered_ -= delta;
+      request_inputs();
+    }
+  }
+
+private:
+  // -- implementation of subscription::impl_base ------------------------------
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    // Disposing the outer observable only stops emitting new groups. Groups
+    // that are already active keep receiving items.
+    pending_.clear();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+    if (groups_.empty())
+      sub_.cancel();
+  }
+
+  // -- group management -------------------------------------------------------
+
+  group* get_or_add_group(const K& key, time_point now) {
+    if (auto i = groups_.find(key); i != groups_.end()) {
+      // Move the group to the front of the LRU list.
+      lru_.splice(lru_.begin(), lru_, i->second.lru_pos);
+      return &i->second;
+    }
+    if (!out_)
+      return nullptr;
+    if (groups_.size() >= max_groups_) {
+      // Make room by closing the least recently active group.
+      erase_group(lru_.back(), true);
+    }
+    auto sink = parent_->add_child(std::in_place_type<ucast<T>>);
+    sink->state().listener = this;
+    by_state_.emplace(&sink->state(), key);
+    lru_.push_front(key);
+    auto& grp = groups_[key];
+    grp.sink = sink;
+    grp.last_active = now;
+    grp.lru_pos = lru_.begin();
+    pending_.push_back(make_cow_tuple(key, observable<T>{std::move(sink)}));
+    emit_groups();
+    arm_timer();
+    return &grp;
+  }
+
+  /// Removes a group from the index. Closes the sink if `close_sink` is true.
+  void erase_group(const K& key, bool close_sink) {
+    auto i = groups_.find(key);
+    CAF_ASSERT(i != groups_.end());
+    auto& grp = i->second;
+    buffered_ -= grp.buffered;
+    lru_.erase(grp.lru_pos);
+    if (close_sink) {
+      auto& st = grp.sink->state();
+      by_state_.erase(&st);
+      st.listener = nullptr;
+      grp.sink->close();
+    }
+    groups_.erase(i);
+  }
+
+  void evict_idle() {
+    pending_timeout_ = disposable{};
+    auto now = parent_->steady_time();
+    while (!lru_.empty()) {
+      auto& grp = groups_.find(lru_.back())->second;
+      if (grp.last_active + idle_timeout_ > now)
+        break;
+      erase_group(lru_.back(), true);
+    }
+    request_inputs();
+    arm_timer();
+  }
+
+  void arm_timer() {
+    if (!evict_action_ || pending_timeout_ || lru_.empty())
+      return;
+    auto& grp = groups_.find(lru_.back())->second;
+    pending_timeout_ = parent_->delay_until(grp.last_active + idle_timeout_,
+                                            evict_action_);
+  }
+
+  // -- flow control -----------------------------------------------------------
+
+  void request_inputs() {
+    if (!sub_)
+      return;
+    auto pending = in_flight_ + buffered_;
+    if (pending + defaults::flow::min_demand <= defaults::flow::buffer_size) {
+      auto n = defaults::flow::buffer_size - pending;
+      in_flight_ += n;
+      sub_.request(n);
+    }
+  }
+
+  void emit_groups() {
+    while (out_ && demand_ > 0 && !pending_.empty()) {
+      --demand_;
+      auto tup = std::move(pending_.front());
+      pending_.pop_front();
+      out_.on_next(tup);
+    }
+    if (out_ && completed_ && pending_.empty()) {
+      if (!err_)
+        out_.on_complete();
+      else
+        out_.on_error(err_);
+    }
+  }
+
+  void shutdown(const error& reason) {
+    completed_ = true;
+    err_ = reason;
+    pending_timeout_.dispose();
+    if (evict_action_)
+      evict_action_.dispose();
+    for (auto& kvp : groups_) {
+      auto& sink = kvp.second.sink;
+      sink->state().listener = nullptr;
+      if (!reason)
+        sink->close();
+      else
+        sink->abort(reason);
+    }
+    groups_.clear();
+    by_state_.clear();
+    lru_.clear();
+    buffered_ = 0;
+    if (reason)
+      pending_.clear();
+    emit_groups();
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Our scheduling context.
+  coordinator* parent_;
+
+  /// The observer for the groups.
+  observer<tuple_t> out_;
+
+  /// Selects the key for each item.
+  KeyFn key_fn_;
+
+  /// Limits how many groups may be active at the same time.
+  size_t max_groups_;
+
+  /// Closes groups that receive no item for this amount of time.
+  timespan idle_timeout_;
+
+  /// Pulls data from the decorated observable.
+  subscription sub_;
+
+  /// Maps keys to their groups.
+  std::unordered_map<K, group> groups_;
+
+  /// Maps the state of each sink to its key for the listener callbacks.
+  std::unordered_map<const state_type*, K> by_state_;
+
+  /// Orders the keys of all groups by their last activity. The most recently
+  /// active group is at the front.
+  std::list<K> lru_;
+
+  /// Stores new groups until the observer requests them.
+  std::deque<tuple_t> pending_;
+
+  /// Demand signaled by the observer.
+  size_t demand_ = 0;
+
+  /// Number of items we have requested but not yet received.
+  size_t in_flight_ = 0;
+
+  /// Number of items that wait for demand in all groups.
+  size_t buffered_ = 0;
+
+  /// Stores whether the input has completed.
+  bool completed_ = false;
+
+  /// Caches the abort reason.
+  error err_;
+
+  /// Handle to the pending timeout for evicting idle groups.
+  disposable pending_timeout_;
+
+  /// Action for evicting idle groups.
+  action evict_action_;
+};
+
+/// Splits the items of an observable into groups by applying a key function to
+/// each item. Emits a tuple with the key and an observable for the group
+/// whenever encountering a new key.
+template <class K, class T, class KeyFn>
+class group_by : public cold<cow_tuple<K, observable<T>>> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using tuple_t = cow_tuple<K, observable<T>>;
+
+  using super = cold<tuple_t>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  group_by(coordinator* parent, observable<T> decorated, KeyFn key_fn,
+           size_t max_groups, timespan idle_timeout)
+    : super(parent),
+      decorated_(std::move(decorated)),
+      key_fn_(std::move(key_fn)),
+      max_groups_(max_groups),
+      idle_timeout_(idle_timeout) {
+    // nop
+  }
+
+  disposable subscribe(observer<tuple_t> out) override {
+    using impl_t = group_by_sub<K, T, KeyFn>;
+    auto ptr = super::parent_->add_child(std::in_place_type<impl_t>, out,
+                                         key_fn_, max_groups_, idle_timeout_);
+    out.on_subscribe(subscription{ptr});
+    decorated_.subscribe(ptr->as_observer());
+    return ptr->as_disposable();
+  }
+
+private:
+  observable<T> decorated_;
+
+  KeyFn key_fn_;
+
+  size_t max_groups_;
+
+  timespan idle_timeout_;
+};
+
+} // namespace caf::flow::op
@@ -0,0 +1,193 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/group_by.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/multicaster.hpp"
+#include "caf/flow/observable.hpp"
+
+#include <memory>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct group_log {
+  using int_list = std::vector<int>;
+
+  /// Stores the key and the received items for each group in the order of
+  /// their creation.
+  std::vector<std::pair<int, int_list>> groups;
+
+  /// Stores which groups have completed.
+  std::vector<bool> completed;
+};
+
+using group_log_ptr = std::shared_ptr<group_log>;
+
+struct fixture : test::fixture::deterministic, test::fixture::flow {
+  using int_list = std::vector<int>;
+
+  using tuple_t = cow_tuple<int, caf::flow::observable<int>>;
+
+  static auto mod3(int x) {
+    return x % 3;
+  }
+
+  // Subscribes to each group and records its items.
+  template <class Observable>
+  static void record(Observable&& groups, group_log_ptr log) {
+    std::forward<Observable>(groups).for_each([log](const tuple_t& tup) {
+      auto [key, items] = tup.data();
+      auto index = log->groups.size();
+      log->groups.emplace_back(key, int_list{});
+      log->completed.push_back(false);
+      items
+        .do_on_complete([log, index] { log->completed[index] = true; })
+        .for_each([log, index](int x) { //
+          log->groups[index].second.push_back(x);
+        });
+    });
+  }
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("group_by splits an observable into groups") {
+  GIVEN("an observable with nine items") {
+    WHEN("grouping the items by their remainder") {
+      THEN("the observer receives one group per key") {
+        auto log = std::make_shared<group_log>();
+        record(range(1, 9).group_by(mod3), log);
+        run_flows();
+        require_eq(log->groups.size(), 3u);
+        check_eq(log->groups[0].first, 1);
+        check_eq(log->groups[0].second, int_list({1, 4, 7}));
+        check_eq(log->groups[1].first, 2);
+        check_eq(log->groups[1].second, int_list({2, 5, 8}));
+        check_eq(log->groups[2].first, 0);
+        check_eq(log->groups[2].second, int_list({3, 6, 9}));
+        check_eq(log->completed, std::vector<bool>({true, true, true}));
+      }
+    }
+  }
+}
+
+SCENARIO("group_by respects the demand of each group") {
+  GIVEN("an observable with nine items") {
+    WHEN("one group does not request any items") {
+      THEN("other groups still receive their items") {
+        auto log = std::make_shared<group_log>();
+        auto passive = make_passive_observer<int>();
+        range(1, 9).group_by(mod3).for_each([&](const tuple_t& tup) {
+          auto [key, items] = tup.data();
+          if (key == 0) {
+            items.subscribe(passive->as_observer());
+            return;
+          }
+          log->groups.emplace_back(key, int_list{});
+          auto index = log->groups.size() - 1;
+          items.for_each([log, index](int x) { //
+            log->groups[index].second.push_back(x);
+          });
+        });
+        run_flows();
+        require_eq(log->groups.size(), 2u);
+        check_eq(log->groups[0].second, int_list({1, 4, 7}));
+        check_eq(log->groups[1].second, int_list({2, 5, 8}));
+        check(passive->buf.empty());
+        passive->request(2);
+        run_flows();
+        check_eq(passive->buf, int_list({3, 6}));
+        passive->request(10);
+        run_flows();
+        check_eq(passive->buf, int_list({3, 6, 9}));
+        check(passive->completed());
+      }
+    }
+  }
+}
+
+SCENARIO("group_by limits the number of open groups") {
+  GIVEN("a group_by operator with at most two groups") {
+    WHEN("encountering a third key") {
+      THEN("the operator closes the least recently active group") {
+        auto log = std::make_shared<group_log>();
+        record(range(1, 5).group_by(mod3, 2), log);
+        run_flows();
+        require_eq(log->groups.size(), 5u);
+        auto keys = int_list{};
+        for (auto& [key, items] : log->groups) {
+          keys.push_back(key);
+          check_eq(items.size(), 1u);
+        }
+        check_eq(keys, int_list({1, 2, 0, 1, 2}));
+        check_eq(log->completed,
+                 std::vector<bool>({true, true, true, true, true}));
+      }
+    }
+  }
+  GIVEN("a group_by operator with a zero group limit") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives an error") {
+        check_eq(collect(range(1, 5).group_by(mod3, 0)),
+                 sec::invalid_argument);
+      }
+    }
+  }
+}
+
+SCENARIO("group_by closes idle groups") {
+  GIVEN("a group_by operator with an idle timeout of 100ms") {
+    WHEN("a group receives no items for 100ms") {
+      THEN("the operator closes the group") {
+        auto log = std::make_shared<group_log>();
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        sys.spawn([&pub, log](caf::event_based_actor* self) {
+          record(pub.as_observable().observe_on(self).group_by(
+                   mod3, defaults::flow::max_groups, 100ms),
+                 log);
+        });
+        auto push = [this, &pub](int x) {
+          pub.push(x);
+          run_flows();
+          dispatch_messages();
+        };
+        auto wait = [this](timespan delay) {
+          advance_time(delay);
+          run_flows();
+          dispatch_messages();
+        };
+        dispatch_messages();
+        push(1);
+        wait(50ms);
+        push(4);
+        wait(50ms);
+        require_eq(log->groups.size(), 1u);
+        check_eq(log->completed, std::vector<bool>({false}));
+        wait(50ms);
+        check_eq(log->completed, std::vector<bool>({true}));
+        push(7);
+        require_eq(log->groups.size(), 2u);
+        check_eq(log->groups[0].second, int_list({1, 4}));
+        check_eq(log->groups[1].second, int_list({7}));
+        check_eq(log->completed, std::vector<bool>({true, false}));
+        pub.close();
+        run_flows();
+        dispatch_messages();
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
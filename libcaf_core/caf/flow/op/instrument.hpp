@@ -0,0 +1,242 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/defaults.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/scope_guard.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/cold.hpp"
+#include "caf/flow/stage_metrics.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/timer.hpp"
+
+#include <chrono>
+#include <deque>
+#include <utility>
+
+namespace caf::flow::op {
+
+/// Forwards all items from upstream to downstream while recording metrics.
+/// Behaves like the operator for fused processing steps: requests up to
+/// `defaults::flow::buffer_size` items in advance and buffers them until the
+/// downstream observer requests them.
+template <class T>
+class instrument_sub : public subscription::impl_base,
+                       public observer_impl<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = telemetry::timer::clock_type;
+
+  using buffer_entry = std::pair<T, clock_type::time_point>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  instrument_sub(coordinator* parent, observer<T> out, stage_metrics metrics)
+    : parent_(parent), out_(std::move(out)), metrics_(metrics) {
+    CAF_ASSERT(metrics_.enabled());
+  }
+
+  // -- implementation of observer_impl ----------------------------------------
+
+  void ref_coordinated() const noexcept override {
+    this->ref();
+  }
+
+  void deref_coordinated() const noexcept override {
+    this->deref();
+  }
+
+  void on_subscribe(subscription in) override {
+    if (in_) {
+      in.cancel();
+      return;
+    }
+    in_ = std::move(in);
+    pull();
+  }
+
+  void on_next(const T& item) override {
+    CAF_ASSERT(!in_ || in_flight_ > 0);
+    if (!in_)
+      return;
+    --in_flight_;
+    metrics_.items_in->inc();
+    metrics_.buffered->inc();
+    buf_.emplace_back(item, clock_type::now());
+    if (!running_)
+      do_run();
+  }
+
+  void on_complete() override {
+    if (!in_)
+      return;
+    in_.release_later();
+    if (!running_)
+      do_run();
+  }
+
+  void on_error(const error& what) override {
+    if (!in_)
+      return;
+    in_.release_later();
+    err_ = what;
+    if (!running_)
+      do_run();
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    if (!out_)
+      return;
+    metrics_.demand->inc(static_cast<int64_t>(n));
+    if (demand_ != 0) {
+      demand_ += n;
+      return;
+    }
+    demand_ = n;
+    if (!running_) {
+      parent_->delay_fn([strong_this = intrusive_ptr{this}] { //
+        strong_this->do_run();
+      });
+    }
+  }
+
+private:
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    in_.cancel();
+    reset_gauges();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  void pull() {
+    if (auto pending = buf_.size() + in_flight_;
+        in_ && pending < defaults::flow::buffer_size) {
+      auto new_demand = defaults::flow::buffer_size - pending;
+      in_flight_ += new_demand;
+      in_.request(new_demand);
+    }
+  }
+
+  void do_run() {
+    running_ = true;
+    auto guard = detail::scope_guard{[this]() noexcept { running_ = false; }};
+    if (!out_)
+      return;
+    while (demand_ > 0 && !buf_.empty()) {
+      auto [item, t0] = std::move(buf_.front());
+      buf_.pop_front();
+      --demand_;
+      metrics_.demand->dec();
+      metrics_.buffered->dec();
+      telemetry::timer::observe(metrics_.buffer_time, t0);
+      metrics_.items_out->inc();
+      {
+        auto tm = telemetry::timer{metrics_.processing_time};
+        out_.on_next(item);
+      }
+      if (!out_)
+        return;
+    }
+    if (in_) {
+      pull();
+      return;
+    }
+    if (buf_.empty()) {
+      reset_gauges();
+      auto out = std::move(out_);
+      if (!err_)
+        out.on_complete();
+      else
+        out.on_error(err_);
+    }
+  }
+
+  /// Removes the demand and the buffered items of this stage from the gauges.
+  void reset_gauges() {
+    metrics_.demand->dec(static_cast<int64_t>(demand_));
+    metrics_.buffered->dec(static_cast<int64_t>(buf_.size()));
+    demand_ = 0;
+    buf_.clear();
+  }
+
+  /// Stores the context (coordinator) that runs this flow.
+  coordinator* parent_;
+
+  /// Stores a handle to the subscribed observer.
+  observer<T> out_;
+
+  /// Stores the subscription to the input.
+  subscription in_;
+
+  /// Stores the metric instances for this stage.
+  stage_metrics metrics_;
+
+  /// Stores items that wait for demand along with the time of their arrival.
+  std::deque<buffer_entry> buf_;
+
+  /// Stores the demand of the downstream observer.
+  size_t demand_ = 0;
+
+  /// Stores how many items we have requested but not yet received.
+  size_t in_flight_ = 0;
+
+  /// Stores whether `do_run` is currently active.
+  bool running_ = false;
+
+  /// Stores the error from upstream, if any.
+  error err_;
+};
+
+/// Records metrics for all items that pass through it.
+template <class T>
+class instrument : public cold<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = cold<T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  instrument(coordinator* parent, intrusive_ptr<base<T>> input,
+             stage_metrics metrics)
+    : super(parent), input_(std::move(input)), metrics_(metrics) {
+    // nop
+  }
+
+  // -- implementation of observable_impl<T> -----------------------------------
+
+  disposable subscribe(observer<T> out) override {
+    using sub_t = instrument_sub<T>;
+    auto ptr = super::parent_->add_child(std::in_place_type<sub_t>, out,
+                                         metrics_);
+    out.on_subscribe(subscription{ptr});
+    input_->subscribe(ptr->as_observer());
+    return ptr->as_disposable();
+  }
+
+private:
+  intrusive_ptr<base<T>> input_;
+  stage_metrics metrics_;
+};
+
+} // namespace caf::flow::op
@@ -0,0 +1,145 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/instrument.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/multicaster.hpp"
+#include "caf/flow/observable.hpp"
+#include "caf/flow/stage_metrics.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+struct fixture : test::fixture::deterministic, test::fixture::flow {
+  using int_list = std::vector<int>;
+
+  // Returns how many values `hist` has observed.
+  static int64_t count(const telemetry::dbl_histogram* hist) {
+    auto result = int64_t{0};
+    for (const auto& bucket : hist->buckets())
+      result += bucket.count.value();
+    return result;
+  }
+
+  // Inserts an instrumentation stage with metrics from `reg` after `input`.
+  caf::flow::observable<int> instrumented(caf::flow::observable<int> input) {
+    using impl_t = caf::flow::op::instrument<int>;
+    return coordinator()->add_child_hdl(std::in_place_type<impl_t>,
+                                        input.pimpl(), metrics);
+  }
+
+  telemetry::metric_registry reg;
+
+  caf::flow::stage_metrics metrics = caf::flow::stage_metrics::make(reg,
+                                                                    "test");
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("an instrumentation stage forwards all items") {
+  GIVEN("an instrumented observable") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives all items and the stage counts them") {
+        check_eq(collect(instrumented(range(1, 10).as_observable())),
+                 int_list({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+        check_eq(metrics.items_in->value(), 10);
+        check_eq(metrics.items_out->value(), 10);
+        check_eq(metrics.demand->value(), 0);
+        check_eq(metrics.buffered->value(), 0);
+        check_eq(count(metrics.processing_time), 10);
+        check_eq(count(metrics.buffer_time), 10);
+      }
+    }
+  }
+}
+
+SCENARIO("an instrumentation stage tracks demand and buffered items") {
+  GIVEN("an instrumented observable") {
+    WHEN("the observer requests fewer items than the source produces") {
+      THEN("the stage reports the buffered items") {
+        auto obs = make_passive_observer<int>();
+        instrumented(range(1, 10).as_observable())
+          .subscribe(obs->as_observer());
+        run_flows();
+        check_eq(metrics.items_in->value(), 10);
+        check_eq(metrics.items_out->value(), 0);
+        check_eq(metrics.buffered->value(), 10);
+        obs->request(4);
+        run_flows();
+        check_eq(obs->buf, int_list({1, 2, 3, 4}));
+        check_eq(metrics.items_out->value(), 4);
+        check_eq(metrics.buffered->value(), 6);
+        check_eq(metrics.demand->value(), 0);
+        obs->request(20);
+        run_flows();
+        check(obs->completed());
+        check_eq(metrics.buffered->value(), 0);
+        check_eq(metrics.demand->value(), 0);
+      }
+    }
+    WHEN("the source produces fewer items than the observer requests") {
+      THEN("the stage reports the outstanding demand") {
+        auto src = caf::flow::multicaster<int>{coordinator()};
+        auto obs = make_passive_observer<int>();
+        instrumented(src.as_observable()).subscribe(obs->as_observer());
+        run_flows();
+        obs->request(5);
+        run_flows();
+        check_eq(metrics.demand->value(), 5);
+        src.push(1);
+        src.push(2);
+        run_flows();
+        check_eq(obs->buf, int_list({1, 2}));
+        check_eq(metrics.demand->value(), 3);
+        obs->unsubscribe();
+        run_flows();
+        check_eq(metrics.demand->value(), 0);
+      }
+    }
+  }
+}
+
+SCENARIO("instrument only adds a stage if the coordinator collects metrics") {
+  GIVEN("a coordinator without a metric registry") {
+    WHEN("calling instrument on an observable") {
+      THEN("the observable remains unchanged") {
+        auto src = range(1, 3).as_observable();
+        check(src.instrument("test").pimpl() == src.pimpl());
+      }
+    }
+  }
+  GIVEN("an actor") {
+    WHEN("calling instrument on an observable") {
+      THEN("the actor records the metrics in the registry of its system") {
+        auto result = std::make_shared<int_list>();
+        sys.spawn([result](event_based_actor* self) {
+          self->make_observable()
+            .iota(1)
+            .take(5)
+            .instrument("five")
+            .for_each([result](int x) { result->push_back(x); });
+        });
+        dispatch_messages();
+        check_eq(*result, int_list({1, 2, 3, 4, 5}));
+        auto* items = sys.metrics().counter_instance(
+          "caf.flow", "items-in", {{"name", "five"}}, "");
+        check_eq(items->value(), 5);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
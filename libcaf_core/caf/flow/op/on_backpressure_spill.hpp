@@ -0,0 +1,280 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/binary_deserializer.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/spill_file.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/hot.hpp"
+#include "caf/flow/spill_options.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/telemetry/counter.hpp"
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace caf::flow::op {
+
+template <class T>
+class on_backpressure_spill_sub : public subscription::impl_base,
+                                  public observer_impl<T> {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  on_backpressure_spill_sub(coordinator* parent, observer<T> out,
+                            const spill_options& opts)
+    : parent_(parent), out_(std::move(out)), opts_(opts) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of items in memory.
+  size_t buffered() const noexcept {
+    return buffer_.size();
+  }
+
+  /// Returns the number of items on disk.
+  size_t spilled() const noexcept {
+    return file_ ? file_->size() : 0;
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t new_demand) override {
+    if (new_demand == 0)
+      return;
+    demand_ += new_demand;
+    if (demand_ == new_demand && !buffer_.empty()) {
+      parent_->delay_fn([strong_this = intrusive_ptr{this}] { //
+        strong_this->on_request();
+      });
+    }
+  }
+
+  // -- implementation of observer_impl ----------------------------------------
+
+  void ref_coordinated() const noexcept override {
+    this->ref();
+  }
+
+  void deref_coordinated() const noexcept override {
+    this->deref();
+  }
+
+  void on_subscribe(subscription sub) override {
+    if (sub_) {
+      sub.cancel();
+      return;
+    }
+    sub_ = std::move(sub);
+    sub_.request(opts_.buffer_size);
+  }
+
+  void on_next(const T& item) override {
+    if (!out_)
+      return;
+    if (demand_ > 0 && buffer_.empty()) {
+      CAF_ASSERT(spilled() == 0);
+      --demand_;
+      out_.on_next(item);
+      if (sub_)
+        sub_.request(1);
+      return;
+    }
+    // Items on disk must come before new items, so we can only add to the
+    // memory buffer while the file is empty.
+    if (buffer_.size() < opts_.buffer_size && spilled() == 0) {
+      buffer_.push_back(item);
+      sub_.request(1);
+      return;
+    }
+    if (auto err = spill(item)) {
+      abort(err);
+      return;
+    }
+    sub_.request(1);
+  }
+
+  void on_complete() override {
+    if (!out_ || src_error_)
+      return;
+    src_error_ = error{};
+    sub_.release_later();
+    if (buffer_.empty())
+      out_.on_complete();
+  }
+
+  void on_error(const error& what) override {
+    if (!out_ || src_error_)
+      return;
+    src_error_ = what;
+    sub_.release_later();
+    if (buffer_.empty())
+      out_.on_error(what);
+  }
+
+private:
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    sub_.cancel();
+    buffer_.clear();
+    file_.reset();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  void on_request() {
+    while (out_ && demand_ > 0 && !buffer_.empty()) {
+      --demand_;
+      out_.on_next(buffer_.front());
+      buffer_.pop_front();
+      if (buffer_.empty() && spilled() > 0) {
+        if (auto err = replay()) {
+          abort(err);
+          return;
+        }
+      }
+    }
+    if (out_ && src_error_ && buffer_.empty()) {
+      CAF_ASSERT(!sub_);
+      if (*src_error_)
+        out_.on_error(*src_error_);
+      else
+        out_.on_complete();
+    }
+  }
+
+  /// Writes `item` to the end of the segment file.
+  error spill(const T& item) {
+    if (!file_)
+      file_ = std::make_unique<detail::spill_file>(opts_.path);
+    io_buf_.clear();
+    binary_serializer sink{io_buf_};
+    if (!sink.apply(item))
+      return std::move(sink.get_error());
+    auto record_size = detail::spill_file::prefix_size + io_buf_.size();
+    if (opts_.max_disk_bytes > 0
+        && file_->file_size() + record_size > opts_.max_disk_bytes) {
+      if (file_->pending_bytes() + record_size > opts_.max_disk_bytes)
+        return make_error(sec::backpressure_overflow);
+      if (auto err = file_->compact())
+        return err;
+    }
+    if (auto err = file_->append(io_buf_))
+      return err;
+    if (opts_.spilled != nullptr)
+      opts_.spilled->inc();
+    return {};
+  }
+
+  /// Moves up to `buffer_size` items from the segment file back into memory.
+  error replay() {
+    CAF_ASSERT(file_ != nullptr);
+    while (buffer_.size() < opts_.buffer_size && !file_->empty()) {
+      if (auto err = file_->read(io_buf_))
+        return err;
+      binary_deserializer source{io_buf_};
+      auto item = T{};
+      if (!source.apply(item))
+        return std::move(source.get_error());
+      buffer_.push_back(std::move(item));
+      if (opts_.replayed != nullptr)
+        opts_.replayed->inc();
+    }
+    return {};
+  }
+
+  void abort(const error& reason) {
+    sub_.cancel();
+    buffer_.clear();
+    file_.reset();
+    out_.on_error(reason);
+  }
+
+  /// Stores the context (coordinator) that runs this flow.
+  coordinator* parent_;
+
+  /// Stores a handle to the subscribed observer.
+  observer<T> out_;
+
+  subscription sub_;
+
+  spill_options opts_;
+
+  size_t demand_ = 0;
+
+  /// Stores whether the input observable has signaled on_complete or on_error.
+  /// A default-constructed error represents on_complete.
+  std::optional<error> src_error_;
+
+  /// Stores the items in memory. All items in this buffer precede the items in
+  /// the segment file.
+  std::deque<T> buffer_;
+
+  /// Stores overflowing items. Created lazily on the first overflow.
+  std::unique_ptr<detail::spill_file> file_;
+
+  /// Scratch space for serializing and deserializing items.
+  byte_buffer io_buf_;
+};
+
+/// An observable that buffers items in memory and spills overflowing items to
+/// a segment file on disk. Allows only a single subscriber, because all
+/// subscribers would write to the same file.
+template <class T>
+class on_backpressure_spill : public hot<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = hot<T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  on_backpressure_spill(coordinator* parent, observable<T> decorated,
+                        spill_options opts)
+    : super(parent), decorated_(std::move(decorated)), opts_(std::move(opts)) {
+    // nop
+  }
+
+  // -- implementation of observable_impl<T> -----------------------------------
+
+  disposable subscribe(observer<T> out) override {
+    CAF_ASSERT(out.valid());
+    if (!decorated_) {
+      return super::fail_subscription(
+        out, make_error(sec::too_many_observers,
+                        "may only subscribe once to a spill operator"));
+    }
+    using sub_t = on_backpressure_spill_sub<T>;
+    auto ptr = super::parent_->add_child(std::in_place_type<sub_t>, out, opts_);
+    out.on_subscribe(subscription{ptr});
+    auto decorated = std::move(decorated_);
+    decorated.subscribe(ptr->as_observer());
+    return disposable{ptr->as_disposable()};
+  }
+
+private:
+  observable<T> decorated_;
+  spill_options opts_;
+};
+
+} // namespace caf::flow::op
@@ -0,0 +1,226 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/on_backpressure_spill.hpp"
+
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/temp_directory.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/flow/multicaster.hpp"
+#include "caf/telemetry/counter.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace caf;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct fixture : test::fixture::flow {
+  fixture() {
+    opts.buffer_size = 4;
+    opts.path = dir.file("segment");
+    opts.spilled = &spilled;
+    opts.replayed = &replayed;
+  }
+
+  static std::vector<int> iota(int first, int last) {
+    auto result = std::vector<int>{};
+    for (auto i = first; i <= last; ++i)
+      result.push_back(i);
+    return result;
+  }
+
+  test::temp_directory dir{"caf-spill-test"};
+  caf::flow::spill_options opts;
+  telemetry::int_counter spilled;
+  telemetry::int_counter replayed;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("the spill operator is transparent with sufficient demand") {
+  GIVEN("a spill operator") {
+    WHEN("the observer always signals sufficient demand") {
+      THEN("the operator never touches the disk") {
+        check_eq(collect(range(1, 99).on_backpressure_spill(opts)),
+                 iota(1, 99));
+        check_eq(spilled.value(), 0);
+        check(!fs::exists(opts.path));
+      }
+    }
+  }
+}
+
+SCENARIO("the spill operator writes overflowing items to disk") {
+  GIVEN("a spill operator with a buffer size of 4") {
+    WHEN("the observer falls behind") {
+      THEN("the observer receives all items in order") {
+        auto mcast = caf::flow::multicaster<std::string>{coordinator()};
+        auto obs = make_passive_observer<std::string>();
+        mcast.as_observable()
+          .on_backpressure_spill(opts)
+          .subscribe(obs->as_observer());
+        run_flows();
+        obs->sub.request(2);
+        auto want = std::vector<std::string>{};
+        for (int i = 1; i <= 20; ++i) {
+          want.push_back(std::to_string(i));
+          mcast.push(want.back());
+          run_flows();
+        }
+        mcast.close();
+        run_flows();
+        // The operator delivered 2 items, keeps 4 items in memory and writes
+        // the remaining 14 items to disk.
+        check_eq(obs->buf.size(), 2u);
+        check_eq(spilled.value(), 14);
+        check_eq(replayed.value(), 0);
+        check(fs::exists(opts.path));
+        check(!obs->completed());
+        obs->sub.request(8);
+        run_flows();
+        check_eq(obs->buf.size(), 10u);
+        check(!obs->completed());
+        obs->sub.request(100);
+        run_flows();
+        check_eq(obs->buf, want);
+        check_eq(replayed.value(), 14);
+        check(obs->completed());
+      }
+    }
+    WHEN("new items arrive while the operator replays items from disk") {
+      THEN("the new items follow the items on disk") {
+        auto mcast = caf::flow::multicaster<int>{coordinator()};
+        auto obs = make_passive_observer<int>();
+        mcast.as_observable()
+          .on_backpressure_spill(opts)
+          .subscribe(obs->as_observer());
+        run_flows();
+        for (int i = 1; i <= 10; ++i)
+          mcast.push(i);
+        run_flows();
+        obs->sub.request(5);
+        run_flows();
+        check_eq(obs->buf, iota(1, 5));
+        for (int i = 11; i <= 15; ++i)
+          mcast.push(i);
+        run_flows();
+        obs->sub.request(100);
+        run_flows();
+        check_eq(obs->buf, iota(1, 15));
+        check_eq(spilled.value(), replayed.value());
+      }
+    }
+  }
+}
+
+SCENARIO("the spill operator allows only a single subscriber") {
+  GIVEN("a spill operator with a subscriber") {
+    WHEN("a second observer subscribes") {
+      THEN("the second observer receives an error") {
+        auto mcast = caf::flow::multicaster<int>{coordinator()};
+        auto uut = mcast.as_observable().on_backpressure_spill(opts);
+        auto obs1 = make_passive_observer<int>();
+        auto obs2 = make_passive_observer<int>();
+        uut.subscribe(obs1->as_observer());
+        uut.subscribe(obs2->as_observer());
+        run_flows();
+        check(obs2->aborted());
+        check_eq(obs2->err, sec::too_many_observers);
+        for (int i = 1; i <= 10; ++i)
+          mcast.push(i);
+        mcast.close();
+        run_flows();
+        check_eq(spilled.value(), 6);
+        obs1->sub.request(100);
+        run_flows();
+        check_eq(obs1->buf, iota(1, 10));
+        check(obs1->completed());
+      }
+    }
+  }
+}
+
+SCENARIO("the spill operator limits the size of the segment file") {
+  GIVEN("a spill operator with a disk budget") {
+    WHEN("the segment file exceeds the budget") {
+      THEN("the observer receives an error") {
+        // Each item occupies 8 bytes: a 4-byte length prefix plus the item.
+        opts.max_disk_bytes = 32;
+        auto mcast = caf::flow::multicaster<int32_t>{coordinator()};
+        auto obs = make_passive_observer<int32_t>();
+        mcast.as_observable()
+          .on_backpressure_spill(opts)
+          .subscribe(obs->as_observer());
+        run_flows();
+        for (int32_t i = 1; i <= 8; ++i)
+          mcast.push(i);
+        run_flows();
+        check(!obs->aborted());
+        mcast.push(9);
+        run_flows();
+        check(obs->aborted());
+        check_eq(obs->err, sec::backpressure_overflow);
+        check(!fs::exists(opts.path));
+      }
+    }
+    WHEN("the observer lags behind but keeps consuming items") {
+      THEN("the segment file never exceeds the budget") {
+        opts.max_disk_bytes = 64;
+        auto mcast = caf::flow::multicaster<int32_t>{coordinator()};
+        auto obs = make_passive_observer<int32_t>();
+        mcast.as_observable()
+          .on_backpressure_spill(opts)
+          .subscribe(obs->as_observer());
+        run_flows();
+        for (int32_t i = 1; i <= 12; ++i)
+          mcast.push(i);
+        run_flows();
+        obs->sub.request(4);
+        run_flows();
+        // The file always holds 4 items, because the observer consumes only
+        // as many items as the producer adds. Without reclaiming the space of
+        // replayed items, the file would grow by 32 bytes in each round.
+        for (int32_t i = 13; i <= 92; i += 4) {
+          for (int32_t j = i; j < i + 4; ++j)
+            mcast.push(j);
+          run_flows();
+          obs->sub.request(4);
+          run_flows();
+          check(!obs->aborted());
+          check(!fs::is_empty(opts.path));
+          check_le(fs::file_size(opts.path), 64u);
+        }
+        check_eq(spilled.value(), 88);
+        mcast.close();
+        obs->sub.request(100);
+        run_flows();
+        check(obs->completed());
+        check_eq(obs->buf, iota(1, 92));
+      }
+    }
+  }
+}
+
+SCENARIO("the spill operator rejects invalid options") {
+  GIVEN("a spill operator without a path") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives an error") {
+        opts.path.clear();
+        check_eq(collect(range(1, 9).on_backpressure_spill(opts)),
+                 sec::invalid_argument);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
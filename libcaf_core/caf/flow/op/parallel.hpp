@@ -0,0 +1,560 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/async/producer.hpp"
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/atomic_ref_counted.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/from_resource.hpp"
+#include "caf/flow/op/hot.hpp"
+#include "caf/flow/op/parallel_order.hpp"
+#include "caf/flow/op/pullable.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace caf::flow::op {
+
+/// Receives demand and cancel events for a single shard input buffer and
+/// forwards them to the coordinator of the `Target`.
+template <class Target>
+class parallel_shard_writer : public detail::atomic_ref_counted,
+                              public async::producer {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  parallel_shard_writer(coordinator* parent, Target* target, size_t index)
+    : parent_(parent), target_(target), index_(index) {
+    // nop
+  }
+
+  // -- implementation of async::producer: must be thread-safe -----------------
+
+  void on_consumer_ready() override {
+    // nop
+  }
+
+  void on_consumer_cancel() override {
+    parent_->schedule_fn([ptr = strong_this()] {
+      if (ptr->target_)
+        ptr->target_->shard_cancel(ptr->index_);
+    });
+  }
+
+  void on_consumer_demand(size_t demand) override {
+    parent_->schedule_fn([ptr = strong_this(), demand] {
+      if (ptr->target_)
+        ptr->target_->shard_demand(ptr->index_, demand);
+    });
+  }
+
+  void ref_producer() const noexcept override {
+    this->ref();
+  }
+
+  void deref_producer() const noexcept override {
+    this->deref();
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Drops the reference to the target. Must run on the coordinator.
+  void release() {
+    target_ = nullptr;
+  }
+
+private:
+  intrusive_ptr<parallel_shard_writer> strong_this() {
+    return {this};
+  }
+
+  /// Stores the coordinator that runs the target. Needs to be a strong
+  /// reference, because the buffer may call `schedule_fn` at any time.
+  coordinator_ptr parent_;
+
+  /// Points to the subscription that dispatches items to the workers.
+  intrusive_ptr<Target> target_;
+
+  /// Identifies the shard.
+  size_t index_;
+};
+
+/// State for a single worker of the @ref parallel operator.
+template <class T, class U, class Target>
+struct parallel_shard {
+  /// Sends inputs to the worker.
+  async::spsc_buffer_ptr<T> in;
+
+  /// Receives demand signals from the input buffer.
+  intrusive_ptr<parallel_shard_writer<Target>> writer;
+
+  /// Demand signaled by the worker that we did not use yet.
+  size_t in_demand = 0;
+
+  /// Receives results from the worker.
+  subscription out;
+
+  /// Buffers results from the worker until the observer requests them.
+  std::deque<U> buf;
+
+  /// Stores whether the worker has finished sending results.
+  bool done = false;
+
+  U pop() {
+    auto result = std::move(buf.front());
+    buf.pop_front();
+    return result;
+  }
+};
+
+/// Dispatches inputs to a set of workers and merges their outputs.
+template <class T, class U>
+class parallel_sub : public subscription::impl_base,
+                     public observer_impl<T>,
+                     public pullable {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using shard_type = parallel_shard<T, U, parallel_sub>;
+
+  using writer_type = parallel_shard_writer<parallel_sub>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  parallel_sub(coordinator* parent, observer<U> out, parallel_order order,
+               size_t max_pending_per_shard)
+    : parent_(parent),
+      out_(std::move(out)),
+      order_(order),
+      max_pending_(max_pending_per_shard) {
+    // nop
+  }
+
+  // -- initialization ---------------------------------------------------------
+
+  /// Connects this subscription to the buffers of all workers.
+  void init(std::vector<async::producer_resource<T>>& inputs,
+            std::vector<async::consumer_resource<U>>& outputs) {
+    CAF_ASSERT(inputs.size() == outputs.size());
+    shards_.resize(inputs.size());
+    for (size_t index = 0; index < shards_.size(); ++index) {
+      auto& shard = shards_[index];
+      shard.in = inputs[index].try_open();
+      CAF_ASSERT(shard.in != nullptr);
+      shard.writer = make_counted<writer_type>(parent_, this, index);
+      shard.in->set_producer(shard.writer);
+    }
+    for (size_t index = 0; index < shards_.size(); ++index) {
+      using fwd_impl = forwarder<U, parallel_sub, size_t>;
+      auto fwd = parent_->add_child(std::in_place_type<fwd_impl>, this, index);
+      auto src = parent_->add_child(std::in_place_type<from_resource<U>>,
+                                    std::move(outputs[index]));
+      src->subscribe(fwd->as_observer());
+    }
+  }
+
+  // -- implementation of observer_impl<T> -------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  void on_next(const T& item) override {
+    if (!sub_)
+      return;
+    if (in_flight_ > 0)
+      --in_flight_;
+    auto& shard = shards_[select_shard()];
+    if (shard.in_demand > 0)
+      --shard.in_demand;
+    shard.in->push(item);
+  }
+
+  void on_complete() override {
+    sub_.release_later();
+    close_inputs(error{});
+  }
+
+  void on_error(const error& what) override {
+    // Route the error through the workers to make sure that all previous items
+    // reach the observer first. The workers process their remaining inputs
+    // before forwarding the error, and `fwd_on_error` emits all buffered
+    // results before passing the error to the observer.
+    sub_.release_later();
+    close_inputs(what);
+  }
+
+  void on_subscribe(subscription sub) override {
+    if (!sub_ && out_ && !inputs_closed_) {
+      sub_ = std::move(sub);
+      request_inputs();
+    } else {
+      sub.cancel();
+    }
+  }
+
+  // -- reference counting -----------------------------------------------------
+
+  void ref_coordinated() const noexcept final {
+    ref();
+  }
+
+  void deref_coordinated() const noexcept final {
+    deref();
+  }
+
+  friend void intrusive_ptr_add_ref(const parallel_sub* ptr) noexcept {
+    ptr->ref();
+  }
+
+  friend void intrusive_ptr_release(const parallel_sub* ptr) noexcept {
+    ptr->deref();
+  }
+
+  // -- callbacks for the shard writers ----------------------------------------
+
+  void shard_demand(size_t index, size_t n) {
+    shards_[index].in_demand += n;
+    request_inputs();
+  }
+
+  void shard_cancel(size_t) {
+    // Workers only cancel their input if something went wrong, e.g., when the
+    // worker actor terminated unexpectedly.
+    abort(make_error(sec::runtime_error, "parallel: lost a worker"));
+  }
+
+  // -- callbacks for the forwarders -------------------------------------------
+
+  void fwd_on_subscribe(size_t index, subscription sub) {
+    auto& shard = shards_[index];
+    if (out_ && !shard.out && !shard.done) {
+      shard.out = std::move(sub);
+      shard.out.request(max_pending_);
+    } else {
+      sub.cancel();
+    }
+  }
+
+  void fwd_on_complete(size_t index) {
+    auto& shard = shards_[index];
+    shard.done = true;
+    shard.out.release_later();
+    if (out_ && !this->is_pulling())
+      emit();
+  }
+
+  void fwd_on_error(size_t index, const error& what) {
+    // Stop dispatching inputs, but keep the results of all other workers. We
+    // forward the error once `emit` reaches the end of the flow.
+    auto& shard = shards_[index];
+    shard.done = true;
+    shard.out.release_later();
+    if (!err_)
+      err_ = what;
+    sub_.cancel();
+    close_inputs(what);
+    if (out_ && !this->is_pulling())
+      emit();
+  }
+
+  void fwd_on_next(size_t index, const U& item) {
+    if (!out_)
+      return;
+    shards_[index].buf.push_back(item);
+    ++buffered_;
+    if (demand_ > 0 && !this->is_pulling())
+      emit();
+  }
+
+  // -- implementation of subscription_impl ------------------------------------
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    if (!out_)
+      return;
+    if (buffered_ == 0)
+      demand_ += n;
+    else
+      this->pull(parent_, n);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t num_shards() const noexcept {
+    return shards_.size();
+  }
+
+  size_t buffered() const noexcept {
+    return buffered_;
+  }
+
+private:
+  // -- implementation of subscription::impl_base ------------------------------
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    stop_all();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  // -- implementation of pullable ---------------------------------------------
+
+  void do_pull(size_t n) override {
+    demand_ += n;
+    emit();
+  }
+
+  void do_ref() override {
+    this->ref();
+  }
+
+  void do_deref() override {
+    this->deref();
+  }
+
+  // -- input dispatching ------------------------------------------------------
+
+  /// Returns how many items we can dispatch to the workers right now.
+  size_t input_credit() const noexcept {
+    if (order_ == parallel_order::ordered) {
+      // Items go to the workers in round-robin order. Hence, we can only
+      // dispatch as many items as the slowest worker allows.
+      auto less = [](const shard_type& x, const shard_type& y) {
+        return x.in_demand < y.in_demand;
+      };
+      auto i = std::min_element(shards_.begin(), shards_.end(), less);
+      return i->in_demand * shards_.size();
+    }
+    size_t result = 0;
+    for (auto& shard : shards_)
+      result += shard.in_demand;
+    return result;
+  }
+
+  void request_inputs() {
+    if (!sub_)
+      return;
+    if (auto credit = input_credit(); credit > in_flight_) {
+      sub_.request(credit - in_flight_);
+      in_flight_ = credit;
+    }
+  }
+
+  size_t select_shard() {
+    if (order_ == parallel_order::ordered) {
+      auto result = next_in_;
+      next_in_ = (next_in_ + 1) % shards_.size();
+      return result;
+    }
+    // Pick the worker with the most demand, i.e., the least busy one.
+    auto result = next_in_;
+    for (size_t offset = 1; offset < shards_.size(); ++offset) {
+      auto index = (next_in_ + offset) % shards_.size();
+      if (shards_[index].in_demand > shards_[result].in_demand)
+        result = index;
+    }
+    next_in_ = (result + 1) % shards_.size();
+    return result;
+  }
+
+  void close_inputs(const error& reason) {
+    if (inputs_closed_)
+      return;
+    inputs_closed_ = true;
+    for (auto& shard : shards_) {
+      shard.writer->release();
+      if (reason)
+        shard.in->abort(reason);
+      else
+        shard.in->close();
+      shard.in = nullptr;
+    }
+  }
+
+  // -- output merging ---------------------------------------------------------
+
+  /// Returns the index of the next shard for emitting an item or
+  /// `shards_.size()` if no shard has any item.
+  size_t next_output() {
+    if (order_ == parallel_order::ordered)
+      return shards_[next_out_].buf.empty() ? shards_.size() : next_out_;
+    for (size_t offset = 0; offset < shards_.size(); ++offset) {
+      auto index = (next_out_ + offset) % shards_.size();
+      if (!shards_[index].buf.empty())
+        return index;
+    }
+    return shards_.size();
+  }
+
+  bool done() const noexcept {
+    if (order_ == parallel_order::ordered) {
+      // Since inputs go to the workers in round-robin order, the flow ends as
+      // soon as the next worker in line runs out of items.
+      auto& shard = shards_[next_out_];
+      return shard.done && shard.buf.empty();
+    }
+    auto at_end = [](const shard_type& x) { return x.done && x.buf.empty(); };
+    return std::all_of(shards_.begin(), shards_.end(), at_end);
+  }
+
+  void emit() {
+    while (out_ && demand_ > 0) {
+      auto index = next_output();
+      if (index == shards_.size())
+        break;
+      auto& shard = shards_[index];
+      auto item = shard.pop();
+      --demand_;
+      --buffered_;
+      next_out_ = (index + 1) % shards_.size();
+      if (shard.out)
+        shard.out.request(1);
+      // Call the observer. This might nuke out_ by calling dispose().
+      out_.on_next(item);
+    }
+    if (out_ && done()) {
+      stop_all();
+      if (err_)
+        out_.on_error(err_);
+      else
+        out_.on_complete();
+    }
+  }
+
+  // -- error handling ---------------------------------------------------------
+
+  void abort(const error& reason) {
+    if (!out_)
+      return;
+    stop_all();
+    out_.on_error(reason);
+  }
+
+  void stop_all() {
+    sub_.cancel();
+    close_inputs(make_error(sec::disposed));
+    for (auto& shard : shards_) {
+      shard.out.cancel();
+      buffered_ -= shard.buf.size();
+      shard.buf.clear();
+    }
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Stores the context (coordinator) that runs this flow.
+  coordinator* parent_;
+
+  /// Stores a handle to the subscriber.
+  observer<U> out_;
+
+  /// Selects whether we preserve the order of the inputs.
+  parallel_order order_;
+
+  /// Configures how many results we buffer per worker at most.
+  size_t max_pending_;
+
+  /// Subscription to the input observable.
+  subscription sub_;
+
+  /// Stores the state for all workers.
+  std::vector<shard_type> shards_;
+
+  /// Stores how many items we have requested from the input but did not
+  /// receive yet.
+  size_t in_flight_ = 0;
+
+  /// Stores whether we have closed the input buffers of the workers.
+  bool inputs_closed_ = false;
+
+  /// Stores our current demand for items from the subscriber.
+  size_t demand_ = 0;
+
+  /// Stores how many results are buffered in total.
+  size_t buffered_ = 0;
+
+  /// Stores the index of the worker for the next input.
+  size_t next_in_ = 0;
+
+  /// Stores the index of the worker for the next output.
+  size_t next_out_ = 0;
+
+  /// Stores the first error of a worker until we have emitted all results
+  /// that precede it.
+  error err_;
+};
+
+/// Spreads the work for transforming items over a set of workers that run
+/// concurrently to the coordinator. The workers connect to the operator via
+/// SPSC buffers, i.e., each worker applies backpressure individually.
+template <class T, class U>
+class parallel : public hot<U> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = hot<U>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  parallel(coordinator* parent, observable<T> input, parallel_order order,
+           size_t max_pending_per_shard,
+           std::vector<async::producer_resource<T>> inputs,
+           std::vector<async::consumer_resource<U>> outputs)
+    : super(parent),
+      input_(std::move(input)),
+      order_(order),
+      max_pending_(max_pending_per_shard),
+      inputs_(std::move(inputs)),
+      outputs_(std::move(outputs)) {
+    // nop
+  }
+
+  // -- implementation of observable_impl<U> -----------------------------------
+
+  disposable subscribe(observer<U> out) override {
+    if (!input_) {
+      return super::fail_subscription(
+        out, make_error(sec::too_many_observers,
+                        "may only subscribe once to a parallel operator"));
+    }
+    using impl_t = parallel_sub<T, U>;
+    auto sub = super::parent_->add_child(std::in_place_type<impl_t>, out,
+                                         order_, max_pending_);
+    sub->init(inputs_, outputs_);
+    inputs_.clear();
+    outputs_.clear();
+    out.on_subscribe(subscription{sub});
+    auto input = std::move(input_);
+    input.pimpl()->subscribe(sub->as_observer());
+    return sub->as_disposable();
+  }
+
+private:
+  observable<T> input_;
+
+  parallel_order order_;
+
+  size_t max_pending_;
+
+  std::vector<async::producer_resource<T>> inputs_;
+
+  std::vector<async::consumer_resource<U>> outputs_;
+};
+
+} // namespace caf::flow::op
@@ -0,0 +1,217 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/parallel.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor_registry.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/cow_vector.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/observable_builder.hpp"
+#include "caf/scheduled_actor/flow.hpp"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <numeric>
+
+using namespace caf;
+
+namespace {
+
+struct deterministic_fixture : test::fixture::deterministic {
+  std::vector<int> expected_outputs(int num) {
+    auto result = std::vector<int>(static_cast<size_t>(num));
+    std::iota(result.begin(), result.end(), 1);
+    for (auto& x : result)
+      x *= 2;
+    return result;
+  }
+};
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys;
+
+  fixture() : sys(cfg.set("caf.scheduler.max-threads", 4)) {
+    // nop
+  }
+};
+
+} // namespace
+
+WITH_FIXTURE(test::fixture::flow) {
+
+SCENARIO("parallel operators require at least one worker") {
+  GIVEN("a parallel operator with zero workers") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives an error") {
+        auto twice = [](int x) { return x * 2; };
+        check_eq(collect(range(1, 3).parallel(0, twice)),
+                 sec::invalid_argument);
+        check_eq(collect(range(1, 3).parallel_ordered(0, twice)),
+                 sec::invalid_argument);
+      }
+    }
+  }
+}
+
+SCENARIO("parallel operators fall back to map if there are no workers") {
+  GIVEN("a parallel operator on a coordinator that cannot launch workers") {
+    WHEN("subscribing to it") {
+      THEN("the operator applies the function locally") {
+        auto twice = [](int x) { return x * 2; };
+        check_eq(collect(range(1, 3).parallel(4, twice)),
+                 std::vector<int>({2, 4, 6}));
+        check_eq(collect(range(1, 3).parallel_ordered(4, twice)),
+                 std::vector<int>({2, 4, 6}));
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(test::fixture::flow)
+
+WITH_FIXTURE(deterministic_fixture) {
+
+SCENARIO("parallel operators distribute the work to multiple actors") {
+  GIVEN("a parallel_ordered operator with four workers") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives all results in order") {
+        auto outputs = std::vector<int>{};
+        auto completed = false;
+        sys.spawn([&outputs, &completed](event_based_actor* self) {
+          self->make_observable()
+            .range(1, 1000)
+            .parallel_ordered(4, [](int x) { return x * 2; })
+            .do_on_complete([&completed] { completed = true; })
+            .for_each([&outputs](int x) { outputs.push_back(x); });
+        });
+        dispatch_messages();
+        check(completed);
+        check_eq(outputs, expected_outputs(1000));
+      }
+    }
+  }
+  GIVEN("a parallel operator with four workers") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives all results") {
+        auto outputs = std::vector<int>{};
+        auto completed = false;
+        sys.spawn([&outputs, &completed](event_based_actor* self) {
+          self->make_observable()
+            .range(1, 1000)
+            .parallel(4, [](int x) { return x * 2; })
+            .do_on_complete([&completed] { completed = true; })
+            .for_each([&outputs](int x) { outputs.push_back(x); });
+        });
+        dispatch_messages();
+        check(completed);
+        std::sort(outputs.begin(), outputs.end());
+        check_eq(outputs, expected_outputs(1000));
+      }
+    }
+  }
+  GIVEN("a parallel operator with a single worker") {
+    WHEN("the observer disposes its subscription early") {
+      THEN("the operator stops all workers") {
+        auto outputs = std::vector<int>{};
+        auto running = sys.registry().running();
+        sys.spawn([&outputs](event_based_actor* self) {
+          self->make_observable()
+            .range(1, 1000)
+            .parallel_ordered(1, [](int x) { return x * 2; })
+            .take(10)
+            .for_each([&outputs](int x) { outputs.push_back(x); });
+        });
+        dispatch_messages();
+        check_eq(outputs, expected_outputs(10));
+        check_eq(sys.registry().running(), running);
+      }
+    }
+  }
+}
+
+SCENARIO("parallel operators emit all results before forwarding errors") {
+  GIVEN("a parallel operator with four workers and a failing input") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives all results before the error") {
+        auto outputs = std::vector<int>{};
+        auto err = error{};
+        auto running = sys.registry().running();
+        sys.spawn([&outputs, &err](event_based_actor* self) {
+          self->make_observable()
+            .range(1, 100)
+            .concat(self->make_observable().fail<int>(sec::runtime_error))
+            .parallel(4, [](int x) { return x * 2; })
+            .do_on_error([&err](const error& what) { err = what; })
+            .for_each([&outputs](int x) { outputs.push_back(x); });
+        });
+        dispatch_messages();
+        check_eq(err, sec::runtime_error);
+        std::sort(outputs.begin(), outputs.end());
+        check_eq(outputs, expected_outputs(100));
+        check_eq(sys.registry().running(), running);
+      }
+    }
+  }
+  GIVEN("a parallel_ordered operator with four workers and a failing input") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives all results in order before the error") {
+        auto outputs = std::vector<int>{};
+        auto err = error{};
+        auto running = sys.registry().running();
+        sys.spawn([&outputs, &err](event_based_actor* self) {
+          self->make_observable()
+            .range(1, 100)
+            .concat(self->make_observable().fail<int>(sec::runtime_error))
+            .parallel_ordered(4, [](int x) { return x * 2; })
+            .do_on_error([&err](const error& what) { err = what; })
+            .for_each([&outputs](int x) { outputs.push_back(x); });
+        });
+        dispatch_messages();
+        check_eq(err, sec::runtime_error);
+        check_eq(outputs, expected_outputs(100));
+        check_eq(sys.registry().running(), running);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(deterministic_fixture)
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("parallel operators run their workers concurrently") {
+  GIVEN("a parallel_ordered operator with four workers") {
+    WHEN("running it on a multi-threaded scheduler") {
+      THEN("the observer receives all results in order") {
+        auto result = std::make_shared<std::promise<std::vector<int>>>();
+        auto values = result->get_future();
+        sys.spawn([result](event_based_actor* self) {
+          self->make_observable()
+            .range(1, 10'000)
+            .parallel_ordered(4, [](int x) { return x * 2; })
+            .to_vector()
+            .for_each([result](const cow_vector<int>& values) {
+              result->set_value(values.std());
+            });
+        });
+        auto want = std::vector<int>(10'000);
+        std::iota(want.begin(), want.end(), 1);
+        for (auto& x : want)
+          x *= 2;
+        check_eq(values.get(), want);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
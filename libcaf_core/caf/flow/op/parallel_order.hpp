@@ -0,0 +1,17 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+namespace caf::flow::op {
+
+/// Selects how the @ref parallel operator merges the outputs of its workers.
+enum class parallel_order {
+  /// Emits results in the order of their inputs.
+  ordered,
+  /// Emits results as soon as they become available.
+  unordered,
+};
+
+} // namespace caf::flow::op
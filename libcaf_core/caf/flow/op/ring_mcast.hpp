@@ -0,0 +1,408 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/assert.hpp"
+#include "caf/flow/coordinator.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/hot.hpp"
+#include "caf/flow/op/pullable.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace caf::flow::op {
+
+/// Configures how a @ref ring_mcast handles subscribers that fall behind by
+/// more items than the ring buffer can hold.
+enum class ring_overflow_policy {
+  /// Rejects new items until the slowest subscriber has received the oldest
+  /// item in the ring buffer.
+  backpressure,
+  /// Disconnects the slowest subscribers with `sec::backpressure_overflow` to
+  /// make room for new items.
+  drop,
+  /// Overwrites the oldest item in the ring buffer. Subscribers that fall
+  /// behind skip all items that have been overwritten.
+  skip,
+};
+
+template <class T>
+class ring_mcast;
+
+/// The subscription of a single observer to a @ref ring_mcast. Instead of
+/// buffering items, each subscription only keeps a read cursor into the ring
+/// buffer of the operator.
+template <class T>
+class ring_mcast_sub : public subscription::impl_base, public pullable {
+public:
+  // -- friends ----------------------------------------------------------------
+
+  friend class ring_mcast<T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ring_mcast_sub(coordinator* parent, ring_mcast<T>* owner, observer<T> out,
+                 uint64_t cursor)
+    : parent_(parent), owner_(owner), out_(std::move(out)), cursor_(cursor) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the sequence number of the next item for the observer.
+  uint64_t cursor() const noexcept {
+    return cursor_;
+  }
+
+  /// Returns the number of items that the observer has requested but not yet
+  /// received.
+  size_t demand() const noexcept {
+    return demand_;
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    if (!out_)
+      return;
+    // We only need to schedule a call to do_pull if there are items waiting
+    // for the observer. Otherwise, we can simply increment the demand.
+    if (owner_ != nullptr && !owner_->has_items_for(*this)) {
+      demand_ += n;
+      return;
+    }
+    this->pull(parent_, n);
+  }
+
+private:
+  // -- implementation of subscription::impl_base ------------------------------
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    if (owner_ != nullptr) {
+      auto* owner = owner_;
+      owner_ = nullptr;
+      owner->remove(this);
+    }
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  // -- implementation of pullable ---------------------------------------------
+
+  void do_pull(size_t n) override {
+    if (!out_)
+      return;
+    demand_ += n;
+    if (owner_ != nullptr)
+      owner_->deliver(*this);
+  }
+
+  void do_ref() override {
+    this->ref();
+  }
+
+  void do_deref() override {
+    this->deref();
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Our scheduling context.
+  coordinator* parent_;
+
+  /// Points to the operator. We hold a non-owning pointer, because the
+  /// operator owns its subscriptions.
+  ring_mcast<T>* owner_;
+
+  /// The observer for the items.
+  observer<T> out_;
+
+  /// The sequence number of the next item for the observer.
+  uint64_t cursor_;
+
+  /// The number of items that the observer has requested but not yet received.
+  size_t demand_ = 0;
+};
+
+template <class T>
+using ring_mcast_sub_ptr = intrusive_ptr<ring_mcast_sub<T>>;
+
+/// A *hot* operator that multicasts items to any number of observers. Unlike
+/// @ref mcast, this operator stores each item only once in a ring buffer of
+/// fixed capacity and each subscription only keeps a read cursor.
+template <class T>
+class ring_mcast : public hot<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = hot<T>;
+
+  using sub_type = ring_mcast_sub<T>;
+
+  using sub_ptr = ring_mcast_sub_ptr<T>;
+
+  using observer_type = observer<T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ring_mcast(coordinator* parent, size_t capacity, ring_overflow_policy policy)
+    : super(parent), ring_(std::max(capacity, size_t{1})), policy_(policy) {
+    // nop
+  }
+
+  ~ring_mcast() override {
+    for (auto& sub : subs_) {
+      if (sub) {
+        sub->owner_ = nullptr;
+        sub->out_.release_later();
+      }
+    }
+  }
+
+  // -- broadcasting -----------------------------------------------------------
+
+  /// Pushes `item` to all subscribers. Drops the item if no subscriber exists.
+  /// @returns `true` if the operator accepted the item, `false` if the ring
+  ///          buffer is full and the operator uses the `backpressure` policy.
+  bool push(const T& item) {
+    if (closed_)
+      return false;
+    if (subs_.empty())
+      return true;
+    if (full()) {
+      switch (policy_) {
+        case ring_overflow_policy::backpressure:
+          return false;
+        case ring_overflow_policy::drop:
+          drop_slowest();
+          break;
+        case ring_overflow_policy::skip:
+          // Nothing to do: we simply overwrite the oldest item.
+          break;
+      }
+    }
+    ring_[head_ % ring_.size()] = item;
+    ++head_;
+    for_each_sub([this](sub_type& sub) { deliver(sub); });
+    return true;
+  }
+
+  /// Closes the operator, eventually emitting on_complete on all observers.
+  void close() {
+    if (!closed_) {
+      closed_ = true;
+      for_each_sub([this](sub_type& sub) { deliver(sub); });
+    }
+  }
+
+  /// Closes the operator, eventually emitting on_error on all observers.
+  void abort(const error& reason) {
+    if (!closed_) {
+      closed_ = true;
+      err_ = reason;
+      for_each_sub([this](sub_type& sub) { deliver(sub); });
+    }
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the capacity of the ring buffer.
+  size_t capacity() const noexcept {
+    return ring_.size();
+  }
+
+  /// Returns the configured policy for slow subscribers.
+  ring_overflow_policy policy() const noexcept {
+    return policy_;
+  }
+
+  /// Returns how many items the operator may accept before the ring buffer
+  /// becomes full.
+  size_t free_capacity() const noexcept {
+    return ring_.size() - buffered();
+  }
+
+  /// Returns how many items the slowest subscriber has yet to receive.
+  size_t buffered() const noexcept {
+    return static_cast<size_t>(head_ - std::max(min_cursor(), tail()));
+  }
+
+  /// Returns the minimum demand of all subscribers.
+  size_t min_demand() const noexcept {
+    auto result = std::numeric_limits<size_t>::max();
+    for (auto& sub : subs_)
+      if (sub)
+        result = std::min(result, sub->demand_);
+    return subs_.empty() ? 0 : result;
+  }
+
+  /// Queries whether there is at least one observer subscribed to the operator.
+  bool has_observers() const noexcept {
+    return !subs_.empty();
+  }
+
+  /// Queries the current number of subscribed observers.
+  size_t observer_count() const noexcept {
+    return subs_.size();
+  }
+
+  // -- implementation of observable -------------------------------------------
+
+  /// Adds a new observer to the operator. The observer receives all items that
+  /// the operator receives after the subscription.
+  disposable subscribe(observer_type out) override {
+    if (!closed_) {
+      auto ptr = super::parent_->add_child(std::in_place_type<sub_type>, this,
+                                           out, head_);
+      subs_.push_back(ptr);
+      out.on_subscribe(subscription{ptr});
+      return disposable{std::move(ptr)};
+    }
+    if (!err_)
+      return super::empty_subscription(out);
+    return super::fail_subscription(out, err_);
+  }
+
+  // -- callbacks for the subscriptions ----------------------------------------
+
+  /// @private
+  bool has_items_for(const sub_type& sub) const noexcept {
+    return sub.cursor_ < head_ || closed_;
+  }
+
+  /// Emits items to `sub` as long as it has demand and completes it after the
+  /// operator has been closed and `sub` has received all items.
+  /// @private
+  void deliver(sub_type& sub) {
+    // Skip items that we have overwritten in the meantime.
+    sub.cursor_ = std::max(sub.cursor_, tail());
+    while (sub.demand_ > 0 && sub.cursor_ < head_) {
+      --sub.demand_;
+      auto& item = *ring_[sub.cursor_ % ring_.size()];
+      ++sub.cursor_;
+      sub.out_.on_next(item);
+      // Note: on_next may dispose the subscription.
+      if (!sub.out_)
+        return;
+    }
+    if (closed_ && sub.cursor_ == head_) {
+      auto out = std::move(sub.out_);
+      sub.owner_ = nullptr;
+      remove(&sub);
+      if (!err_)
+        out.on_complete();
+      else
+        out.on_error(err_);
+    }
+  }
+
+  /// Removes `sub` from the list of subscriptions.
+  /// @private
+  void remove(sub_type* sub) {
+    auto i = std::find(subs_.begin(), subs_.end(), sub);
+    if (i == subs_.end())
+      return;
+    if (iterating_) {
+      // Erasing the element would invalidate the loop in for_each_sub.
+      i->reset();
+      return;
+    }
+    subs_.erase(i);
+  }
+
+private:
+  /// Returns the sequence number of the oldest item in the ring buffer.
+  uint64_t tail() const noexcept {
+    return head_ > ring_.size() ? head_ - ring_.size() : 0;
+  }
+
+  /// Returns the smallest cursor of all subscribers.
+  uint64_t min_cursor() const noexcept {
+    auto result = head_;
+    for (auto& sub : subs_)
+      if (sub)
+        result = std::min(result, sub->cursor_);
+    return result;
+  }
+
+  bool full() const noexcept {
+    if (policy_ == ring_overflow_policy::skip)
+      return false;
+    return head_ - std::max(min_cursor(), tail()) >= ring_.size();
+  }
+
+  /// Disconnects all subscribers that still need the oldest item.
+  void drop_slowest() {
+    auto oldest = tail();
+    for_each_sub([this, oldest](sub_type& sub) {
+      if (sub.cursor_ <= oldest) {
+        auto out = std::move(sub.out_);
+        sub.owner_ = nullptr;
+        remove(&sub);
+        out.on_error(make_error(sec::backpressure_overflow));
+      }
+    });
+  }
+
+  /// Calls `fn` for each subscriber. Subscribers may remove themselves while
+  /// iterating.
+  template <class F>
+  void for_each_sub(F fn) {
+    auto was_iterating = iterating_;
+    iterating_ = true;
+    // Note: `fn` may add subscribers, but we only visit the existing ones.
+    auto n = subs_.size();
+    for (size_t i = 0; i < n; ++i) {
+      if (auto ptr = subs_[i]) // Keep the subscription alive while running fn.
+        fn(*ptr);
+    }
+    iterating_ = was_iterating;
+    if (!iterating_)
+      subs_.erase(std::remove(subs_.begin(), subs_.end(), nullptr),
+                  subs_.end());
+  }
+
+  /// Stores the items. The item with sequence number `n` is at `n % capacity`.
+  std::vector<std::optional<T>> ring_;
+
+  /// Stores the sequence number for the next item.
+  uint64_t head_ = 0;
+
+  /// Configures how to handle subscribers that fall behind.
+  ring_overflow_policy policy_;
+
+  /// Stores all active subscriptions.
+  std::vector<sub_ptr> subs_;
+
+  /// Stores whether `for_each_sub` is currently running.
+  bool iterating_ = false;
+
+  /// Stores whether the operator has been closed.
+  bool closed_ = false;
+
+  /// Stores the error for observers after closing the operator.
+  error err_;
+};
+
+} // namespace caf::flow::op
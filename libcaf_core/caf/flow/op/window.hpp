@@ -0,0 +1,542 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/action.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/two_stack_aggregator.hpp"
+#include "caf/flow/coordinator.hpp"
+#include "caf/flow/observable_decl.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/cold.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/timespan.hpp"
+
+#include <deque>
+#include <optional>
+#include <utility>
+
+namespace caf::flow::op {
+
+// -- window policies ----------------------------------------------------------
+
+// All policies share the same interface:
+// - start(now): called once when the subscription starts.
+// - add(item, now, emit): adds an item to the current window(s).
+// - tick(now, emit): called when reaching the deadline.
+// - flush(now, emit): called when the input completes.
+// - deadline(): returns the next point in time when the policy needs a call to
+//   `tick` or `std::nullopt` if the policy has no pending timeout.
+// Policies call `emit` with the aggregate of a window whenever it closes.
+
+/// Returns the end of the period that contains `now` for periods that start at
+/// `t0` and repeat every `period`.
+inline coordinator::steady_time_point
+window_period_end(coordinator::steady_time_point t0, timespan period,
+                  coordinator::steady_time_point now) {
+  auto elapsed = std::chrono::duration_cast<timespan>(now - t0);
+  return t0 + (elapsed / period + 1) * period;
+}
+
+/// Aggregates items into consecutive, non-overlapping windows that close after
+/// receiving `count` items or at the end of each `period`. A zero `count` or
+/// `period` disables the respective limit.
+template <class T, class F>
+class window_tumbling_policy {
+public:
+  using value_type = T;
+
+  using time_point = coordinator::steady_time_point;
+
+  window_tumbling_policy(size_t count, timespan period, F fn)
+    : count_(count), period_(period), fn_(std::move(fn)) {
+    // nop
+  }
+
+  void start(time_point now) {
+    t0_ = now;
+  }
+
+  template <class Emit>
+  void add(const T& item, time_point now, Emit& emit) {
+    if (!acc_) {
+      acc_ = item;
+      if (period_.count() > 0)
+        end_ = window_period_end(t0_, period_, now);
+    } else {
+      acc_ = fn_(std::move(*acc_), item);
+    }
+    if (++size_ == count_)
+      close(emit);
+  }
+
+  template <class Emit>
+  void tick(time_point now, Emit& emit) {
+    if (acc_ && period_.count() > 0 && now >= end_)
+      close(emit);
+  }
+
+  template <class Emit>
+  void flush(time_point, Emit& emit) {
+    if (acc_)
+      close(emit);
+  }
+
+  std::optional<time_point> deadline() const noexcept {
+    if (acc_ && period_.count() > 0)
+      return end_;
+    return std::nullopt;
+  }
+
+private:
+  template <class Emit>
+  void close(Emit& emit) {
+    auto result = std::move(*acc_);
+    acc_.reset();
+    size_ = 0;
+    emit(std::move(result));
+  }
+
+  size_t count_;
+  timespan period_;
+  F fn_;
+  std::optional<T> acc_;
+  size_t size_ = 0;
+  time_point t0_;
+  time_point end_;
+};
+
+/// Aggregates the last `count` items and emits the aggregate after every
+/// `step` items. On completion, emits the aggregate one last time if the
+/// window received items since the last emission.
+template <class T, class F>
+class window_sliding_count_policy {
+public:
+  using value_type = T;
+
+  using time_point = coordinator::steady_time_point;
+
+  window_sliding_count_policy(size_t count, size_t step, F fn)
+    : count_(count), step_(step), items_(std::move(fn)) {
+    // nop
+  }
+
+  void start(time_point) {
+    // nop
+  }
+
+  template <class Emit>
+  void add(const T& item, time_point, Emit& emit) {
+    items_.push(item);
+    if (items_.size() > count_)
+      items_.pop();
+    if (++pending_ == step_) {
+      pending_ = 0;
+      emit(items_.value());
+    }
+  }
+
+  template <class Emit>
+  void tick(time_point, Emit&) {
+    // nop
+  }
+
+  template <class Emit>
+  void flush(time_point, Emit& emit) {
+    if (pending_ > 0) {
+      pending_ = 0;
+      emit(items_.value());
+    }
+  }
+
+  std::optional<time_point> deadline() const noexcept {
+    return std::nullopt;
+  }
+
+private:
+  size_t count_;
+  size_t step_;
+  size_t pending_ = 0;
+  detail::two_stack_aggregator<T, F> items_;
+};
+
+/// Aggregates all items received within the last `length` and emits the
+/// aggregate at the end of each `step` as long as the window is not empty. On
+/// completion, emits the aggregate one last time if the window received items
+/// since the last emission.
+template <class T, class F>
+class window_sliding_time_policy {
+public:
+  using value_type = T;
+
+  using time_point = coordinator::steady_time_point;
+
+  window_sliding_time_policy(timespan length, timespan step, F fn)
+    : length_(length), step_(step), items_(std::move(fn)) {
+    // nop
+  }
+
+  void start(time_point now) {
+    t0_ = now;
+  }
+
+  template <class Emit>
+  void add(const T& item, time_point now, Emit&) {
+    if (items_.empty())
+      next_ = window_period_end(t0_, step_, now);
+    items_.push(item);
+    timestamps_.push_back(now);
+    dirty_ = true;
+  }
+
+  template <class Emit>
+  void tick(time_point now, Emit& emit) {
+    if (items_.empty() || now < next_)
+      return;
+    evict(now);
+    next_ = window_period_end(t0_, step_, now);
+    if (!items_.empty()) {
+      dirty_ = false;
+      emit(items_.value());
+    }
+  }
+
+  template <class Emit>
+  void flush(time_point now, Emit& emit) {
+    evict(now);
+    if (dirty_ && !items_.empty()) {
+      dirty_ = false;
+      emit(items_.value());
+    }
+  }
+
+  std::optional<time_point> deadline() const noexcept {
+    if (!items_.empty())
+      return next_;
+    return std::nullopt;
+  }
+
+private:
+  void evict(time_point now) {
+    while (!timestamps_.empty() && timestamps_.front() + length_ <= now) {
+      timestamps_.pop_front();
+      items_.pop();
+    }
+  }
+
+  timespan length_;
+  timespan step_;
+  detail::two_stack_aggregator<T, F> items_;
+  std::deque<time_point> timestamps_;
+  bool dirty_ = false;
+  time_point t0_;
+  time_point next_;
+};
+
+/// Aggregates items into sessions that close after receiving no new item for
+/// the duration of `gap`.
+template <class T, class F>
+class window_session_policy {
+public:
+  using value_type = T;
+
+  using time_point = coordinator::steady_time_point;
+
+  window_session_policy(timespan gap, F fn) : gap_(gap), fn_(std::move(fn)) {
+    // nop
+  }
+
+  void start(time_point) {
+    // nop
+  }
+
+  template <class Emit>
+  void add(const T& item, time_point now, Emit&) {
+    if (!acc_)
+      acc_ = item;
+    else
+      acc_ = fn_(std::move(*acc_), item);
+    due_ = now + gap_;
+  }
+
+  template <class Emit>
+  void tick(time_point now, Emit& emit) {
+    if (acc_ && now >= due_)
+      flush(now, emit);
+  }
+
+  template <class Emit>
+  void flush(time_point, Emit& emit) {
+    if (acc_) {
+      auto result = std::move(*acc_);
+      acc_.reset();
+      emit(std::move(result));
+    }
+  }
+
+  std::optional<time_point> deadline() const noexcept {
+    if (acc_)
+      return due_;
+    return std::nullopt;
+  }
+
+private:
+  timespan gap_;
+  F fn_;
+  std::optional<T> acc_;
+  time_point due_;
+};
+
+// -- window operator ----------------------------------------------------------
+
+/// The subscription for the window operators.
+template <class Policy>
+class window_sub : public subscription::impl_base,
+                   public observer_impl<typename Policy::value_type> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = typename Policy::value_type;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  window_sub(coordinator* parent, observer<value_type> out, Policy policy)
+    : parent_(parent), out_(std::move(out)), policy_(std::move(policy)) {
+    tick_action_ = make_action([this] { tick(); });
+  }
+
+  ~window_sub() {
+    tick_action_.dispose();
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  bool running() const noexcept {
+    return out_.valid();
+  }
+
+  /// Returns the number of closed windows that wait for demand.
+  size_t pending() const noexcept {
+    return buf_.size();
+  }
+
+  // -- callbacks for the parent -----------------------------------------------
+
+  void init(observable<value_type> vals) {
+    policy_.start(parent_->steady_time());
+    vals.subscribe(this->as_observer());
+  }
+
+  // -- implementation of observer_impl<T> -------------------------------------
+
+  void on_subscribe(subscription sub) override {
+    if (sub_ || !out_) {
+      sub.cancel();
+      return;
+    }
+    sub_ = std::move(sub);
+    request_inputs();
+  }
+
+  void on_next(const value_type& item) override {
+    if (!running())
+      return;
+    if (in_flight_ > 0)
+      --in_flight_;
+    auto emit = emitter();
+    policy_.add(item, parent_->steady_time(), emit);
+    deliver();
+    request_inputs();
+    update_timer();
+  }
+
+  void on_complete() override {
+    if (!running())
+      return;
+    sub_.release_later();
+    completed_ = true;
+    pending_.dispose();
+    auto emit = emitter();
+    policy_.flush(parent_->steady_time(), emit);
+    deliver();
+  }
+
+  void on_error(const error& what) override {
+    err_ = what;
+    on_complete();
+  }
+
+  void ref_coordinated() const noexcept override {
+    this->ref();
+  }
+
+  void deref_coordinated() const noexcept override {
+    this->deref();
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    if (!out_)
+      return;
+    demand_ += n;
+    deliver();
+    request_inputs();
+  }
+
+private:
+  auto emitter() {
+    return [this](value_type item) { buf_.push_back(std::move(item)); };
+  }
+
+  void tick() {
+    pending_ = disposable{};
+    if (!running() || completed_)
+      return;
+    auto emit = emitter();
+    policy_.tick(parent_->steady_time(), emit);
+    deliver();
+    request_inputs();
+    update_timer();
+  }
+
+  void update_timer() {
+    auto due = policy_.deadline();
+    if (!due)
+      return;
+    // An earlier timeout still fires and then re-schedules via `tick`.
+    if (pending_ && scheduled_ <= *due)
+      return;
+    pending_.dispose();
+    scheduled_ = *due;
+    pending_ = parent_->delay_until(*due, tick_action_);
+  }
+
+  void request_inputs() {
+    if (!sub_ || buf_.size() >= defaults::flow::buffer_size)
+      return;
+    auto n = defaults::flow::buffer_size - in_flight_;
+    if (n >= defaults::flow::min_demand) {
+      in_flight_ += n;
+      sub_.request(n);
+    }
+  }
+
+  void deliver() {
+    while (out_ && demand_ > 0 && !buf_.empty()) {
+      --demand_;
+      auto item = std::move(buf_.front());
+      buf_.pop_front();
+      out_.on_next(item);
+    }
+    if (out_ && completed_ && buf_.empty())
+      shutdown();
+  }
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    pending_.dispose();
+    tick_action_.dispose();
+    sub_.cancel();
+    buf_.clear();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  void shutdown() {
+    pending_.dispose();
+    tick_action_.dispose();
+    if (!err_)
+      out_.on_complete();
+    else
+      out_.on_error(err_);
+  }
+
+  /// Stores the context (coordinator) that runs this flow.
+  coordinator* parent_;
+
+  /// Stores a handle to the subscribed observer.
+  observer<value_type> out_;
+
+  /// Assigns items to windows and computes their aggregates.
+  Policy policy_;
+
+  /// Our subscription for the inputs.
+  subscription sub_;
+
+  /// Stores the aggregates of closed windows until the observer requests them.
+  std::deque<value_type> buf_;
+
+  /// Demand signaled by the observer.
+  size_t demand_ = 0;
+
+  /// Number of items we have requested but not yet received.
+  size_t in_flight_ = 0;
+
+  /// Caches the abort reason.
+  error err_;
+
+  /// Stores whether the input has completed.
+  bool completed_ = false;
+
+  /// Handle to the pending timeout.
+  disposable pending_;
+
+  /// Stores the time point of the pending timeout.
+  coordinator::steady_time_point scheduled_;
+
+  /// Action for the pending timeout.
+  action tick_action_;
+};
+
+/// Aggregates items into windows as defined by `Policy`.
+template <class Policy>
+class window : public cold<typename Policy::value_type> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = typename Policy::value_type;
+
+  using super = cold<value_type>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  window(coordinator* parent, observable<value_type> in, Policy policy)
+    : super(parent), in_(std::move(in)), policy_(std::move(policy)) {
+    // nop
+  }
+
+  // -- implementation of observable<T> ----------------------------------------
+
+  disposable subscribe(observer<value_type> out) override {
+    using impl_t = window_sub<Policy>;
+    auto ptr = super::parent_->add_child(std::in_place_type<impl_t>, out,
+                                         policy_);
+    ptr->init(in_);
+    out.on_subscribe(subscription{ptr});
+    return ptr->as_disposable();
+  }
+
+private:
+  /// Sequence of input values.
+  observable<value_type> in_;
+
+  /// Prototype for the policy of each subscription.
+  Policy policy_;
+};
+
+} // namespace caf::flow::op
@@ -0,0 +1,194 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/window.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/multicaster.hpp"
+#include "caf/flow/observable.hpp"
+
+#include <functional>
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct fixture : test::fixture::deterministic, test::fixture::flow {
+  using int_list = std::vector<int>;
+
+  // Runs a time-based window operator on an actor and collects its outputs.
+  template <class Fn>
+  auto spawn_window(caf::flow::multicaster<int>& pub, Fn make_window) {
+    auto outputs = std::make_shared<int_list>();
+    sys.spawn([&pub, outputs, make_window](caf::event_based_actor* self) {
+      make_window(pub.as_observable().observe_on(self))
+        .for_each([outputs](int val) { outputs->emplace_back(val); });
+    });
+    dispatch_messages();
+    return outputs;
+  }
+
+  void push(caf::flow::multicaster<int>& pub, std::initializer_list<int> xs) {
+    pub.push(xs);
+    run_flows();
+    dispatch_messages();
+  }
+
+  void wait(timespan delay) {
+    advance_time(delay);
+    run_flows();
+    dispatch_messages();
+  }
+};
+
+auto concat = [](const std::string& x, const std::string& y) { return x + y; };
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("window operators reject invalid arguments") {
+  GIVEN("a window operator with a zero count or a non-positive duration") {
+    WHEN("subscribing to it") {
+      THEN("the observer receives an error") {
+        check_eq(collect(range(1, 3).window_tumbling(0, std::plus<>{})),
+                 sec::invalid_argument);
+        check_eq(collect(range(1, 3).window_tumbling(0s, std::plus<>{})),
+                 sec::invalid_argument);
+        check_eq(collect(range(1, 3).window_sliding(3, 0, std::plus<>{})),
+                 sec::invalid_argument);
+        check_eq(collect(range(1, 3).window_sliding(0s, 1s, std::plus<>{})),
+                 sec::invalid_argument);
+        check_eq(collect(range(1, 3).window_session(0s, std::plus<>{})),
+                 sec::invalid_argument);
+      }
+    }
+  }
+}
+
+SCENARIO("count-based tumbling windows emit one aggregate per window") {
+  GIVEN("an observable with seven items") {
+    WHEN("calling window_tumbling(3, plus)") {
+      THEN("the observer receives the sum of every three items") {
+        check_eq(collect(range(1, 7).window_tumbling(3, std::plus<>{})),
+                 int_list({6, 15, 7}));
+      }
+    }
+  }
+}
+
+SCENARIO("count-based sliding windows emit the aggregate every step") {
+  GIVEN("an observable with five items") {
+    WHEN("calling window_sliding(3, 1, plus)") {
+      THEN("the observer receives the sum of the last three items") {
+        check_eq(collect(range(1, 5).window_sliding(3, 1, std::plus<>{})),
+                 int_list({1, 3, 6, 9, 12}));
+      }
+    }
+    WHEN("calling window_sliding(3, 2, plus)") {
+      THEN("the observer receives the final window on completion") {
+        check_eq(collect(range(1, 5).window_sliding(3, 2, std::plus<>{})),
+                 int_list({3, 9, 12}));
+      }
+    }
+  }
+  GIVEN("an observable of strings") {
+    WHEN("calling window_sliding(3, 1, concat)") {
+      THEN("the aggregates preserve the order of the items") {
+        auto inputs = std::vector<std::string>{"a", "b", "c", "d", "e"};
+        check_eq(collect(make_observable()
+                           .from_container(inputs)
+                           .window_sliding(3, 1, concat)),
+                 std::vector<std::string>{"a", "ab", "abc", "bcd", "cde"});
+      }
+    }
+  }
+}
+
+SCENARIO("time-based tumbling windows emit one aggregate per period") {
+  GIVEN("an observable") {
+    WHEN("calling window_tumbling(100ms, plus)") {
+      THEN("the observer receives the sum of all items per period") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto outputs = spawn_window(pub, [](auto in) {
+          return in.window_tumbling(100ms, std::plus<>{});
+        });
+        push(pub, {1, 2});
+        check_eq(*outputs, int_list{});
+        wait(100ms);
+        check_eq(*outputs, int_list({3}));
+        wait(100ms);
+        check_eq(*outputs, int_list({3}));
+        push(pub, {4});
+        wait(100ms);
+        check_eq(*outputs, int_list({3, 4}));
+        push(pub, {5, 6});
+        pub.close();
+        run_flows();
+        dispatch_messages();
+        check_eq(*outputs, int_list({3, 4, 11}));
+      }
+    }
+  }
+}
+
+SCENARIO("time-based sliding windows evict items after their length") {
+  GIVEN("an observable") {
+    WHEN("calling window_sliding(200ms, 100ms, plus)") {
+      THEN("the observer receives the sum of all items in the last 200ms") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto outputs = spawn_window(pub, [](auto in) {
+          return in.window_sliding(200ms, 100ms, std::plus<>{});
+        });
+        push(pub, {1});
+        wait(50ms);
+        push(pub, {2});
+        wait(50ms);
+        check_eq(*outputs, int_list({3}));
+        wait(100ms);
+        check_eq(*outputs, int_list({3, 2}));
+        wait(100ms);
+        check_eq(*outputs, int_list({3, 2}));
+        pub.close();
+        run_flows();
+        dispatch_messages();
+      }
+    }
+  }
+}
+
+SCENARIO("session windows close after a period of inactivity") {
+  GIVEN("an observable") {
+    WHEN("calling window_session(50ms, plus)") {
+      THEN("the observer receives the sum of all items per session") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto outputs = spawn_window(pub, [](auto in) {
+          return in.window_session(50ms, std::plus<>{});
+        });
+        push(pub, {1});
+        wait(30ms);
+        push(pub, {2});
+        wait(30ms);
+        check_eq(*outputs, int_list{});
+        wait(30ms);
+        check_eq(*outputs, int_list({3}));
+        push(pub, {4});
+        wait(50ms);
+        check_eq(*outputs, int_list({3, 4}));
+        pub.close();
+        run_flows();
+        dispatch_messages();
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
@@ -0,0 +1,129 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/flow/fwd.hpp"
+#include "caf/flow/observable_decl.hpp"
+#include "caf/flow/op/ring_mcast.hpp"
+#include "caf/intrusive_ptr.hpp"
+
+#include <cstdint>
+
+namespace caf::flow {
+
+/// A multicaster that stores each item only once in a ring buffer of fixed
+/// capacity. Subscribers only keep a read cursor into the ring buffer, which
+/// makes this multicaster a better fit than @ref multicaster for a large
+/// number of subscribers.
+template <class T>
+class ring_multicaster {
+public:
+  using impl_ptr = intrusive_ptr<op::ring_mcast<T>>;
+
+  /// @param parent The coordinator for the multicaster.
+  /// @param capacity The capacity of the ring buffer.
+  /// @param policy Configures how to handle subscribers that fall behind by
+  ///               more than `capacity` items.
+  ring_multicaster(coordinator* parent, size_t capacity,
+                   op::ring_overflow_policy policy
+                   = op::ring_overflow_policy::backpressure) {
+    pimpl_ = parent->add_child(std::in_place_type<op::ring_mcast<T>>, capacity,
+                               policy);
+  }
+
+  explicit ring_multicaster(impl_ptr ptr) noexcept : pimpl_(std::move(ptr)) {
+    // nop
+  }
+
+  ring_multicaster(ring_multicaster&&) noexcept = default;
+
+  ring_multicaster& operator=(ring_multicaster&&) noexcept = default;
+
+  ring_multicaster(const ring_multicaster&) = delete;
+
+  ring_multicaster& operator=(const ring_multicaster&) = delete;
+
+  ~ring_multicaster() {
+    if (pimpl_)
+      pimpl_->close();
+  }
+
+  /// Pushes an item to all subscribed observers. The multicaster drops the
+  /// item if no subscriber exists.
+  /// @returns `false` if the ring buffer is full and the multicaster uses the
+  ///          `backpressure` policy, `true` otherwise.
+  bool push(const T& item) {
+    return pimpl_->push(item);
+  }
+
+  /// Pushes the items in range `[first, last)` to all subscribed observers.
+  /// Stops at the first item that the multicaster rejects.
+  /// @returns the number of accepted items.
+  template <class Iterator, class Sentinel>
+  size_t push(Iterator first, Sentinel last) {
+    size_t result = 0;
+    for (; first != last && push(*first); ++first)
+      ++result;
+    return result;
+  }
+
+  /// Pushes the items from the initializer list to all subscribed observers.
+  /// Stops at the first item that the multicaster rejects.
+  /// @returns the number of accepted items.
+  size_t push(std::initializer_list<T> items) {
+    return push(items.begin(), items.end());
+  }
+
+  /// Closes the multicaster, eventually emitting on_complete on all observers.
+  void close() {
+    pimpl_->close();
+  }
+
+  /// Closes the multicaster, eventually emitting on_error on all observers.
+  void abort(const error& reason) {
+    pimpl_->abort(reason);
+  }
+
+  /// Queries the minimum demand of all subscribed observers.
+  size_t demand() const noexcept {
+    return pimpl_->min_demand();
+  }
+
+  /// Queries how many items the slowest observer has yet to receive.
+  size_t buffered() const noexcept {
+    return pimpl_->buffered();
+  }
+
+  /// Queries how many items the multicaster may accept before its ring buffer
+  /// becomes full.
+  size_t free_capacity() const noexcept {
+    return pimpl_->free_capacity();
+  }
+
+  /// Queries whether there is at least one observer subscribed to the operator.
+  bool has_observers() const noexcept {
+    return pimpl_->has_observers();
+  }
+
+  /// Converts the multicaster to an @ref observable.
+  observable<T> as_observable() const {
+    return observable<T>{pimpl_};
+  }
+
+  /// Subscribes a new @ref observer to the output of the multicaster.
+  disposable subscribe(observer<T> out) {
+    return pimpl_->subscribe(out);
+  }
+
+  /// @private
+  op::ring_mcast<T>& impl() {
+    return *pimpl_;
+  }
+
+private:
+  impl_ptr pimpl_;
+};
+
+} // namespace caf::flow
@@ -0,0 +1,166 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/ring_multicaster.hpp"
+
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/nil.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/flow/observable.hpp"
+
+using caf::test::nil;
+using std::vector;
+
+using namespace caf;
+using namespace caf::flow;
+
+namespace {
+
+struct fixture : test::fixture::flow {
+  auto make_sink() {
+    return coordinator()->add_child(
+      std::in_place_type<flow::passive_observer<int>>);
+  }
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("a ring multicaster pushes items to all subscribers") {
+  GIVEN("a ring multicaster with two subscribers") {
+    auto uut = ring_multicaster<int>{coordinator(), 8};
+    auto snk1 = make_sink();
+    auto snk2 = make_sink();
+    uut.subscribe(snk1->as_observer());
+    uut.subscribe(snk2->as_observer());
+    check_eq(uut.impl().observer_count(), 2u);
+    WHEN("pushing items") {
+      THEN("each observer receives the items according to its demand") {
+        check_eq(uut.push({1, 2, 3}), 3u);
+        check_eq(uut.buffered(), 3u);
+        check_eq(uut.free_capacity(), 5u);
+        snk1->sub.request(2);
+        run_flows();
+        check_eq(snk1->buf, vector{1, 2});
+        check_eq(snk2->buf, nil);
+        check_eq(uut.buffered(), 3u);
+        snk2->sub.request(10);
+        run_flows();
+        check_eq(snk2->buf, vector{1, 2, 3});
+        check_eq(uut.buffered(), 1u);
+        check_eq(uut.push({4, 5}), 2u);
+        check_eq(snk2->buf, vector{1, 2, 3, 4, 5});
+        snk1->sub.request(10);
+        run_flows();
+        check_eq(snk1->buf, vector{1, 2, 3, 4, 5});
+        check_eq(uut.buffered(), 0u);
+      }
+    }
+    WHEN("closing the multicaster") {
+      THEN("observers receive on_complete after receiving all items") {
+        check_eq(uut.push({1, 2}), 2u);
+        uut.close();
+        snk1->sub.request(10);
+        run_flows();
+        check_eq(snk1->buf, vector{1, 2});
+        check(snk1->completed());
+        check(!snk2->completed());
+        snk2->sub.request(1);
+        run_flows();
+        check(!snk2->completed());
+        snk2->sub.request(1);
+        run_flows();
+        check_eq(snk2->buf, vector{1, 2});
+        check(snk2->completed());
+        check(!uut.has_observers());
+      }
+    }
+  }
+}
+
+SCENARIO("a ring multicaster applies its policy to slow subscribers") {
+  GIVEN("a ring multicaster with the backpressure policy") {
+    auto uut = ring_multicaster<int>{coordinator(), 3};
+    auto snk1 = make_sink();
+    auto snk2 = make_sink();
+    uut.subscribe(snk1->as_observer());
+    uut.subscribe(snk2->as_observer());
+    WHEN("a subscriber falls behind by more than the capacity") {
+      THEN("the multicaster rejects new items") {
+        snk1->sub.request(10);
+        check_eq(uut.push({1, 2, 3, 4}), 3u);
+        check_eq(uut.free_capacity(), 0u);
+        check_eq(snk1->buf, vector{1, 2, 3});
+        snk2->sub.request(1);
+        run_flows();
+        check_eq(uut.push({4, 5}), 1u);
+        snk2->sub.request(10);
+        run_flows();
+        check_eq(snk1->buf, vector{1, 2, 3, 4});
+        check_eq(snk2->buf, vector{1, 2, 3, 4});
+      }
+    }
+  }
+  GIVEN("a ring multicaster with the drop policy") {
+    auto uut = ring_multicaster<int>{coordinator(), 3,
+                                     op::ring_overflow_policy::drop};
+    auto snk1 = make_sink();
+    auto snk2 = make_sink();
+    uut.subscribe(snk1->as_observer());
+    uut.subscribe(snk2->as_observer());
+    WHEN("a subscriber falls behind by more than the capacity") {
+      THEN("the multicaster disconnects the slow subscriber") {
+        snk1->sub.request(10);
+        check_eq(uut.push({1, 2, 3, 4}), 4u);
+        check_eq(snk1->buf, vector{1, 2, 3, 4});
+        check(snk2->aborted());
+        check_eq(snk2->err, sec::backpressure_overflow);
+        check_eq(uut.impl().observer_count(), 1u);
+      }
+    }
+  }
+  GIVEN("a ring multicaster with the skip policy") {
+    auto uut = ring_multicaster<int>{coordinator(), 3,
+                                     op::ring_overflow_policy::skip};
+    auto snk1 = make_sink();
+    auto snk2 = make_sink();
+    uut.subscribe(snk1->as_observer());
+    uut.subscribe(snk2->as_observer());
+    WHEN("a subscriber falls behind by more than the capacity") {
+      THEN("the slow subscriber skips the overwritten items") {
+        snk1->sub.request(10);
+        check_eq(uut.push({1, 2, 3, 4, 5}), 5u);
+        check_eq(snk1->buf, vector{1, 2, 3, 4, 5});
+        snk2->sub.request(10);
+        run_flows();
+        check_eq(snk2->buf, vector{3, 4, 5});
+      }
+    }
+  }
+}
+
+SCENARIO("a ring multicaster works as an observable") {
+  GIVEN("a ring multicaster") {
+    WHEN("subscribing to it via as_observable") {
+      THEN("the observer receives all items after subscribing") {
+        auto uut = ring_multicaster<int>{coordinator(), 4};
+        auto result = std::make_shared<vector<int>>();
+        uut.as_observable().take(3).for_each(
+          [result](int x) { result->push_back(x); });
+        run_flows();
+        for (int i = 1; i <= 5; ++i) {
+          uut.push(i);
+          run_flows();
+        }
+        check_eq(*result, vector{1, 2, 3});
+        check(!uut.has_observers());
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
@@ -0,0 +1,37 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/fwd.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace caf::flow {
+
+/// Configures the `on_backpressure_spill` operator.
+struct spill_options {
+  /// Maximum number of items the operator keeps in memory.
+  size_t buffer_size = 128;
+
+  /// Path to the segment file for storing overflowing items. The operator
+  /// creates the file when spilling the first item and removes it when the
+  /// flow ends.
+  std::string path;
+
+  /// Maximum size of the segment file in bytes. When reaching this limit, the
+  /// operator reclaims the space of items that it already read back into
+  /// memory and fails with `sec::backpressure_overflow` only if the unread
+  /// items alone exceed the limit. A value of 0 disables the limit.
+  size_t max_disk_bytes = 0;
+
+  /// Optional counter for the number of items written to disk.
+  telemetry::int_counter* spilled = nullptr;
+
+  /// Optional counter for the number of items read back from disk.
+  telemetry::int_counter* replayed = nullptr;
+};
+
+} // namespace caf::flow
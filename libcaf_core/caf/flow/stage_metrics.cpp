@@ -0,0 +1,52 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/stage_metrics.hpp"
+
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <array>
+
+namespace caf::flow {
+
+stage_metrics stage_metrics::make(telemetry::metric_registry& reg,
+                                  std::string_view name) {
+  // Passing a single item through a stage should take micro- rather than
+  // milliseconds. Items that wait in a buffer for a second or longer indicate
+  // a consumer that cannot keep up with its producer.
+  std::array<double, 9> buckets{{
+    .00001, // 10us
+    .0001,  // 100us
+    .0005,  // 500us
+    .001,   // 1ms
+    .01,    // 10ms
+    .1,     // 100ms
+    .5,     // 500ms
+    1.,     // 1s
+    5.,     // 5s
+  }};
+  auto labels = std::array{telemetry::label_view{"name", name}};
+  return {
+    reg.counter_instance("caf.flow", "items-in", labels,
+                         "Number of items a stage received from upstream."),
+    reg.counter_instance("caf.flow", "items-out", labels,
+                         "Number of items a stage emitted to downstream."),
+    reg.histogram_instance<double>(
+      "caf.flow", "processing-time", labels, buckets,
+      "Time the downstream observer of a stage needs to process an item.",
+      "seconds"),
+    reg.histogram_instance<double>(
+      "caf.flow", "buffer-time", labels, buckets,
+      "Time an item waits in the buffer of a stage.", "seconds"),
+    reg.gauge_instance("caf.flow", "demand", labels,
+                       "Number of items requested from a stage."),
+    reg.gauge_instance("caf.flow", "buffered", labels,
+                       "Number of items in the buffer of a stage."),
+  };
+}
+
+} // namespace caf::flow
@@ -0,0 +1,48 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <string_view>
+
+namespace caf::flow {
+
+/// Bundles the metrics for an instrumented stage of a flow. All metrics use
+/// the prefix `caf.flow` and the label dimension *name* (the user-defined name
+/// of the stage).
+struct CAF_CORE_EXPORT stage_metrics {
+  /// Counts how many items the stage received from upstream.
+  telemetry::int_counter* items_in = nullptr;
+
+  /// Counts how many items the stage emitted to downstream.
+  telemetry::int_counter* items_out = nullptr;
+
+  /// Samples how long the downstream observer needs to process an item.
+  telemetry::dbl_histogram* processing_time = nullptr;
+
+  /// Samples how long an item waits in the buffer of the stage before the
+  /// downstream observer requests it.
+  telemetry::dbl_histogram* buffer_time = nullptr;
+
+  /// Tracks how many items the downstream observer requested but did not
+  /// receive yet.
+  telemetry::int_gauge* demand = nullptr;
+
+  /// Tracks how many items the stage currently buffers.
+  telemetry::int_gauge* buffered = nullptr;
+
+  /// Checks whether this object points to actual metric instances.
+  bool enabled() const noexcept {
+    return items_in != nullptr;
+  }
+
+  /// Returns the metric instances for the stage `name` in `reg`.
+  static stage_metrics make(telemetry::metric_registry& reg,
+                            std::string_view name);
+};
+
+} // namespace caf::flow
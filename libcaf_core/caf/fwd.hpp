@@ -115,6 +115,7 @@ class ipv6_address;
 class ipv6_endpoint;
 class ipv6_subnet;
 class json_array;
+class json_cursor;
 class json_object;
 class json_reader;
 class json_value;
@@ -184,6 +185,7 @@ config_option make_config_option(T& storage, std::string_view category,
 
 // -- enums --------------------------------------------------------------------
 
+enum class binary_encoding : uint8_t;
 enum class exit_reason : uint8_t;
 enum class invoke_message_result;
 enum class pec : uint8_t;
@@ -250,6 +252,15 @@ class gauge;
 template <class ValueType>
 class histogram;
 
+template <class ValueType>
+class striped_counter;
+
+template <class ValueType>
+class striped_gauge;
+
+template <class ValueType>
+class striped_histogram;
+
 template <class Type>
 class metric_family_impl;
 
@@ -262,6 +273,12 @@ using dbl_histogram = histogram<double>;
 using int_counter = counter<int64_t>;
 using int_gauge = gauge<int64_t>;
 using int_histogram = histogram<int64_t>;
+using striped_dbl_counter = striped_counter<double>;
+using striped_dbl_gauge = striped_gauge<double>;
+using striped_dbl_histogram = striped_histogram<double>;
+using striped_int_counter = striped_counter<int64_t>;
+using striped_int_gauge = striped_gauge<int64_t>;
+using striped_int_histogram = striped_histogram<int64_t>;
 
 using dbl_counter_family = metric_family_impl<dbl_counter>;
 using dbl_histogram_family = metric_family_impl<dbl_histogram>;
@@ -269,6 +286,12 @@ using dbl_gauge_family = metric_family_impl<dbl_gauge>;
 using int_counter_family = metric_family_impl<int_counter>;
 using int_histogram_family = metric_family_impl<int_histogram>;
 using int_gauge_family = metric_family_impl<int_gauge>;
+using striped_dbl_counter_family = metric_family_impl<striped_dbl_counter>;
+using striped_dbl_gauge_family = metric_family_impl<striped_dbl_gauge>;
+using striped_dbl_histogram_family = metric_family_impl<striped_dbl_histogram>;
+using striped_int_counter_family = metric_family_impl<striped_int_counter>;
+using striped_int_gauge_family = metric_family_impl<striped_int_gauge>;
+using striped_int_histogram_family = metric_family_impl<striped_int_histogram>;
 
 } // namespace telemetry
 
@@ -0,0 +1,168 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/json_cursor.hpp"
+
+#include "caf/detail/json.hpp"
+#include "caf/expected.hpp"
+#include "caf/json_value.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/pec.hpp"
+#include "caf/sec.hpp"
+
+#include <cctype>
+#include <memory_resource>
+
+namespace caf {
+
+namespace {
+
+// Checks whether the parser stopped without any syntax error. Parsing a
+// single value stops with `trailing_character` unless the value is the last
+// entity in the input.
+bool ok(const string_parser_state& ps) {
+  return ps.code <= pec::trailing_character;
+}
+
+// Returns an error for an unexpected character at the current position.
+error unexpected_character(string_parser_state& ps) {
+  ps.code = ps.at_end() ? pec::unexpected_eof : pec::unexpected_character;
+  return ps.error();
+}
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+json_cursor::json_cursor(std::string_view input) noexcept
+  : ps_(input.begin(), input.end()) {
+  ps_.skip_whitespaces();
+}
+
+json_cursor::json_cursor(const string_parser_state& ps) noexcept : ps_(ps) {
+  ps_.code = pec::success;
+  ps_.skip_whitespaces();
+}
+
+// -- properties ---------------------------------------------------------------
+
+bool json_cursor::is_null() const noexcept {
+  return remainder().starts_with("null");
+}
+
+bool json_cursor::is_bool() const noexcept {
+  auto c = ps_.current();
+  return c == 't' || c == 'f';
+}
+
+bool json_cursor::is_number() const noexcept {
+  switch (ps_.current()) {
+    case '+':
+    case '-':
+    case '.':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return true;
+    default:
+      return remainder().starts_with("nan");
+  }
+}
+
+bool json_cursor::is_string() const noexcept {
+  return ps_.current() == '"';
+}
+
+bool json_cursor::is_array() const noexcept {
+  return ps_.current() == '[';
+}
+
+bool json_cursor::is_object() const noexcept {
+  return ps_.current() == '{';
+}
+
+// -- navigation ---------------------------------------------------------------
+
+expected<json_cursor> json_cursor::field(std::string_view key) const {
+  if (!is_object())
+    return make_error(sec::type_clash, "expected a JSON object");
+  auto ps = ps_;
+  ps.next();
+  ps.skip_whitespaces();
+  if (ps.consume('}'))
+    return make_error(sec::no_such_key, "no such member", std::string{key});
+  // Only keys with escape sequences need memory for decoding them.
+  std::pmr::monotonic_buffer_resource buf;
+  for (;;) {
+    if (ps.current() != '"')
+      return unexpected_character(ps);
+    auto name = detail::json::parse_string(ps, &buf);
+    if (!ok(ps))
+      return ps.error();
+    if (!ps.consume(':'))
+      return unexpected_character(ps);
+    if (name == key)
+      return json_cursor{ps};
+    detail::json::skip(ps);
+    if (!ok(ps))
+      return ps.error();
+    if (ps.consume('}'))
+      return make_error(sec::no_such_key, "no such member", std::string{key});
+    if (!ps.consume(','))
+      return unexpected_character(ps);
+    ps.skip_whitespaces();
+  }
+}
+
+expected<json_cursor> json_cursor::at(size_t index) const {
+  if (!is_array())
+    return make_error(sec::type_clash, "expected a JSON array");
+  auto ps = ps_;
+  ps.next();
+  ps.skip_whitespaces();
+  if (ps.consume(']'))
+    return make_error(sec::no_such_key, "index out of range", index);
+  for (size_t pos = 0;; ++pos) {
+    if (pos == index)
+      return json_cursor{ps};
+    detail::json::skip(ps);
+    if (!ok(ps))
+      return ps.error();
+    if (ps.consume(']'))
+      return make_error(sec::no_such_key, "index out of range", index);
+    if (!ps.consume(','))
+      return unexpected_character(ps);
+  }
+}
+
+// -- conversion ---------------------------------------------------------------
+
+expected<std::string_view> json_cursor::raw() const {
+  auto ps = ps_;
+  detail::json::skip(ps);
+  if (!ok(ps))
+    return ps.error();
+  auto str = std::string_view{ps_.i, ps.i};
+  while (!str.empty() && isspace(str.back()))
+    str.remove_suffix(1);
+  return str;
+}
+
+expected<json_value> json_cursor::value() const {
+  auto ps = ps_;
+  auto storage = make_counted<detail::json::storage>();
+  auto root = detail::json::parse_shallow(ps, &storage->buf);
+  if (!ok(ps))
+    return ps.error();
+  return json_value{root, std::move(storage)};
+}
+
+} // namespace caf
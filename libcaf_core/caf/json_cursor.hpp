@@ -0,0 +1,101 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/parser_state.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace caf {
+
+/// Provides on-demand access to a JSON document without parsing it into a
+/// @ref json_value first. A cursor points to a single value in the raw input
+/// and navigating to a field or array element only skips over the values in
+/// front of it without building any nodes. This makes the cursor a good fit
+/// for reading a few fields out of large documents.
+///
+/// Skipped values are checked for syntax errors, but the cursor never checks
+/// the input that follows the value it navigates to. Errors report the line
+/// and column in the original input.
+/// @warning The cursor points into the input. Hence, the input *must* outlive
+///          the cursor and any other cursor or @ref json_value created from it.
+class CAF_CORE_EXPORT json_cursor {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a cursor for an empty input.
+  json_cursor() noexcept = default;
+
+  /// Creates a cursor for the top-level value in `input`.
+  explicit json_cursor(std::string_view input) noexcept;
+
+  json_cursor(const json_cursor&) noexcept = default;
+
+  json_cursor& operator=(const json_cursor&) noexcept = default;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Checks whether the cursor points to a @c null value.
+  bool is_null() const noexcept;
+
+  /// Checks whether the cursor points to a boolean.
+  bool is_bool() const noexcept;
+
+  /// Checks whether the cursor points to a number.
+  bool is_number() const noexcept;
+
+  /// Checks whether the cursor points to a string.
+  bool is_string() const noexcept;
+
+  /// Checks whether the cursor points to a JSON array.
+  bool is_array() const noexcept;
+
+  /// Checks whether the cursor points to a JSON object.
+  bool is_object() const noexcept;
+
+  /// Returns the parser state at the beginning of the value.
+  const string_parser_state& state() const noexcept {
+    return ps_;
+  }
+
+  // -- navigation -------------------------------------------------------------
+
+  /// Returns a cursor to the value of the member `key`. Returns an error if the
+  /// cursor does not point to an object, if the object has no member `key` or
+  /// if the input contains syntax errors before the member.
+  expected<json_cursor> field(std::string_view key) const;
+
+  /// Returns a cursor to the element at `index`. Returns an error if the
+  /// cursor does not point to an array, if the array has no element at `index`
+  /// or if the input contains syntax errors before the element.
+  expected<json_cursor> at(size_t index) const;
+
+  // -- conversion -------------------------------------------------------------
+
+  /// Returns the input of the value at the cursor, excluding any trailing
+  /// whitespace.
+  expected<std::string_view> raw() const;
+
+  /// Parses the value at the cursor. Only builds nodes for the value itself,
+  /// not for any other part of the input.
+  /// @warning The returned @ref json_value may hold pointers into the input.
+  expected<json_value> value() const;
+
+private:
+  explicit json_cursor(const string_parser_state& ps) noexcept;
+
+  /// Returns the input starting at the value.
+  std::string_view remainder() const noexcept {
+    return {ps_.i, ps_.e};
+  }
+
+  /// Points to the first character of the value.
+  string_parser_state ps_;
+};
+
+} // namespace caf
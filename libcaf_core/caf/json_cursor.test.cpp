@@ -0,0 +1,152 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/json_cursor.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/expected.hpp"
+#include "caf/json_object.hpp"
+#include "caf/json_reader.hpp"
+#include "caf/json_value.hpp"
+#include "caf/parser_state.hpp"
+#include "caf/pec.hpp"
+#include "caf/sec.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+constexpr std::string_view doc = R"_({
+  "name": "foo",
+  "padding": {"a": [1, 2.5, "}]", {"b": null}], "c\"d": true},
+  "values": [10, 20, 30],
+  "nested": {"key": "value", "number": 42}
+})_";
+
+template <class T>
+T unbox(expected<T> x) {
+  if (!x)
+    test::runnable::current().fail("{}", to_string(x.error()));
+  return std::move(*x);
+}
+
+} // namespace
+
+TEST("a cursor points to the top-level value") {
+  auto cursor = json_cursor{doc};
+  check(cursor.is_object());
+  check(!cursor.is_array());
+  check(!cursor.is_string());
+  check_eq(unbox(cursor.raw()), doc);
+  check(json_cursor{"  [1, 2]  "}.is_array());
+  check(json_cursor{"null"}.is_null());
+  check(json_cursor{"true"}.is_bool());
+  check(json_cursor{"-1"}.is_number());
+  check(json_cursor{R"("foo")"}.is_string());
+}
+
+TEST("cursors navigate to members of objects") {
+  auto cursor = json_cursor{doc};
+  auto name = unbox(cursor.field("name"));
+  check(name.is_string());
+  check_eq(unbox(name.raw()), R"("foo")"sv);
+  check_eq(unbox(name.value()).to_string(), "foo"sv);
+  auto nested = unbox(cursor.field("nested"));
+  check_eq(unbox(unbox(nested.field("key")).value()).to_string(), "value"sv);
+  check_eq(unbox(unbox(nested.field("number")).value()).to_integer(), 42);
+  auto padding = unbox(cursor.field("padding"));
+  check_eq(unbox(unbox(padding.field("c\"d")).value()).to_bool(), true);
+}
+
+TEST("cursors navigate to elements of arrays") {
+  auto values = unbox(json_cursor{doc}.field("values"));
+  check(values.is_array());
+  check_eq(unbox(unbox(values.at(0)).value()).to_integer(), 10);
+  check_eq(unbox(unbox(values.at(2)).value()).to_integer(), 30);
+  auto arr = unbox(unbox(json_cursor{doc}.field("padding")).field("a"));
+  check_eq(unbox(unbox(arr.at(2)).raw()), R"("}]")"sv);
+  check_eq(unbox(unbox(arr.at(3)).raw()), R"({"b": null})"sv);
+}
+
+TEST("cursors report missing members and type clashes") {
+  auto cursor = json_cursor{doc};
+  check_eq(cursor.field("missing").error(), sec::no_such_key);
+  check_eq(unbox(cursor.field("values")).at(3).error(), sec::no_such_key);
+  check_eq(cursor.at(0).error(), sec::type_clash);
+  check_eq(unbox(cursor.field("name")).field("x").error(), sec::type_clash);
+  check_eq(json_cursor{"{}"}.field("x").error(), sec::no_such_key);
+  check_eq(json_cursor{"[]"}.at(0).error(), sec::no_such_key);
+}
+
+TEST("cursors report syntax errors in skipped values") {
+  auto input = R"({"a": [1, 2,, 3],
+  "b": 1})"sv;
+  check_eq(json_cursor{input}.field("b").error(),
+           parser_state_to_error(pec::unexpected_character, 1, 13));
+  input = R"({"a": 1 "b": 2})"sv;
+  check_eq(json_cursor{input}.field("b").error(),
+           parser_state_to_error(pec::unexpected_character, 1, 9));
+  input = R"({"a": "unterminated)"sv;
+  check_eq(json_cursor{input}.field("b").error(),
+           parser_state_to_error(pec::unexpected_eof, 1, 20));
+}
+
+TEST("cursors only parse the part of the input they navigate to") {
+  // The syntax error after "first" remains undetected, because the cursor
+  // never looks at the input after the member.
+  auto input = R"({"first": [1, 2, 3], "broken": [1,, 2]})"sv;
+  auto first = unbox(json_cursor{input}.field("first"));
+  check_eq(unbox(first.raw()), "[1, 2, 3]"sv);
+  check_eq(json_cursor{input}.field("missing").error(),
+           parser_state_to_error(pec::unexpected_character, 1, 35));
+}
+
+TEST("cursors find members at the end of large documents") {
+  auto input = "{"s;
+  for (auto i = 0; i < 1000; ++i) {
+    input += R"("key)";
+    input += std::to_string(i);
+    input += R"(": {"text": "lorem ipsum dolor sit amet \"quoted\"",)";
+    input += R"( "numbers": [1, 2.5, -3e4], "flag": false}, )";
+  }
+  input += R"("last": {"x": 1, "y": 2}})";
+  auto last = unbox(json_cursor{input}.field("last"));
+  check_eq(unbox(last.raw()), R"({"x": 1, "y": 2})"sv);
+  auto val = unbox(json_value::parse(input));
+  check(unbox(last.value()) == val.to_object().value("last"));
+  auto key = unbox(unbox(json_cursor{input}.field("key999")).field("numbers"));
+  check_eq(unbox(key.raw()), "[1, 2.5, -3e4]"sv);
+}
+
+TEST("JSON readers deserialize values at a cursor") {
+  auto input = R"({"skipped": [{"a": 1}],
+                   "xs": [1, 2, 3],
+                   "dict": {"a": "A", "b": "B"}})"sv;
+  auto cursor = json_cursor{input};
+  json_reader reader;
+  SECTION("deserializing a list") {
+    auto xs = std::vector<int32_t>{};
+    check(reader.load(unbox(cursor.field("xs"))));
+    check(reader.apply(xs));
+    check_eq(xs, std::vector<int32_t>{1, 2, 3});
+  }
+  SECTION("deserializing a dictionary") {
+    auto dict = std::map<std::string, std::string>{};
+    check(reader.load(unbox(cursor.field("dict"))));
+    check(reader.apply(dict));
+    check_eq(dict,
+             std::map<std::string, std::string>{{"a", "A"}, {"b", "B"}});
+  }
+  SECTION("loading a value with syntax errors") {
+    check(!reader.load(json_cursor{"[1, 2,]"}));
+    check_eq(reader.get_error(),
+             parser_state_to_error(pec::unexpected_character, 1, 7));
+  }
+}
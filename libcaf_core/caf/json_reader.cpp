@@ -12,6 +12,7 @@
 #include "caf/detail/json.hpp"
 #include "caf/format_to_error.hpp"
 #include "caf/internal/fast_pimpl.hpp"
+#include "caf/json_cursor.hpp"
 #include "caf/string_algorithms.hpp"
 
 #include <fstream>
@@ -250,6 +251,25 @@ public:
     return true;
   }
 
+  bool load(const json_cursor& cursor) {
+    reset();
+    auto ps = cursor.state();
+    root_ = detail::json::parse_shallow(ps, &buf_);
+    // The value at the cursor usually has trailing characters, e.g., the
+    // closing brace of the enclosing object.
+    if (ps.code > pec::trailing_character) {
+      err_ = ps.error();
+      st_ = nullptr;
+      return false;
+    }
+    err_.reset();
+    std::pmr::polymorphic_allocator<stack_type> alloc{&buf_};
+    st_ = new (alloc.allocate(1)) stack_type(alloc);
+    st_->reserve(16);
+    st_->emplace_back(root_);
+    return true;
+  }
+
   bool load_bytes(const_byte_span bytes) override {
     auto utf8 = to_string_view(bytes);
     return load(utf8);
@@ -959,6 +979,10 @@ bool json_reader::load(std::string_view json_text) {
   return impl::cast(impl_).load(json_text);
 }
 
+bool json_reader::load(const json_cursor& cursor) {
+  return impl::cast(impl_).load(cursor);
+}
+
 bool json_reader::load_bytes(const_byte_span bytes) {
   return impl::cast(impl_).load_bytes(bytes);
 }
@@ -60,6 +60,16 @@ public:
 
   bool load_bytes(const_byte_span bytes) final;
 
+  /// Parses the value at @p cursor into an internal representation. Only
+  /// parses the value at the cursor, leaving the remaining input untouched.
+  /// This allows deserializing inspectable objects from a small part of a
+  /// large JSON document.
+  /// @warning The internal data structure keeps pointers into the input of
+  ///          @p cursor. Hence, the input must remain valid until either
+  ///          destroying this reader or calling `reset`.
+  /// @note Implicitly calls `reset`.
+  bool load(const json_cursor& cursor);
+
   /// Reads the input stream @p input and parses the content into an internal
   /// representation. After loading the JSON input, the reader is ready for
   /// attempting to deserialize inspectable objects.
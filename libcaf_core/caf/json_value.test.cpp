@@ -11,6 +11,9 @@
 #include "caf/binary_serializer.hpp"
 #include "caf/json_array.hpp"
 #include "caf/json_object.hpp"
+#include "caf/parser_state.hpp"
+
+#include <string>
 
 using namespace caf;
 using namespace std::literals;
@@ -428,6 +431,34 @@ TEST("non-empty object with escaped strings") {
   check_eq(obj.value("escaped-vertical-tab").to_string(), "\v");
 }
 
+TEST("strings with escape sequences at arbitrary positions") {
+  for (size_t len = 0; len < 40; ++len) {
+    for (size_t pos = 0; pos <= len; ++pos) {
+      auto str = std::string(len, 'x');
+      auto want = str;
+      str.insert(pos, R"(\")");
+      want.insert(pos, "\"");
+      auto json = R"({"key": ")" + str + R"("})";
+      auto val = unbox(json_value::parse(json));
+      if (!check_eq(val.to_object().value("key").to_string(), want))
+        return;
+      val = unbox(json_value::parse_in_situ(json));
+      if (!check_eq(val.to_object().value("key").to_string(), want))
+        return;
+    }
+  }
+}
+
+TEST("parsing long strings keeps track of the position in the input") {
+  auto json = R"({"key": ")" + std::string(100, 'x') + "\",\n"
+              + R"( "other": ")" + std::string(40, 'y') + R"(" z})";
+  // The parser counts columns starting at the newline character.
+  auto err_pos = json.find('z');
+  auto column = static_cast<int32_t>(err_pos - json.find('\n') + 1);
+  check_eq(json_value::parse(json).error(),
+           parser_state_to_error(pec::unexpected_character, 2, column));
+}
+
 TEST("in-situ parsing for a non-empty object") {
   std::string json_with_array_and_object = R"_({
     "null-value": null,
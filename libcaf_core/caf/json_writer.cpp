@@ -14,6 +14,8 @@
 #include "caf/internal/json_node.hpp"
 #include "caf/serializer.hpp"
 
+#include <charconv>
+
 namespace caf {
 
 namespace {
@@ -29,13 +31,6 @@ constexpr std::string_view field_type_suffix_default = "-type";
 
 static constexpr const char class_name[] = "caf::json_writer";
 
-char last_non_ws_char(const std::vector<char>& buf) {
-  auto not_ws = [](char c) { return !std::isspace(c); };
-  auto last = buf.rend();
-  auto i = std::find_if(buf.rbegin(), last, not_ws);
-  return (i != last) ? *i : '\0';
-}
-
 class impl : public byte_writer, public internal::fast_pimpl<impl> {
 public:
   // -- member types -----------------------------------------------------------
@@ -65,6 +60,10 @@ public:
     return {buf_.data(), buf_.size()};
   }
 
+  [[nodiscard]] bool streaming() const noexcept {
+    return static_cast<bool>(sink_);
+  }
+
   [[nodiscard]] size_t indentation() const noexcept {
     return indentation_factor_;
   }
@@ -117,6 +116,22 @@ public:
     push();
   }
 
+  void stream_to(json_writer::chunk_sink sink, size_t chunk_size) {
+    CAF_ASSERT(sink != nullptr);
+    CAF_ASSERT(chunk_size > 0);
+    sink_ = std::move(sink);
+    chunk_size_ = chunk_size;
+    flush_chunks();
+  }
+
+  void flush() {
+    flush_chunks();
+    if (sink_ && !buf_.empty()) {
+      sink_(to_const_byte_span(str()));
+      buf_.clear();
+    }
+  }
+
   // -- overrides --------------------------------------------------------------
 
   void set_error(error stop_reason) override {
@@ -299,21 +314,18 @@ public:
     }
     add('[');
     ++indentation_level_;
-    nl();
     return true;
   }
 
   bool end_sequence() override {
+    auto filled = !stack_.empty() && stack_.back().filled;
     if (pop_if(internal::json_node::array)) {
       --indentation_level_;
-      // Check whether the array was empty and compress the output in that case.
-      if (last_non_ws_char(buf_) == '[') {
-        while (std::isspace(buf_.back()))
-          buf_.pop_back();
-      } else {
+      // Empty arrays render as `[]`, because `sep` adds the first newline.
+      if (filled)
         nl();
-      }
       add(']');
+      flush_chunks();
       return true;
     } else {
       return false;
@@ -338,21 +350,18 @@ public:
     }
     add('{');
     ++indentation_level_;
-    nl();
     return true;
   }
 
   bool end_associative_array() override {
+    auto filled = !stack_.empty() && stack_.back().filled;
     if (pop_if(internal::json_node::object)) {
       --indentation_level_;
-      // Check whether the array was empty and compress the output in that case.
-      if (last_non_ws_char(buf_) == '{') {
-        while (std::isspace(buf_.back()))
-          buf_.pop_back();
-      } else {
+      // Empty objects render as `{}`, because `sep` adds the first newline.
+      if (filled)
         nl();
-      }
       add('}');
+      flush_chunks();
       if (!stack_.empty())
         stack_.back().filled = true;
       return true;
@@ -518,17 +527,17 @@ private:
   bool number(T x) {
     switch (top()) {
       case internal::json_node::element:
-        detail::print(buf_, x);
+        add_number(x);
         pop();
         return true;
       case internal::json_node::key:
         add('"');
-        detail::print(buf_, x);
+        add_number(x);
         add("\": ");
         return true;
       case internal::json_node::array:
         sep();
-        detail::print(buf_, x);
+        add_number(x);
         return true;
       default:
         fail(internal::json_node::number);
@@ -673,13 +682,39 @@ private:
     buf_.insert(buf_.end(), str.begin(), str.end());
   }
 
+  // Adds `x` to the output buffer. Renders floating point numbers in their
+  // shortest representation that still parses back to the same value.
+  template <class T>
+  void add_number(T x) {
+    // Large enough for any integer and for the shortest representation of any
+    // floating point number, including 128-bit long double.
+    char tmp[64];
+    auto [last, ec] = std::to_chars(tmp, tmp + sizeof(tmp), x);
+    CAF_ASSERT(ec == std::errc{});
+    buf_.insert(buf_.end(), tmp, last);
+  }
+
+  // Passes all full chunks in the buffer to the sink when streaming.
+  void flush_chunks() {
+    if (!sink_ || buf_.size() < chunk_size_)
+      return;
+    auto n = buf_.size() - buf_.size() % chunk_size_;
+    for (size_t offset = 0; offset < n; offset += chunk_size_)
+      sink_(to_const_byte_span(std::string_view{buf_.data() + offset,
+                                                chunk_size_}));
+    buf_.erase(buf_.begin(), buf_.begin() + static_cast<ptrdiff_t>(n));
+  }
+
   // Adds a separator to the output buffer unless the current entry is empty.
   // The separator is just a comma when in compact mode and otherwise a comma
-  // followed by a newline.
+  // followed by a newline. For the first entry of an array or object, adds
+  // only the newline. Since the writer calls this function before each value,
+  // it also checks whether it should pass buffered output to the sink.
   void sep() {
     CAF_ASSERT(top() == internal::json_node::element
                || top() == internal::json_node::object
                || top() == internal::json_node::array);
+    flush_chunks();
     if (stack_.back().filled) {
       if (indentation_factor_ > 0) {
         add(",\n");
@@ -689,6 +724,8 @@ private:
       }
     } else {
       stack_.back().filled = true;
+      if (stack_.back().t != internal::json_node::element)
+        nl();
     }
   }
 
@@ -706,6 +743,12 @@ private:
   // Buffer for producing the JSON output.
   std::vector<char> buf_;
 
+  // Receives the output in streaming mode.
+  json_writer::chunk_sink sink_;
+
+  // The number of bytes per chunk in streaming mode.
+  size_t chunk_size_ = 0;
+
   struct entry {
     internal::json_node t;
     bool filled;
@@ -765,6 +808,10 @@ std::string_view json_writer::str() const noexcept {
   return impl::cast(impl_).str();
 }
 
+bool json_writer::streaming() const noexcept {
+  return impl::cast(impl_).streaming();
+}
+
 size_t json_writer::indentation() const noexcept {
   return impl::cast(impl_).indentation();
 }
@@ -815,6 +862,14 @@ void json_writer::reset() {
   impl::cast(impl_).reset();
 }
 
+void json_writer::stream_to(chunk_sink sink, size_t chunk_size) {
+  impl::cast(impl_).stream_to(std::move(sink), chunk_size);
+}
+
+void json_writer::flush() {
+  impl::cast(impl_).flush();
+}
+
 // -- overrides ----------------------------------------------------------------
 
 void json_writer::set_error(error stop_reason) {
@@ -9,12 +9,29 @@
 #include "caf/fwd.hpp"
 
 #include <cstddef>
+#include <functional>
 
 namespace caf {
 
 /// Serializes an inspectable object to a JSON-formatted string.
+///
+/// By default, the writer renders the entire output into an internal buffer.
+/// After calling `stream_to`, the writer instead passes its output to a sink
+/// in chunks of fixed size while serializing. This keeps the memory usage of
+/// the writer bounded when rendering large documents, e.g., for sending them
+/// as chunked HTTP response.
 class CAF_CORE_EXPORT json_writer : public byte_writer {
 public:
+  // -- member types -----------------------------------------------------------
+
+  /// Receives chunks of JSON output in streaming mode.
+  using chunk_sink = std::function<void(const_byte_span)>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// The default number of bytes per chunk in streaming mode.
+  static constexpr size_t default_chunk_size = 4096;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   json_writer();
@@ -27,11 +44,16 @@ public:
 
   const_byte_span bytes() const final;
 
-  /// Returns a string view into the internal buffer.
+  /// Returns a string view into the internal buffer. In streaming mode, the
+  /// buffer only contains the output that the writer did not yet pass to the
+  /// sink.
   /// @warning This view becomes invalid when calling any non-const member
   ///          function on the writer object.
   [[nodiscard]] std::string_view str() const noexcept;
 
+  /// Returns whether the writer passes its output to a sink.
+  [[nodiscard]] bool streaming() const noexcept;
+
   /// Returns the current indentation factor.
   [[nodiscard]] size_t indentation() const noexcept;
 
@@ -79,6 +101,17 @@ public:
   /// @warning Invalidates all string views into the buffer.
   void reset() final;
 
+  /// Enables streaming mode. Whenever the internal buffer holds at least
+  /// `chunk_size` bytes, the writer passes full chunks to `sink` and removes
+  /// them from the buffer. The last chunk of a document may be smaller and
+  /// requires an explicit call to `flush`.
+  /// @pre `sink != nullptr && chunk_size > 0`
+  void stream_to(chunk_sink sink, size_t chunk_size = default_chunk_size);
+
+  /// Passes any buffered output to the sink. Does nothing if the writer is
+  /// not in streaming mode.
+  void flush();
+
   // -- overrides --------------------------------------------------------------
 
   void set_error(error stop_reason) final;
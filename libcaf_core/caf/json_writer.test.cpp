@@ -546,6 +546,66 @@ SCENARIO("the JSON writer can render nested lists") {
   }
 }
 
+SCENARIO("the JSON writer renders floating point numbers without loss") {
+  GIVEN("floating point numbers of various magnitudes") {
+    WHEN("converting them to JSON") {
+      THEN("the JSON output uses the shortest round-trip representation") {
+        check_eq(to_json_string(0.1, 0), "0.1"s);
+        check_eq(to_json_string(2.5f, 0), "2.5"s);
+        check_eq(to_json_string(100.0, 0), "100"s);
+        check_eq(to_json_string(1e-9, 0), "1e-09"s);
+        check_eq(to_json_string(123456789.125, 0), "123456789.125"s);
+        check_eq(to_json_string(std::vector<double>{-0.5, 1.0 / 3.0}, 0),
+                 "[-0.5, 0.3333333333333333]"s);
+      }
+    }
+  }
+}
+
+SCENARIO("the JSON writer can pass its output to a sink in chunks") {
+  GIVEN("a writer in streaming mode") {
+    auto xs = std::vector<std::vector<double>>{};
+    for (auto i = 0; i < 100; ++i) {
+      auto& row = xs.emplace_back();
+      for (auto j = 0; j < 100; ++j)
+        row.push_back(i * 1.5 + j * 0.25);
+    }
+    WHEN("serializing a large array") {
+      THEN("the sink receives the same output as the buffered writer") {
+        for (auto indentation : {size_t{0}, size_t{2}}) {
+          auto chunks = std::vector<std::string>{};
+          auto max_buffered = size_t{0};
+          json_writer writer;
+          writer.indentation(indentation);
+          writer.stream_to(
+            [&](const_byte_span bytes) {
+              max_buffered = std::max(max_buffered, writer.str().size());
+              chunks.emplace_back(reinterpret_cast<const char*>(bytes.data()),
+                                  bytes.size());
+            },
+            256);
+          check(writer.streaming());
+          if (!check(writer.apply(xs)))
+            return;
+          writer.flush();
+          check(writer.str().empty());
+          // Each chunk has the configured size, except the last one.
+          require(!chunks.empty());
+          for (size_t i = 0; i + 1 < chunks.size(); ++i)
+            check_eq(chunks[i].size(), 256u);
+          check_le(chunks.back().size(), 256u);
+          // The writer never buffers much more than one chunk.
+          check_lt(max_buffered, 512u);
+          auto joined = std::string{};
+          for (const auto& chunk : chunks)
+            joined += chunk;
+          check_eq(to_json_string(xs, indentation), joined);
+        }
+      }
+    }
+  }
+}
+
 class custom_writer : public json_writer {
 public:
   using super = json_writer;
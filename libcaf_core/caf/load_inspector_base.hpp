@@ -4,11 +4,13 @@
 
 #pragma once
 
+#include "caf/detail/concepts.hpp"
 #include "caf/inspector_access.hpp"
 #include "caf/load_inspector.hpp"
 #include "caf/sec.hpp"
 
 #include <array>
+#include <span>
 #include <tuple>
 #include <utility>
 
@@ -44,6 +46,17 @@ public:
     auto size = size_t{0};
     if (!dref().begin_sequence(size))
       return false;
+    if constexpr (detail::has_bulk_load<Subtype, T>) {
+      // Fast path for contiguous sequences of numbers. Checking the size first
+      // prevents allocating large containers for malformed input.
+      using value_type = typename T::value_type;
+      if (size > dref().template max_remaining<value_type>()) {
+        super::emplace_error(sec::end_of_stream);
+        return false;
+      }
+      xs.resize(size);
+      return dref().values(std::span{xs}) && dref().end_sequence();
+    }
     for (size_t i = 0; i < size; ++i) {
       auto val = typename T::value_type{};
       if (!detail::load(dref(), val))
@@ -0,0 +1,98 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/log/component.hpp"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace caf::log {
+
+namespace {
+
+using id_map = std::map<std::string, size_t, std::less<>>;
+
+using id_map_entry = id_map::value_type;
+
+// Number of slots in the lookup table. Must be a power of two and larger than
+// `max_size` to guarantee that probing always hits an empty slot.
+constexpr size_t table_size = component_registry::max_size * 2;
+
+struct registry_state {
+  std::mutex mtx;
+
+  // Maps names to IDs. The entries of a map have stable addresses, which
+  // allows `names` and `table` to point into the map.
+  id_map ids;
+
+  // Maps IDs to names.
+  std::vector<std::string_view> names;
+
+  // Open-addressing hash table for looking up IDs without locking. Writers
+  // fill slots while holding `mtx`. Since components are never removed, a
+  // slot never changes after becoming non-null.
+  std::array<std::atomic<const id_map_entry*>, table_size> table = {};
+};
+
+registry_state& registry() {
+  static registry_state instance;
+  return instance;
+}
+
+size_t slot_of(std::string_view name) noexcept {
+  return std::hash<std::string_view>{}(name) & (table_size - 1);
+}
+
+} // namespace
+
+size_t component_registry::id_of(std::string_view name) {
+  if (auto id = find(name); id != max_size)
+    return id;
+  auto& state = registry();
+  std::lock_guard guard{state.mtx};
+  if (auto i = state.ids.find(name); i != state.ids.end())
+    return i->second;
+  if (state.names.size() == max_size)
+    return max_size;
+  auto id = state.names.size();
+  auto i = state.ids.emplace(std::string{name}, id).first;
+  state.names.emplace_back(i->first);
+  auto slot = slot_of(name);
+  while (state.table[slot].load(std::memory_order_relaxed) != nullptr)
+    slot = (slot + 1) & (table_size - 1);
+  state.table[slot].store(&*i, std::memory_order_release);
+  return id;
+}
+
+size_t component_registry::find(std::string_view name) noexcept {
+  auto& state = registry();
+  for (auto slot = slot_of(name);; slot = (slot + 1) & (table_size - 1)) {
+    auto* entry = state.table[slot].load(std::memory_order_acquire);
+    if (entry == nullptr)
+      return max_size;
+    if (entry->first == name)
+      return entry->second;
+  }
+}
+
+std::string_view component_registry::name_of(size_t id) {
+  auto& state = registry();
+  std::lock_guard guard{state.mtx};
+  if (id < state.names.size())
+    return state.names[id];
+  return {};
+}
+
+size_t component_registry::size() {
+  auto& state = registry();
+  std::lock_guard guard{state.mtx};
+  return state.names.size();
+}
+
+} // namespace caf::log
@@ -0,0 +1,67 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+
+namespace caf::log {
+
+/// Maps the names of log components to small integers. Loggers use these IDs
+/// to look up the verbosity of a component in an array instead of comparing
+/// the name of the component to a list of filters.
+class CAF_CORE_EXPORT component_registry {
+public:
+  /// The maximum number of components.
+  static constexpr size_t max_size = 256;
+
+  /// Returns the ID for `name`, registering the component on first use.
+  /// Returns `max_size` if the registry is full.
+  static size_t id_of(std::string_view name);
+
+  /// Returns the ID for `name` or `max_size` if no component with this name
+  /// exists. Unlike `id_of`, this function never registers a component and
+  /// never blocks.
+  static size_t find(std::string_view name) noexcept;
+
+  /// Returns the name of the component with given ID or an empty string if no
+  /// component with this ID exists.
+  static std::string_view name_of(size_t id);
+
+  /// Returns the number of registered components.
+  static size_t size();
+};
+
+/// Refers to a log component by its name and its ID in the
+/// `component_registry`. Components without ID use `max_size` as ID.
+struct component_ref {
+  template <class T>
+    requires std::convertible_to<const T&, std::string_view>
+  component_ref(const T& name) noexcept // implicit
+    : name(name), id(component_registry::max_size) {
+    // nop
+  }
+
+  component_ref(std::string_view name, size_t id) noexcept
+    : name(name), id(id) {
+    // nop
+  }
+
+  /// Returns whether this component has a valid ID.
+  bool registered() const noexcept {
+    return id < component_registry::max_size;
+  }
+
+  /// The name of the component.
+  std::string_view name;
+
+  /// The ID of the component.
+  size_t id;
+};
+
+} // namespace caf::log
@@ -0,0 +1,50 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/log/component.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+using log::component_registry;
+
+TEST("the component registry assigns one ID per component name") {
+  auto foo = component_registry::id_of("caf.component-test.foo");
+  auto bar = component_registry::id_of("caf.component-test.bar");
+  check_ne(foo, bar);
+  check_lt(foo, component_registry::max_size);
+  check_lt(bar, component_registry::max_size);
+  check_lt(foo, component_registry::size());
+  check_lt(bar, component_registry::size());
+  check_eq(component_registry::id_of("caf.component-test.foo"s), foo);
+  check_eq(component_registry::name_of(foo), "caf.component-test.foo");
+  check_eq(component_registry::name_of(bar), "caf.component-test.bar");
+  check_eq(component_registry::name_of(component_registry::max_size), "");
+}
+
+TEST("component references without ID fall back to the name") {
+  auto str = "caf.component-test.foo"s;
+  auto ref1 = log::component_ref{str};
+  check_eq(ref1.name, str);
+  check(!ref1.registered());
+  auto ref2 = log::component_ref{"foo", 3};
+  check_eq(ref2.name, "foo");
+  check_eq(ref2.id, 3u);
+  check(ref2.registered());
+}
+
+TEST("looking up a component by name never registers it") {
+  auto name = "caf.component-test.find"sv;
+  auto n = component_registry::size();
+  check_eq(component_registry::find(name), component_registry::max_size);
+  check_eq(component_registry::size(), n);
+  auto id = component_registry::id_of(name);
+  check_eq(component_registry::size(), n + 1);
+  check_eq(component_registry::find(name), id);
+  check_eq(component_registry::find(std::string{name}), id);
+}
@@ -93,6 +93,16 @@ event_ptr event::make(unsigned level, std::string_view component,
   return event;
 }
 
+event_ptr event::make(unsigned level, std::string_view component,
+                      const detail::source_location& loc, caf::actor_id aid,
+                      caf::timestamp ts, std::thread::id tid,
+                      std::string_view msg) {
+  auto event = make(level, component, loc, aid, msg);
+  event->timestamp_ = ts;
+  event->tid_ = tid;
+  return event;
+}
+
 event_ptr event::make(unsigned level, std::string_view component,
                       const detail::source_location& loc, caf::actor_id aid) {
   return make_counted<event>(level, component, loc, aid);
@@ -106,6 +106,13 @@ public:
                         const detail::source_location& loc, caf::actor_id aid,
                         std::string_view msg);
 
+  /// Creates an event for a message that was formatted after the event
+  /// occurred, e.g., by the logger thread.
+  static event_ptr make(unsigned level, std::string_view component,
+                        const detail::source_location& loc, caf::actor_id aid,
+                        caf::timestamp ts, std::thread::id tid,
+                        std::string_view msg);
+
   /// Returns a deep copy of `this` with a new message without changing the
   /// timestamp.
   [[nodiscard]] event_ptr with_message(std::string_view msg,
@@ -7,11 +7,15 @@
 #include "caf/actor_proxy.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
+#include "caf/byte_buffer.hpp"
 #include "caf/config.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/atomic_ref_counted.hpp"
 #include "caf/detail/get_process_id.hpp"
 #include "caf/detail/log_level_map.hpp"
+#include "caf/detail/log_rate_limiter.hpp"
+#include "caf/detail/log_record.hpp"
+#include "caf/detail/log_ring.hpp"
 #include "caf/detail/meta_object.hpp"
 #include "caf/detail/pretty_type_name.hpp"
 #include "caf/detail/set_thread_name.hpp"
@@ -21,21 +25,31 @@
 #include "caf/log/level.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/message.hpp"
+#include "caf/settings.hpp"
 #include "caf/string_algorithms.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 #include "caf/term.hpp"
 #include "caf/thread_owner.hpp"
 #include "caf/timestamp.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
 #include <condition_variable>
 #include <cstring>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace caf {
 
@@ -86,6 +100,20 @@ thread_local actor_id current_actor_id;
 // Stores a pointer to the system-wide logger.
 thread_local intrusive_ptr<logger> current_logger_ptr;
 
+// Generates unique IDs for logger instances.
+std::atomic<uint64_t> logger_id_generator;
+
+// Caches the ring buffer of the calling thread for deferred formatting.
+struct thread_ring_cache {
+  /// The ID of the logger that owns `ring`.
+  uint64_t owner = 0;
+
+  /// The ring buffer of this thread for `owner`.
+  detail::log_ring_ptr ring;
+};
+
+thread_local thread_ring_cache current_thread_ring;
+
 // Default logger implementation.
 class default_logger : public logger, public detail::atomic_ref_counted {
 public:
@@ -94,6 +122,14 @@ public:
   /// Configures the size of the circular event queue.
   static constexpr size_t queue_size = 128;
 
+  /// Configures how long the logger thread sleeps when finding no records in
+  /// the thread buffers while formatting events in the logger thread.
+  static constexpr auto poll_interval = std::chrono::milliseconds{1};
+
+  /// Number of slots per component in the rate limit table. Each of the
+  /// predefined log levels maps to its own slot.
+  static constexpr size_t level_slots = 7;
+
   // -- member types -----------------------------------------------------------
 
   enum field_type {
@@ -132,6 +168,43 @@ public:
 
     /// Configures whether the logger generates colored output.
     bool console_coloring = false;
+
+    /// Configures whether the logger formats events in its own thread. In
+    /// this mode, each thread stores its log records in a ring buffer.
+    bool deferred_formatting = false;
+
+    /// Configures the size of the ring buffer per thread.
+    size_t thread_buffer_size = defaults::logger::thread_buffer_size;
+
+    /// Configures whether the logger writes binary records to the log file.
+    bool binary_file = false;
+
+    /// Configures how often the logger reports suppressed events.
+    timespan summary_interval = defaults::logger::rate_limit_summary_interval;
+  };
+
+  /// Limits the log events for a single component and log level.
+  struct rate_limit {
+    rate_limit(double rate, size_t burst, size_t sample, std::string component,
+               unsigned level, telemetry::int_counter* suppressed)
+      : limiter(rate, burst, sample),
+        component(std::move(component)),
+        level(level),
+        suppressed(suppressed) {
+      // nop
+    }
+
+    /// Decides which events may pass.
+    detail::log_rate_limiter limiter;
+
+    /// The name of the component.
+    std::string component;
+
+    /// The log level of the events.
+    unsigned level;
+
+    /// Counts all suppressed events for the metrics.
+    telemetry::int_counter* suppressed;
   };
 
   /// Represents a single format string field.
@@ -145,7 +218,8 @@ public:
 
   // -- constructors, destructors, and assignment operators --------------------
 
-  default_logger(actor_system& sys) : t0_(make_timestamp()), system_(sys) {
+  default_logger(actor_system& sys)
+    : id_(++logger_id_generator), t0_(make_timestamp()), system_(sys) {
     log_level_names_.set("WARN", log::level::warning);
   }
 
@@ -156,22 +230,82 @@ public:
   void do_log(log::event_ptr&& event) override {
     if (cfg_.inline_output)
       handle_event(*event);
+    else if (cfg_.deferred_formatting)
+      thread_ring()->push(std::move(event));
     else
       queue_.push(std::move(event));
   }
 
+  /// Returns the ring buffer of the calling thread if the logger formats
+  /// events in its own thread.
+  /// @threadsafe
+  detail::log_ring* thread_ring() override {
+    if (!cfg_.deferred_formatting)
+      return nullptr;
+    auto& cache = current_thread_ring;
+    if (cache.owner != id_) {
+      cache.ring = register_thread_ring();
+      cache.owner = id_;
+    }
+    return cache.ring.get();
+  }
+
   // -- properties -------------------------------------------------------------
   /// Returns whether the logger is configured to accept input for given
   /// component and log level.
   bool accepts(unsigned level, std::string_view component_name) override {
     if (level > cfg_.verbosity)
       return false;
+    if (!filter_components_.load(std::memory_order_relaxed))
+      return true;
+    // Never register components here: this function runs on every log call
+    // and must not block. Components without ID have the default verbosity
+    // unless a filter excludes them.
+    auto id = log::component_registry::find(component_name);
+    if (id < log::component_registry::max_size)
+      return level <= component_levels_[id].load(std::memory_order_relaxed);
     return std::none_of(global_filter_.begin(), global_filter_.end(),
                         [=](std::string_view name) {
                           return name == component_name;
                         });
   }
 
+  /// Returns whether the logger is configured to accept input for given
+  /// component and log level.
+  bool accepts_component(unsigned level,
+                         log::component_ref component) override {
+    if (!component.registered())
+      return accepts(level, component.name);
+    return level <= component_levels_[component.id].load(
+             std::memory_order_relaxed);
+  }
+
+  /// Applies the rate limit for `level` and `component`.
+  bool admit(unsigned level, log::component_ref component) override {
+    if (rate_limit_table_ == nullptr)
+      return true;
+    auto id = component.registered()
+                ? component.id
+                : log::component_registry::find(component.name);
+    if (id == log::component_registry::max_size)
+      return true;
+    auto slot = std::min(size_t{level / 100}, level_slots - 1);
+    auto* limit = rate_limit_table_[id * level_slots + slot];
+    return limit == nullptr || limit->limiter.admit();
+  }
+
+  /// Sets the verbosity of `component`, limited to the verbosity of the
+  /// logger.
+  void component_verbosity(std::string_view component,
+                           unsigned level) override {
+    auto id = log::component_registry::id_of(component);
+    if (id == log::component_registry::max_size)
+      return;
+    component_levels_[id].store(std::min(level, cfg_.verbosity),
+                                std::memory_order_relaxed);
+    filter_components_.store(true, std::memory_order_relaxed);
+  }
+
   /// Returns the output format used for the log file.
   const line_format& file_format() const {
     return file_format_;
@@ -334,6 +468,11 @@ public:
       read_filter(console_filter_, "caf.logger.console.excluded-components");
       global_filter_ = console_filter_;
     }
+    // Turn the filter into a lookup table for all registered components.
+    for (size_t id = 0; id < log::component_registry::max_size; ++id)
+      component_levels_[id] = cfg_.verbosity;
+    for (const auto& name : global_filter_)
+      component_verbosity(name, log::level::quiet);
     // Parse the format string.
     file_format_
       = parse_format(get_or(cfg, "caf.logger.file.format", lg::file::format));
@@ -341,16 +480,92 @@ public:
       get_or(cfg, "caf.logger.console.format", lg::console::format));
     // If not set to `false`, CAF enables colored output when writing to TTYs.
     cfg_.console_coloring = get_or(cfg, "caf.logger.console.colored", true);
+    // Formatting events in the logger thread requires a logger thread.
+    cfg_.deferred_formatting = !cfg_.inline_output
+                               && get_or(cfg, "caf.logger.deferred-formatting",
+                                         lg::deferred_formatting);
+    cfg_.thread_buffer_size = get_or(cfg, "caf.logger.thread-buffer-size",
+                                     lg::thread_buffer_size);
+    cfg_.binary_file = get_or(cfg, "caf.logger.file.binary", lg::file::binary);
+    cfg_.summary_interval = get_or(cfg,
+                                   "caf.logger.rate-limit-summary-interval",
+                                   lg::rate_limit_summary_interval);
+    read_rate_limits(content(cfg));
+  }
+
+  /// Reads the rate limits from the list `caf.logger.rate-limits`. Each entry
+  /// is a dictionary with the keys `component`, `level`, `rate`, `burst` and
+  /// `sample`. Omitting the level applies the limit to each level separately.
+  void read_rate_limits(const settings& cfg) {
+    using log::component_registry;
+    auto* rules = get_if<config_value::list>(&cfg, "caf.logger.rate-limits");
+    if (rules == nullptr || rules->empty())
+      return;
+    auto* family = system_.metrics().counter_family(
+      "caf.logger", "suppressed-events", {"component", "level"},
+      "Number of log events that were dropped by rate limits.", "1", true);
+    rate_limit_table_ = std::make_unique<rate_limit*[]>(
+      component_registry::max_size * level_slots);
+    // Note: log_level_names_ uses WARN instead of WARNING.
+    detail::log_level_map level_names;
+    for (const auto& rule_value : *rules) {
+      auto* rule = get_if<settings>(&rule_value);
+      auto component = rule != nullptr ? get_or(*rule, "component", "")
+                                       : std::string{};
+      auto id = component_registry::id_of(component);
+      if (component.empty() || id == component_registry::max_size) {
+        std::cerr << "invalid rate limit: " << to_string(rule_value)
+                  << std::endl;
+        continue;
+      }
+      std::vector<unsigned> levels;
+      if (auto str = get_if<std::string>(rule, "level")) {
+        levels.push_back(level_names.by_name(*str));
+      } else {
+        levels = {log::level::error, log::level::warning, log::level::info,
+                  log::level::debug, log::level::trace};
+      }
+      auto rate = get_or(*rule, "rate", 0.0);
+      auto burst = get_or(*rule, "burst",
+                          static_cast<size_t>(std::max(rate, 1.0)));
+      auto sample = get_or(*rule, "sample", size_t{1});
+      for (auto level : levels) {
+        if (level == log::level::quiet)
+          continue;
+        auto level_name = std::string{level_names[level]};
+        std::transform(level_name.begin(), level_name.end(),
+                       level_name.begin(), [](unsigned char c) {
+                         return static_cast<char>(std::tolower(c));
+                       });
+        auto* suppressed = family->get_or_add(
+          {{"component", component}, {"level", level_name}});
+        auto limit = std::make_unique<rate_limit>(rate, burst, sample,
+                                                  component, level, suppressed);
+        auto slot = std::min(size_t{level / 100}, level_slots - 1);
+        rate_limit_table_[id * level_slots + slot] = limit.get();
+        rate_limits_.push_back(std::move(limit));
+      }
+    }
+    next_summary_ = std::chrono::steady_clock::now() + cfg_.summary_interval;
   }
 
   bool open_file() {
     if (file_verbosity() == log::level::quiet || file_name_.empty())
       return false;
-    file_.open(file_name_, std::ios::out | std::ios::app);
+    if (cfg_.binary_file)
+      file_.open(file_name_,
+                 std::ios::out | std::ios::binary | std::ios::trunc);
+    else
+      file_.open(file_name_, std::ios::out | std::ios::app);
     if (!file_) {
       std::cerr << "unable to open log file " << file_name_ << std::endl;
       return false;
     }
+    if (cfg_.binary_file) {
+      binary_buf_.clear();
+      detail::save_binary_log_header(binary_buf_, t0_);
+      write_binary_buf();
+    }
     return true;
   }
 
@@ -362,23 +577,73 @@ public:
   }
 
   void handle_file_event(const log::event& x) {
-    // Print to file if available.
-    if (file_ && x.level() <= file_verbosity()
-        && none_of(file_filter_.begin(), file_filter_.end(),
-                   [&x](std::string_view name) {
-                     return name == x.component();
-                   }))
-      render(file_, file_format_, x);
+    if (!file_accepts(x.level(), x.component()))
+      return;
+    if (cfg_.binary_file) {
+      std::ostringstream msg;
+      msg << x.message() << fields_formatter{x.fields()};
+      auto str = msg.str();
+      auto loc = detail::source_location::current(
+        x.file_name(), x.function_name(), static_cast<int>(x.line_number()));
+      write_binary(detail::log_record{x.level(), x.component(), loc,
+                                      x.actor_id(), x.timestamp(),
+                                      x.thread_id(), str});
+      return;
+    }
+    render(file_, file_format_, x);
   }
 
   void handle_console_event(const log::event& x) {
-    if (x.level() > console_verbosity())
-      return;
-    if (std::any_of(console_filter_.begin(), console_filter_.end(),
-                    [&x](std::string_view name) {
-                      return name == x.component();
-                    }))
+    if (console_accepts(x.level(), x.component()))
+      print_to_console(x);
+  }
+
+  /// Formats `x` if necessary and writes it to the log file and the console.
+  void handle_record(const detail::log_record& x) {
+    auto to_file = file_accepts(x.level(), x.component());
+    auto to_console = console_accepts(x.level(), x.component());
+    if (to_file && cfg_.binary_file) {
+      // Binary files store the format string and the arguments as-is.
+      write_binary(x);
+      to_file = false;
+    }
+    if (!to_file && !to_console)
       return;
+    auto event = x.to_event();
+    if (to_file)
+      render(file_, file_format_, *event);
+    if (to_console)
+      print_to_console(*event);
+  }
+
+  bool file_accepts(unsigned level, std::string_view component) const {
+    return file_.is_open() && level <= file_verbosity()
+           && std::none_of(file_filter_.begin(), file_filter_.end(),
+                           [component](std::string_view name) {
+                             return name == component;
+                           });
+  }
+
+  bool console_accepts(unsigned level, std::string_view component) const {
+    return level <= console_verbosity()
+           && std::none_of(console_filter_.begin(), console_filter_.end(),
+                           [component](std::string_view name) {
+                             return name == component;
+                           });
+  }
+
+  void write_binary(const detail::log_record& x) {
+    binary_buf_.clear();
+    x.save_binary(binary_buf_);
+    write_binary_buf();
+  }
+
+  void write_binary_buf() {
+    file_.write(reinterpret_cast<const char*>(binary_buf_.data()),
+                static_cast<std::streamsize>(binary_buf_.size()));
+  }
+
+  void print_to_console(const log::event& x) {
     if (cfg_.console_coloring) {
       switch (x.level()) {
         default:
@@ -435,6 +700,7 @@ public:
   }
 
   void log_last_line() {
+    emit_summaries();
     if (!accepts(log::level::debug, log::core::component))
       return;
     auto event = log::event::make(log::level::debug, log::core::component,
@@ -443,8 +709,127 @@ public:
     handle_event(*event);
   }
 
+  // -- thread ring buffers ----------------------------------------------------
+
+  /// Returns the ring buffer of the calling thread, creating a new one if
+  /// necessary.
+  detail::log_ring_ptr register_thread_ring() {
+    auto tid = std::this_thread::get_id();
+    std::unique_lock guard{rings_mtx_};
+    for (auto& ring : rings_)
+      if (ring->thread_id() == tid)
+        return ring;
+    auto ring = make_counted<detail::log_ring>(cfg_.thread_buffer_size);
+    if (rings_closed_)
+      ring->close();
+    rings_.push_back(ring);
+    return ring;
+  }
+
+  /// Returns the ring with the oldest pending record or `nullptr` if all
+  /// rings are empty.
+  static detail::log_ring*
+  next_ring(const std::vector<detail::log_ring_ptr>& rings) {
+    detail::log_ring* result = nullptr;
+    timestamp ts;
+    for (const auto& ring : rings) {
+      if (auto* hdr = ring->front();
+          hdr != nullptr && (result == nullptr || hdr->ts < ts)) {
+        result = ring.get();
+        ts = hdr->ts;
+      }
+    }
+    return result;
+  }
+
+  /// Removes the next record from `ring` and writes it.
+  void handle_next_record(detail::log_ring& ring) {
+    auto* hdr = ring.front();
+    if (hdr->event != nullptr) {
+      auto event = ring.pop();
+      handle_event(*event);
+      return;
+    }
+    handle_record(detail::log_record{*hdr, ring.thread_id()});
+    ring.pop();
+  }
+
+  // -- rate limiting ----------------------------------------------------------
+
+  /// Logs how many events each rate limit suppressed since the last summary
+  /// and adds the numbers to the metrics.
+  void emit_summaries() {
+    for (auto& limit : rate_limits_) {
+      if (auto n = limit->limiter.take_suppressed(); n > 0) {
+        limit->suppressed->inc(static_cast<int64_t>(n));
+        auto event = log::event::make(limit->level, limit->component,
+                                      detail::source_location::current(), 0,
+                                      "suppressed {} log events", n);
+        handle_event(*event);
+      }
+    }
+    next_summary_ = std::chrono::steady_clock::now() + cfg_.summary_interval;
+  }
+
+  /// Returns the next event from the queue. Emits the summaries of the rate
+  /// limits while waiting.
+  log::event_ptr next_event() {
+    if (rate_limits_.empty())
+      return queue_.pop();
+    for (;;) {
+      if (std::chrono::steady_clock::now() >= next_summary_)
+        emit_summaries();
+      if (auto next = queue_.try_pop(next_summary_))
+        return std::move(*next);
+    }
+  }
+
   // -- thread management ------------------------------------------------------
 
+  void run_deferred() {
+    std::vector<detail::log_ring_ptr> rings;
+    auto started = false;
+    for (;;) {
+      auto stopping = stopping_.load();
+      rings.clear();
+      {
+        std::unique_lock guard{rings_mtx_};
+        if (stopping) {
+          rings_closed_ = true;
+          for (auto& ring : rings_)
+            ring->close();
+        }
+        // Drop rings of terminated threads after consuming all records.
+        std::erase_if(rings_, [](const detail::log_ring_ptr& ring) {
+          return ring->unique() && ring->front() == nullptr;
+        });
+        rings = rings_;
+      }
+      // Merge the records of all threads by their timestamps.
+      if (auto* ring = next_ring(rings)) {
+        if (!started) {
+          started = true;
+          open_file();
+          log_first_line();
+        }
+        do {
+          handle_next_record(*ring);
+        } while ((ring = next_ring(rings)) != nullptr);
+      } else if (!stopping) {
+        std::this_thread::sleep_for(poll_interval);
+      }
+      if (started && !rate_limits_.empty()
+          && std::chrono::steady_clock::now() >= next_summary_)
+        emit_summaries();
+      if (stopping) {
+        // Bail out without printing anything if no thread logged anything.
+        if (started)
+          log_last_line();
+        return;
+      }
+    }
+  }
+
   void run() {
     // Bail out without printing anything if the first event we receive is the
     // shutdown (empty) event.
@@ -458,7 +843,7 @@ public:
     }
     // Loop until receiving an empty message.
     for (;;) {
-      if (auto next = queue_.pop()) {
+      if (auto next = next_event()) {
         handle_event(*next);
       } else {
         log_last_line();
@@ -511,7 +896,10 @@ public:
       auto f = [this](auto) {
         detail::set_thread_name("caf.logger");
         system_.thread_started(thread_owner::system);
-        run();
+        if (cfg_.deferred_formatting)
+          run_deferred();
+        else
+          run();
         system_.thread_terminates();
       };
       thread_ = std::thread{f, detail::global_meta_objects_guard()};
@@ -525,8 +913,13 @@ public:
     }
     if (!thread_.joinable())
       return;
-    // Send an empty message to the logger thread to make it terminate.
-    queue_.push(log::event_ptr{});
+    if (cfg_.deferred_formatting) {
+      // The logger thread drains all ring buffers before terminating.
+      stopping_ = true;
+    } else {
+      // Send an empty message to the logger thread to make it terminate.
+      queue_.push(log::event_ptr{});
+    }
     thread_.join();
   }
 
@@ -539,6 +932,24 @@ public:
   // of file_filter_ and console_filter_ if both outputs are enabled.
   std::vector<std::string> global_filter_;
 
+  // Stores the verbosity for each component ID.
+  std::unique_ptr<std::atomic<unsigned>[]> component_levels_
+    = std::make_unique<std::atomic<unsigned>[]>(
+      log::component_registry::max_size);
+
+  // Signals whether `accepts` needs to look up the verbosity of a component.
+  std::atomic<bool> filter_components_ = false;
+
+  // Stores the rate limits from the configuration.
+  std::vector<std::unique_ptr<rate_limit>> rate_limits_;
+
+  // Maps component IDs and log levels to rate limits. Only allocated if the
+  // configuration has rate limits.
+  std::unique_ptr<rate_limit*[]> rate_limit_table_;
+
+  // Point in time for the next summary of suppressed events.
+  std::chrono::steady_clock::time_point next_summary_;
+
   // Filters events by component name for file output.
   std::vector<std::string> file_filter_;
 
@@ -560,6 +971,25 @@ public:
   // Filled with log events by other threads.
   detail::sync_ring_buffer<log::event_ptr, queue_size> queue_;
 
+  // Uniquely identifies this logger for the thread-local ring buffer cache.
+  uint64_t id_;
+
+  // Protects `rings_` and `rings_closed_`.
+  std::mutex rings_mtx_;
+
+  // Stores the ring buffers of all threads when formatting events in the
+  // logger thread.
+  std::vector<detail::log_ring_ptr> rings_;
+
+  // Signals that the ring buffers reject all future records.
+  bool rings_closed_ = false;
+
+  // Signals the logger thread to drain all ring buffers and terminate.
+  std::atomic<bool> stopping_ = false;
+
+  // Buffer for encoding records of binary log files.
+  byte_buffer binary_buf_;
+
   // Stores the assembled name of the log file.
   std::string file_name_;
 
@@ -612,8 +1042,26 @@ logger::line_builder&& logger::line_builder::operator<<(char x) && {
   return std::move(*this) << buf;
 }
 
+detail::log_ring* logger::thread_ring() {
+  return nullptr;
+}
+
+bool logger::accepts_component(unsigned level, log::component_ref component) {
+  return accepts(level, component.name);
+}
+
+void logger::component_verbosity(std::string_view, unsigned) {
+  // nop
+}
+
+bool logger::admit(unsigned, log::component_ref) {
+  return true;
+}
+
 void logger::legacy_api_log(unsigned level, std::string_view component,
                             std::string msg, detail::source_location loc) {
+  if (!admit(level, component))
+    return;
   do_log(log::event::make(level, component, loc, thread_local_aid(), msg));
 }
 
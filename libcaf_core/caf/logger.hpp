@@ -10,11 +10,13 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/format.hpp"
 #include "caf/detail/log_level.hpp"
+#include "caf/detail/log_ring.hpp"
 #include "caf/detail/pp.hpp"
 #include "caf/detail/pretty_type_name.hpp"
 #include "caf/detail/scope_guard.hpp"
 #include "caf/format_string_with_location.hpp"
 #include "caf/fwd.hpp"
+#include "caf/log/component.hpp"
 #include "caf/log/event.hpp"
 #include "caf/log/level.hpp"
 
@@ -49,7 +51,7 @@ public:
   /// Provides an API entry point for sending a log event to the current logger.
   class entrypoint {
   public:
-    entrypoint(unsigned level, std::string_view component,
+    entrypoint(unsigned level, log::component_ref component,
                detail::source_location loc)
       : level_(level), component_(component), loc_(loc) {
       // nop
@@ -58,10 +60,11 @@ public:
     template <class... Args>
     log::event_sender message(std::string_view fmt, Args&&... args) {
       auto* instance = current_logger();
-      if (instance && instance->accepts(level_, component_)) {
+      if (instance && instance->accepts_component(level_, component_)
+          && instance->admit(level_, component_)) {
         return {instance,
                 level_,
-                component_,
+                component_.name,
                 loc_,
                 logger::thread_local_aid(),
                 fmt,
@@ -72,7 +75,7 @@ public:
 
   private:
     unsigned level_;
-    std::string_view component_;
+    log::component_ref component_;
     detail::source_location loc_;
   };
 
@@ -155,11 +158,21 @@ public:
   /// @param fmt_str The format string (with source location) for the message.
   /// @param args Arguments for the format string.
   template <class... Ts>
-  static void log(unsigned level, std::string_view component,
+  static void log(unsigned level, log::component_ref component,
                   format_string_with_location fmt_str, Ts&&... args) {
     auto* instance = current_logger();
-    if (instance && instance->accepts(level, component)) {
-      instance->do_log(log::event::make(level, component, fmt_str.location,
+    if (instance && instance->accepts_component(level, component)
+        && instance->admit(level, component)) {
+      if constexpr (sizeof...(Ts) <= detail::log_record::max_args
+                    && (detail::deferrable_log_arg<Ts> && ...)) {
+        if (auto* ring = instance->thread_ring();
+            ring != nullptr
+            && ring->push(level, component.name, fmt_str.location,
+                          thread_local_aid(), fmt_str.value, args...))
+          return;
+      }
+      instance->do_log(log::event::make(level, component.name,
+                                        fmt_str.location,
                                         thread_local_aid(), fmt_str.value,
                                         std::forward<Ts>(args)...));
     }
@@ -171,7 +184,7 @@ public:
   /// @param loc Source location of the logging call.
   template <class... Ts>
   static entrypoint
-  log(unsigned level, std::string_view component,
+  log(unsigned level, log::component_ref component,
       detail::source_location loc = detail::source_location::current()) {
     return {level, component, loc};
   }
@@ -182,16 +195,17 @@ public:
   /// @param args Arguments for the format string.
   template <class... Ts>
   [[nodiscard]] static trace_exit_guard
-  trace(std::string_view component, format_string_with_location fmt_str,
+  trace(log::component_ref component, format_string_with_location fmt_str,
         Ts&&... args) {
     auto* instance = current_logger();
-    if (instance && instance->accepts(log::level::trace, component)) {
+    if (instance && instance->accepts_component(log::level::trace, component)
+        && instance->admit(log::level::trace, component)) {
       auto msg = std::string{"ENTRY"};
       if (!fmt_str.value.empty()) {
         msg += ' ';
         msg += fmt_str.value;
       }
-      auto event = log::event::make(log::level::trace, component,
+      auto event = log::event::make(log::level::trace, component.name,
                                     fmt_str.location, thread_local_aid(), msg,
                                     std::forward<Ts>(args)...);
       auto event_cpy = event;
@@ -214,6 +228,8 @@ public:
   legacy_api_log_trace(std::string_view component, std::string msg,
                        detail::source_location loc
                        = detail::source_location::current()) {
+    if (!admit(log::level::trace, component))
+      return {nullptr, {}};
     auto event = log::event::make(log::level::trace, component, loc,
                                   thread_local_aid(), msg);
     auto event_cpy = event;
@@ -233,6 +249,24 @@ public:
   /// component and log level.
   virtual bool accepts(unsigned level, std::string_view component_name) = 0;
 
+  /// Returns whether the logger is configured to accept input for given
+  /// component and log level. Loggers may use the ID of a registered
+  /// component to look up its verbosity without comparing strings. The
+  /// default implementation calls `accepts` with the name of the component.
+  virtual bool accepts_component(unsigned level, log::component_ref component);
+
+  /// Returns whether the logger admits another event for given component and
+  /// log level after `accepts` returned `true`. Unlike `accepts`, this
+  /// function may update state such as rate limits. Hence, the logging
+  /// functions call it exactly once per event. The default implementation
+  /// always returns `true`.
+  virtual bool admit(unsigned level, log::component_ref component);
+
+  /// Sets the verbosity of `component` while the logger is running. The
+  /// verbosity of a component cannot exceed the verbosity of the logger. The
+  /// default implementation does nothing.
+  virtual void component_verbosity(std::string_view component, unsigned level);
+
   // -- static utility functions -----------------------------------------------
 
   /// Creates a new logger instance.
@@ -277,6 +311,11 @@ private:
 
   virtual void do_log(log::event_ptr&& event) = 0;
 
+  /// Returns the ring buffer of the calling thread if the logger formats
+  /// events in its own thread or `nullptr` if events require formatting on the
+  /// calling thread. The default implementation returns `nullptr`.
+  virtual detail::log_ring* thread_ring();
+
   // -- initialization (called by the actor_system) ----------------------------
 
   /// Allows the logger to read its configuration from the actor system config.
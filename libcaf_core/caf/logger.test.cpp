@@ -0,0 +1,257 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/logger.hpp"
+
+#include "caf/test/temp_directory.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/log_record.hpp"
+#include "caf/log/level.hpp"
+#include "caf/settings.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+constexpr auto component = "caf.logger-test"sv;
+
+struct fixture {
+  fixture() {
+    prev = logger::current_logger();
+  }
+
+  ~fixture() {
+    logger::current_logger(prev);
+  }
+
+  // Runs `fn` with an actor system that logs to `path` and returns the content
+  // of the log file after shutting down the actor system.
+  template <class Init, class Fn>
+  std::string with_logger(Init init, Fn fn) {
+    {
+      actor_system_config cfg;
+      cfg.set("caf.logger.file.path", path);
+      cfg.set("caf.logger.file.verbosity", "debug");
+      cfg.set("caf.logger.file.format", "%c %p %m%n");
+      cfg.set("caf.logger.console.verbosity", "quiet");
+      cfg.set("caf.logger.deferred-formatting", true);
+      init(cfg);
+      actor_system sys{cfg};
+      logger::current_logger(&sys);
+      fn();
+      logger::current_logger(prev);
+    }
+    std::ifstream in{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{in},
+                       std::istreambuf_iterator<char>{}};
+  }
+
+  // Returns all lines from the test component.
+  static std::vector<std::string> test_lines(std::string_view content) {
+    std::vector<std::string> result;
+    while (!content.empty()) {
+      auto line = content.substr(0, content.find('\n'));
+      content.remove_prefix(std::min(line.size() + 1, content.size()));
+      if (line.starts_with(component))
+        result.emplace_back(line.substr(component.size() + 1));
+    }
+    return result;
+  }
+
+  static void log_messages() {
+    logger::log(log::level::debug, component, "int: {}", 42);
+    logger::log(log::level::info, component, "str: {}", "hello"s);
+    logger::log(log::level::warning, component, "list: {}",
+                std::vector<int>{1, 2});
+    logger::log(log::level::debug, component)
+      .message("fields")
+      .field("x", 1)
+      .send();
+    logger::log(log::level::trace, component, "dropped: {}", 1);
+    auto worker = std::thread{[ptr = logger::current_logger()] {
+      logger::current_logger(ptr);
+      logger::log(log::level::error, component, "worker: {}", 2.5);
+      logger::current_logger(nullptr);
+    }};
+    worker.join();
+  }
+
+  // Returns a configuration value for `caf.logger.rate-limits`.
+  static config_value::list rate_limit(std::string_view level, size_t sample) {
+    settings rule;
+    put(rule, "component", std::string{component});
+    if (!level.empty())
+      put(rule, "level", std::string{level});
+    put(rule, "sample", sample);
+    return config_value::list{config_value{std::move(rule)}};
+  }
+
+  test::temp_directory dir{"caf-logger-test"};
+  std::string path = dir.file("out.log");
+  logger* prev;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("a logger with deferred formatting renders events in its own thread") {
+  auto content = with_logger([](actor_system_config&) {}, log_messages);
+  auto lines = test_lines(content);
+  if (check_eq(lines.size(), 5u)) {
+    check_eq(lines[0], "DEBUG int: 42");
+    check_eq(lines[1], "INFO str: hello");
+    check_eq(lines[2], "WARN list: [1, 2]");
+    check_eq(lines[3], "DEBUG fields ; x = 1");
+    check_eq(lines[4], "ERROR worker: 2.5");
+  }
+}
+
+TEST("a logger with deferred formatting can write binary log files") {
+  auto content = with_logger(
+    [](actor_system_config& cfg) { cfg.set("caf.logger.file.binary", true); },
+    log_messages);
+  require(content.starts_with(detail::binary_log_magic));
+  // Deferred records store the format string instead of the message.
+  check_ne(content.find("int: {}"), std::string::npos);
+  check_eq(content.find("int: 42"), std::string::npos);
+  // Events that are not deferrable store their formatted message.
+  check_ne(content.find("list: [1, 2]"), std::string::npos);
+  check_ne(content.find("fields ; x = 1"), std::string::npos);
+  check_eq(content.find("dropped"), std::string::npos);
+}
+
+TEST("loggers look up the verbosity of registered components") {
+  using log::component_registry;
+  auto foo_name = "caf.logger-test.foo"sv;
+  auto foo = log::component_ref{foo_name, component_registry::id_of(foo_name)};
+  auto bar_name = "caf.logger-test.bar"sv;
+  auto bar = log::component_ref{bar_name, component_registry::id_of(bar_name)};
+  actor_system_config cfg;
+  cfg.set("caf.logger.file.path", path);
+  cfg.set("caf.logger.file.verbosity", "info");
+  cfg.set("caf.logger.file.excluded-components",
+          std::vector<std::string>{std::string{bar_name}});
+  cfg.set("caf.logger.console.verbosity", "quiet");
+  actor_system sys{cfg};
+  auto& uut = sys.logger();
+  SECTION("the configuration sets the initial verbosity") {
+    check(uut.accepts_component(log::level::info, foo));
+    check(!uut.accepts_component(log::level::debug, foo));
+    check(!uut.accepts_component(log::level::error, bar));
+    check(uut.accepts(log::level::info, foo_name));
+    check(!uut.accepts(log::level::error, bar_name));
+    check(uut.accepts(log::level::info, "caf.logger-test.unknown"));
+    check(!uut.accepts(log::level::debug, "caf.logger-test.unknown"));
+  }
+  SECTION("accepts never registers components") {
+    auto n = component_registry::size();
+    check(uut.accepts(log::level::info, "caf.logger-test.unregistered"));
+    check(!uut.accepts(log::level::debug, "caf.logger-test.unregistered"));
+    check_eq(component_registry::size(), n);
+    check_eq(component_registry::find("caf.logger-test.unregistered"),
+             component_registry::max_size);
+  }
+  SECTION("the verbosity of components may change at runtime") {
+    uut.component_verbosity(foo_name, log::level::error);
+    uut.component_verbosity(bar_name, log::level::warning);
+    check(uut.accepts_component(log::level::error, foo));
+    check(!uut.accepts_component(log::level::warning, foo));
+    check(uut.accepts_component(log::level::warning, bar));
+    check(!uut.accepts(log::level::warning, foo_name));
+    check(uut.accepts(log::level::warning, bar_name));
+    check(uut.accepts(log::level::info, "caf.logger-test.unknown"));
+  }
+  SECTION("the verbosity of a component cannot exceed the logger verbosity") {
+    uut.component_verbosity(foo_name, log::level::trace);
+    check(uut.accepts_component(log::level::info, foo));
+    check(!uut.accepts_component(log::level::debug, foo));
+  }
+}
+
+TEST("rate limits drop log events and report how many they suppressed") {
+  auto init = [](actor_system_config& cfg) {
+    cfg.set("caf.logger.rate-limits", rate_limit("warning", 3));
+  };
+  auto fn = [] {
+    for (int i = 0; i < 10; ++i) {
+      logger::log(log::level::warning, component, "event {}", i);
+      logger::log(log::level::info, component, "info {}", i);
+    }
+  };
+  auto lines = test_lines(with_logger(init, fn));
+  auto warnings = std::vector<std::string>{};
+  auto infos = size_t{0};
+  for (auto& line : lines) {
+    if (line.starts_with("WARN"))
+      warnings.push_back(line);
+    else if (line.starts_with("INFO"))
+      ++infos;
+  }
+  check_eq(infos, 10u);
+  check_eq(warnings,
+           std::vector<std::string>{"WARN event 0", "WARN event 3",
+                                    "WARN event 6", "WARN event 9",
+                                    "WARN suppressed 6 log events"});
+}
+
+TEST("checking whether a logger accepts an event does not count as an event") {
+  auto init = [](actor_system_config& cfg) {
+    cfg.set("caf.logger.rate-limits", rate_limit("warning", 2));
+  };
+  auto fn = [] {
+    auto* instance = logger::current_logger();
+    for (int i = 0; i < 10; ++i)
+      if (instance->accepts(log::level::warning, component))
+        logger::log(log::level::warning, component, "event {}", i);
+  };
+  auto lines = test_lines(with_logger(init, fn));
+  check_eq(lines, std::vector<std::string>{"WARN event 0", "WARN event 2",
+                                           "WARN event 4", "WARN event 6",
+                                           "WARN event 8",
+                                           "WARN suppressed 5 log events"});
+}
+
+TEST("loggers export the number of suppressed events as metrics") {
+  actor_system_config cfg;
+  cfg.set("caf.logger.file.path", path);
+  cfg.set("caf.logger.file.verbosity", "debug");
+  cfg.set("caf.logger.console.verbosity", "quiet");
+  cfg.set("caf.logger.rate-limits", rate_limit("", 2));
+  cfg.set("caf.logger.rate-limit-summary-interval", timespan{1ms});
+  actor_system sys{cfg};
+  logger::current_logger(&sys);
+  for (int i = 0; i < 10; ++i)
+    logger::log(log::level::debug, component, "event {}", i);
+  logger::current_logger(prev);
+  auto* family = sys.metrics().counter_family(
+    "caf.logger", "suppressed-events", {"component", "level"},
+    "Number of log events that were dropped by rate limits.", "1", true);
+  auto* debug_count = family->get_or_add(
+    {{"component", component}, {"level", "debug"}});
+  auto* error_count = family->get_or_add(
+    {{"component", component}, {"level", "error"}});
+  auto deadline = std::chrono::steady_clock::now() + 10s;
+  while (debug_count->value() < 5
+         && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(1ms);
+  check_eq(debug_count->value(), 5);
+  check_eq(error_count->value(), 0);
+}
+
+} // WITH_FIXTURE(fixture)
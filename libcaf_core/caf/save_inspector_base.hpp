@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include "caf/detail/concepts.hpp"
 #include "caf/inspector_access.hpp"
 #include "caf/save_inspector.hpp"
 
+#include <span>
 #include <string_view>
 #include <tuple>
 
@@ -42,6 +44,10 @@ public:
     auto size = xs.size();
     if (!dref().begin_sequence(size))
       return false;
+    if constexpr (detail::has_bulk_save<Subtype, T>) {
+      // Fast path for contiguous sequences of numbers.
+      return dref().values(std::span{xs}) && dref().end_sequence();
+    }
     for (auto&& val : xs) {
       using found_type = std::decay_t<decltype(val)>;
       if constexpr (std::is_same_v<found_type, value_type>) {
@@ -6,6 +6,7 @@
 
 #include "caf/action.hpp"
 #include "caf/actor_registry.hpp"
+#include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/anon_mail.hpp"
 #include "caf/config.hpp"
@@ -16,8 +17,10 @@
 #include "caf/detail/mailbox_factory.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/event_based_actor.hpp"
 #include "caf/flow/observable_builder.hpp"
 #include "caf/flow/op/mcast.hpp"
+#include "caf/flow/stage_metrics.hpp"
 #include "caf/format_to_error.hpp"
 #include "caf/log/core.hpp"
 #include "caf/log/system.hpp"
@@ -26,6 +29,7 @@
 #include "caf/send.hpp"
 #include "caf/stream.hpp"
 #include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/striped_counter.hpp"
 
 using namespace std::string_literals;
 
@@ -1055,6 +1059,18 @@ stream scheduled_actor::to_stream_impl(cow_string name, batch_op_ptr batch_op,
   return {ctrl(), item_type, std::move(name), local_id};
 }
 
+bool scheduled_actor::launch_worker_impl(
+  detail::unique_function<void(flow::coordinator*)> init) {
+  auto lg = log::core::trace("");
+  auto fn = std::make_shared<decltype(init)>(std::move(init));
+  home_system().spawn([fn](event_based_actor* self) { (*fn)(self); });
+  return true;
+}
+
+flow::stage_metrics scheduled_actor::stage_metrics_impl(std::string_view name) {
+  return flow::stage_metrics::make(home_system().metrics(), name);
+}
+
 flow::observable<async::batch>
 scheduled_actor::do_observe(stream what, size_t buf_capacity,
                             size_t request_threshold) {
@@ -1062,9 +1078,18 @@ scheduled_actor::do_observe(stream what, size_t buf_capacity,
     = log::core::trace("what = {}, buf_capacity = {}, request_threshold = {}",
                        what, buf_capacity, request_threshold);
   if (const auto& src = what.source()) {
+    auto metrics = detail::stream_bridge_metrics{};
+    if (getf(abstract_actor::collects_metrics_flag)) {
+      auto& families = home_system().actor_metric_families().stream;
+      auto labels = std::initializer_list<telemetry::label_view>{
+        {"name", name()}, {"type", query_type_name(what.type())}};
+      metrics.batch_size = families.batch_size->get_or_add(labels);
+      metrics.max_in_flight_batches
+        = families.max_in_flight_batches->get_or_add(labels);
+    }
     auto ptr = make_counted<detail::stream_bridge>(this, src, what.id(),
                                                    buf_capacity,
-                                                   request_threshold);
+                                                   request_threshold, metrics);
     return flow::observable<async::batch>{std::move(ptr)};
   }
   return make_observable().fail<async::batch>(make_error(sec::invalid_stream));
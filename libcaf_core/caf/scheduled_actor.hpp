@@ -829,6 +829,13 @@ private:
                         type_id_t item_type,
                         size_t max_items_per_batch) override;
 
+  /// Implementation detail for parallel flow operators.
+  bool launch_worker_impl(
+    detail::unique_function<void(flow::coordinator*)> init) override;
+
+  /// Implementation detail for instrumenting flows.
+  flow::stage_metrics stage_metrics_impl(std::string_view name) override;
+
   /// Registers a stream bridge at the actor (callback for
   /// detail::stream_bridge).
   void register_flow_state(uint64_t local_id,
@@ -884,7 +891,7 @@ private:
   intrusive::stack<mailbox_element> stash_;
 
   /// Metrics to count processed messages for the actor.
-  telemetry::int_counter* processed_messages_ = nullptr;
+  telemetry::striped_int_counter* processed_messages_ = nullptr;
 
   union {
     /// The default mailbox instance that we use if the user does not configure
@@ -9,6 +9,7 @@
 
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
+#include "caf/chunk.hpp"
 #include "caf/config_value_reader.hpp"
 #include "caf/config_value_writer.hpp"
 #include "caf/init_global_meta_objects.hpp"
@@ -933,6 +934,236 @@ SCENARIO("binary serializer and deserializer handle vectors of booleans") {
   }
 }
 
+SCENARIO("binary serializer and deserializer copy vectors of numbers in bulk") {
+  GIVEN("vectors of integers and floating point numbers") {
+    auto i16s = std::vector<int16_t>{-1, 0, 1, 0x1234, -0x1234};
+    auto u32s = std::vector<uint32_t>{0, 1, 0xDEADBEEF, 0x01020304};
+    auto i64s = std::vector<int64_t>{-1, 0, 0x0102030405060708};
+    auto dbls = std::vector<double>{0.0, -0.0, 1.5, -2.25, 1e100};
+    WHEN("serializing the vectors") {
+      THEN("the output matches serializing each element individually") {
+        auto bulk = byte_buffer{};
+        auto sink = binary_serializer{bulk};
+        check(sink.apply(i16s) && sink.apply(u32s) && sink.apply(i64s)
+              && sink.apply(dbls));
+        auto single = byte_buffer{};
+        auto single_sink = binary_serializer{single};
+        auto save_each = [&single_sink](const auto& xs) {
+          if (!single_sink.begin_sequence(xs.size()))
+            return false;
+          for (auto x : xs)
+            if (!single_sink.value(x))
+              return false;
+          return single_sink.end_sequence();
+        };
+        check(save_each(i16s) && save_each(u32s) && save_each(i64s)
+              && save_each(dbls));
+        check_eq(bulk, single);
+      }
+      AND_THEN("deserializing the result produces the vectors again") {
+        auto buf = byte_buffer{};
+        auto sink = binary_serializer{buf};
+        check(sink.apply(i16s) && sink.apply(u32s) && sink.apply(i64s)
+              && sink.apply(dbls));
+        auto source = binary_deserializer{buf};
+        auto i16s_copy = std::vector<int16_t>{};
+        auto u32s_copy = std::vector<uint32_t>{};
+        auto i64s_copy = std::vector<int64_t>{};
+        auto dbls_copy = std::vector<double>{};
+        check(source.apply(i16s_copy));
+        check(source.apply(u32s_copy));
+        check(source.apply(i64s_copy));
+        check(source.apply(dbls_copy));
+        check_eq(i16s_copy, i16s);
+        check_eq(u32s_copy, u32s);
+        check_eq(i64s_copy, i64s);
+        check_eq(dbls_copy, dbls);
+        check_eq(source.remaining(), 0u);
+      }
+    }
+    WHEN("serializing into the middle of a buffer") {
+      THEN("the serializer overrides and extends the buffer as needed") {
+        auto buf = byte_buffer(4, std::byte{0xFF});
+        auto sink = binary_serializer{buf};
+        sink.seek(2);
+        check(sink.apply(u32s));
+        auto source = binary_deserializer{buf};
+        source.skip(2);
+        auto copy = std::vector<uint32_t>{};
+        check(source.apply(copy));
+        check_eq(copy, u32s);
+      }
+    }
+  }
+  GIVEN("an input that announces more elements than it contains") {
+    auto buf = byte_buffer{};
+    auto sink = binary_serializer{buf};
+    check(sink.begin_sequence(1'000'000));
+    check(sink.value(int32_t{42}));
+    WHEN("deserializing a vector of integers") {
+      THEN("the deserializer reports an error") {
+        auto source = binary_deserializer{buf};
+        auto copy = std::vector<int32_t>{};
+        check(!source.apply(copy));
+        check_eq(source.get_error(), sec::end_of_stream);
+        check(copy.capacity() < 1'000'000u);
+      }
+    }
+  }
+}
+
+SCENARIO("the compact binary encoding uses varints for integers") {
+  GIVEN("a binary serializer with compact encoding") {
+    auto buf = byte_buffer{};
+    auto sink = binary_serializer{buf};
+    sink.encoding(binary_encoding::compact);
+    WHEN("serializing small integers") {
+      THEN("each integer occupies a single byte") {
+        check(sink.apply(uint64_t{0}) && sink.apply(uint32_t{127})
+              && sink.apply(int64_t{-1}) && sink.apply(int16_t{63})
+              && sink.apply(int32_t{-64}));
+        check_eq(buf.size(), 5u);
+        check_eq(buf[2], std::byte{1});
+      }
+    }
+    WHEN("serializing integers at their limits") {
+      THEN("deserializing the result produces the integers again") {
+        auto i16 = std::numeric_limits<int16_t>::min();
+        auto u16 = std::numeric_limits<uint16_t>::max();
+        auto i32 = std::numeric_limits<int32_t>::min();
+        auto u32 = std::numeric_limits<uint32_t>::max();
+        auto i64 = std::numeric_limits<int64_t>::min();
+        auto u64 = std::numeric_limits<uint64_t>::max();
+        auto i64_max = std::numeric_limits<int64_t>::max();
+        check(sink.apply(i16) && sink.apply(u16) && sink.apply(i32)
+              && sink.apply(u32) && sink.apply(i64) && sink.apply(u64)
+              && sink.apply(i64_max) && sink.apply(3.5));
+        auto source = binary_deserializer{buf};
+        source.encoding(binary_encoding::compact);
+        auto i16_copy = int16_t{0};
+        auto u16_copy = uint16_t{0};
+        auto i32_copy = int32_t{0};
+        auto u32_copy = uint32_t{0};
+        auto i64_copy = int64_t{0};
+        auto u64_copy = uint64_t{0};
+        auto i64_max_copy = int64_t{0};
+        auto dbl_copy = 0.0;
+        check(source.apply(i16_copy) && source.apply(u16_copy)
+              && source.apply(i32_copy) && source.apply(u32_copy)
+              && source.apply(i64_copy) && source.apply(u64_copy)
+              && source.apply(i64_max_copy) && source.apply(dbl_copy));
+        check_eq(i16_copy, i16);
+        check_eq(u16_copy, u16);
+        check_eq(i32_copy, i32);
+        check_eq(u32_copy, u32);
+        check_eq(i64_copy, i64);
+        check_eq(u64_copy, u64);
+        check_eq(i64_max_copy, i64_max);
+        check_eq(dbl_copy, test::approx{3.5});
+        check_eq(source.remaining(), 0u);
+      }
+    }
+    WHEN("serializing vectors and objects") {
+      THEN("the output is smaller than with the fixed encoding") {
+        auto xs = std::vector<int32_t>{1, -2, 300, -40'000, 0};
+        auto val = user{};
+        check(sink.apply(xs) && sink.apply(val));
+        auto fixed_buf = byte_buffer{};
+        auto fixed_sink = binary_serializer{fixed_buf};
+        check(fixed_sink.apply(xs) && fixed_sink.apply(val));
+        check_lt(buf.size(), fixed_buf.size());
+        auto source = binary_deserializer{buf};
+        source.encoding(binary_encoding::compact);
+        auto xs_copy = std::vector<int32_t>{};
+        auto val_copy = user{0, ""};
+        check(source.apply(xs_copy) && source.apply(val_copy));
+        check_eq(xs_copy, xs);
+        check_eq(val_copy, val);
+      }
+    }
+  }
+  GIVEN("a varint that exceeds the range of the integer type") {
+    auto buf = byte_buffer{std::byte{0xFF}, std::byte{0xFF}, std::byte{0x04}};
+    WHEN("deserializing a 16-bit integer") {
+      THEN("the deserializer reports an error") {
+        auto source = binary_deserializer{buf};
+        source.encoding(binary_encoding::compact);
+        auto x = uint16_t{0};
+        check(!source.apply(x));
+        check_eq(source.get_error(), sec::malformed_message);
+      }
+    }
+  }
+}
+
+struct user_view {
+  uint32_t id = 0;
+  std::string_view name;
+};
+
+template <class Inspector>
+bool inspect(Inspector& f, user_view& x) {
+  return f.object(x).fields(f.field("id", x.id), f.field("name", x.name));
+}
+
+SCENARIO("binary deserializer loads views into the input buffer") {
+  GIVEN("a serialized user object") {
+    auto buf = byte_buffer{};
+    auto sink = binary_serializer{buf};
+    check(sink.apply(user{7, "Alice"}));
+    WHEN("deserializing into a type with a string_view member") {
+      THEN("the string_view points into the input buffer") {
+        auto source = binary_deserializer{buf};
+        auto val = user_view{};
+        check(source.apply(val));
+        check_eq(val.id, 7u);
+        check_eq(val.name, "Alice");
+        auto* first = reinterpret_cast<const std::byte*>(val.name.data());
+        check(first >= buf.data() && first < buf.data() + buf.size());
+        check_eq(source.remaining(), 0u);
+      }
+    }
+    WHEN("deserializing from a chunk") {
+      THEN("copies of the chunk keep the views valid") {
+        auto val = user_view{};
+        auto owner = chunk{};
+        {
+          auto input = chunk{buf};
+          auto source = binary_deserializer{input.bytes()};
+          check(source.apply(val));
+          owner = input;
+        }
+        buf.clear();
+        check_eq(val.name, "Alice");
+      }
+    }
+  }
+  GIVEN("a serialized byte buffer") {
+    auto bytes = byte_buffer{std::byte{1}, std::byte{2}, std::byte{3}};
+    auto buf = byte_buffer{};
+    auto sink = binary_serializer{buf};
+    check(sink.apply(bytes));
+    WHEN("loading a view to the bytes") {
+      THEN("the view points into the input buffer") {
+        auto source = binary_deserializer{buf};
+        auto view = const_byte_span{};
+        check(source.view(view));
+        check_eq(byte_buffer(view.begin(), view.end()), bytes);
+        check(view.data() == buf.data() + 1);
+      }
+    }
+    WHEN("the input ends before the announced size") {
+      THEN("the deserializer reports an error") {
+        buf.pop_back();
+        auto source = binary_deserializer{buf};
+        auto view = const_byte_span{};
+        check(!source.view(view));
+        check_eq(source.get_error(), sec::end_of_stream);
+      }
+    }
+  }
+}
+
 } // WITH_FIXTURE(fixture)
 
 TEST_INIT() {
@@ -9,6 +9,7 @@
 #include "caf/telemetry/metric_family.hpp"
 #include "caf/telemetry/metric_registry.hpp"
 
+#include <charconv>
 #include <cmath>
 #include <ctime>
 #include <type_traits>
@@ -256,6 +257,24 @@ void prometheus::append_impl(const metric_family* family,
 
 namespace {
 
+std::string bucket_label(int64_t upper_bound) {
+  return std::to_string(upper_bound);
+}
+
+// Keeps the established format for bucket bounds unless it loses precision,
+// e.g., for the small bounds of log-linear buckets.
+std::string bucket_label(double upper_bound) {
+  auto result = std::to_string(upper_bound);
+  auto parsed = 0.0;
+  std::from_chars(result.data(), result.data() + result.size(), parsed);
+  if (parsed != upper_bound) {
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), upper_bound);
+    result.assign(buf, res.ptr);
+  }
+  return result;
+}
+
 template <class BucketType>
 auto make_histogram_info(const metric_family* family, const metric* instance,
                          std::span<const BucketType> buckets) {
@@ -272,7 +291,7 @@ auto make_histogram_info(const metric_family* family, const metric* instance,
   size_t index = 0;
   // Create bucket variable names for 1..N-1.
   for (; index < num_buckets - 1; ++index) {
-    auto upper_bound = std::to_string(buckets[index].upper_bound);
+    auto upper_bound = bucket_label(buckets[index].upper_bound);
     labels.back().value(upper_bound);
     add_result(family, "_bucket", labels, ' ');
   }
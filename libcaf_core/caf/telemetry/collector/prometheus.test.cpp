@@ -7,9 +7,13 @@
 #include "caf/test/test.hpp"
 
 #include "caf/log/test.hpp"
+#include "caf/telemetry/log_linear_buckets.hpp"
 #include "caf/telemetry/metric_registry.hpp"
 #include "caf/telemetry/metric_type.hpp"
 
+#include <set>
+#include <string>
+
 using namespace caf;
 using namespace caf::telemetry;
 
@@ -74,4 +78,46 @@ some_request_duration_seconds_count{x="get"} 3 42000
   check_eq(res1, exporter.collect_from(registry, ts));
 }
 
+TEST("the Prometheus collector renders log-linear histograms") {
+  auto bounds = log_linear_buckets<double>::upper_bounds(0.25, 4.0, 1);
+  auto fam = registry.histogram_family<double>("app", "latency", {}, bounds,
+                                               "Some latency.", "seconds");
+  auto h = fam->get_or_add({});
+  check(h->log_linear());
+  h->observe(0.125);
+  h->observe(0.625);
+  h->observe(2.5);
+  h->observe(10.0);
+  check_eq(exporter.collect_from(registry, timestamp{42s}),
+           R"(# HELP app_latency_seconds Some latency.
+# TYPE app_latency_seconds histogram
+app_latency_seconds_bucket{le="0.250000"} 1 42000
+app_latency_seconds_bucket{le="0.375000"} 1 42000
+app_latency_seconds_bucket{le="0.500000"} 1 42000
+app_latency_seconds_bucket{le="0.750000"} 2 42000
+app_latency_seconds_bucket{le="1.000000"} 2 42000
+app_latency_seconds_bucket{le="1.500000"} 2 42000
+app_latency_seconds_bucket{le="2.000000"} 2 42000
+app_latency_seconds_bucket{le="3.000000"} 3 42000
+app_latency_seconds_bucket{le="4.000000"} 3 42000
+app_latency_seconds_bucket{le="+Inf"} 4 42000
+app_latency_seconds_sum 13.250000 42000
+app_latency_seconds_count 4 42000
+)"sv);
+}
+
+TEST("the Prometheus collector renders small bucket bounds precisely") {
+  auto bounds = log_linear_buckets<double>::upper_bounds(1e-9, 1e-6, 2);
+  auto fam = registry.histogram_family<double>("app", "latency", {}, bounds,
+                                               "Some latency.", "seconds");
+  fam->get_or_add({})->observe(1.5e-9);
+  auto output = std::string{exporter.collect_from(registry, timestamp{42s})};
+  std::set<std::string> labels;
+  for (size_t pos = output.find("le=\""); pos != std::string::npos;
+       pos = output.find("le=\"", pos + 1))
+    labels.emplace(output.substr(pos, output.find('"', pos + 4) - pos));
+  check_eq(labels.size(), bounds.size() + 1);
+  check(!labels.contains("le=\"0.000000"));
+}
+
 } // WITH_FIXTURE(fixture)
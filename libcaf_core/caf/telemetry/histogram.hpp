@@ -10,11 +10,15 @@
 #include "caf/telemetry/counter.hpp"
 #include "caf/telemetry/gauge.hpp"
 #include "caf/telemetry/label.hpp"
+#include "caf/telemetry/log_linear_buckets.hpp"
 #include "caf/telemetry/metric_type.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <optional>
 #include <span>
 #include <type_traits>
+#include <vector>
 
 namespace caf::telemetry {
 
@@ -66,18 +70,11 @@ public:
   // -- modifiers --------------------------------------------------------------
 
   /// Increments the bucket where the observed value falls into and increments
-  /// the sum of all observed values.
+  /// the sum of all observed values. Runs in constant time if the upper bounds
+  /// of the buckets form @ref log_linear_buckets.
   void observe(value_type value) {
-    // The last bucket has an upper bound of +inf or int_max, so we'll always
-    // find a bucket and increment the counters.
-    for (size_t index = 0;; ++index) {
-      auto& [upper_bound, count] = buckets_[index];
-      if (value <= upper_bound) {
-        count.inc();
-        sum_.inc(value);
-        return;
-      }
-    }
+    buckets_[index_of(value)].count.inc();
+    sum_.inc(value);
   }
 
   // -- observers --------------------------------------------------------------
@@ -92,12 +89,67 @@ public:
     return sum_.value();
   }
 
+  /// Returns whether the histogram computes bucket indexes from log-linear
+  /// bucket bounds.
+  bool log_linear() const noexcept {
+    return layout_.has_value();
+  }
+
+  /// Estimates the `q`-quantile of all observed values by interpolating
+  /// linearly within the bucket that contains the quantile. Returns the upper
+  /// bound of the last finite bucket if the quantile falls into the last
+  /// bucket and NaN if the histogram has no observations.
+  /// @pre `0 <= q && q <= 1`
+  double quantile(double q) const {
+    CAF_ASSERT(0 <= q && q <= 1);
+    std::vector<int64_t> counts;
+    counts.reserve(num_buckets_);
+    int64_t total = 0;
+    for (const auto& bucket : buckets()) {
+      counts.push_back(bucket.count.value());
+      total += counts.back();
+    }
+    if (total == 0)
+      return std::numeric_limits<double>::quiet_NaN();
+    auto rank = q * static_cast<double>(total);
+    auto last = num_buckets_ - 1;
+    int64_t cumulative = 0;
+    for (size_t index = 0; index < last; ++index) {
+      auto count = counts[index];
+      if (count > 0 && static_cast<double>(cumulative + count) >= rank) {
+        auto upper = static_cast<double>(buckets_[index].upper_bound);
+        auto lower = index == 0
+                       ? std::min(0.0, upper)
+                       : static_cast<double>(buckets_[index - 1].upper_bound);
+        auto offset = std::max(rank - static_cast<double>(cumulative), 0.0);
+        return lower + (upper - lower) * offset / static_cast<double>(count);
+      }
+      cumulative += count;
+    }
+    return static_cast<double>(buckets_[last - 1].upper_bound);
+  }
+
 private:
+  template <class>
+  friend class striped_histogram;
+
+  size_t index_of(value_type value) const noexcept {
+    if (layout_)
+      return layout_->index_of(value);
+    // The last bucket has an upper bound of +inf or int_max, so we'll always
+    // find a bucket.
+    size_t index = 0;
+    while (value > buckets_[index].upper_bound)
+      ++index;
+    return index;
+  }
+
   void init_buckets(std::span<const value_type> upper_bounds) {
     CAF_ASSERT(std::is_sorted(upper_bounds.begin(), upper_bounds.end()));
     using limits = std::numeric_limits<value_type>;
     num_buckets_ = upper_bounds.size() + 1;
     buckets_ = new bucket_type[num_buckets_];
+    layout_ = log_linear_buckets<value_type>::from(upper_bounds);
     size_t index = 0;
     for (; index < upper_bounds.size(); ++index)
       buckets_[index].upper_bound = upper_bounds[index];
@@ -130,6 +182,7 @@ private:
   size_t num_buckets_;
   bucket_type* buckets_;
   gauge_type sum_;
+  std::optional<log_linear_buckets<value_type>> layout_;
 };
 
 /// Convenience alias for a histogram with value type `double`.
@@ -8,6 +8,7 @@
 #include "caf/test/test.hpp"
 
 #include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/log_linear_buckets.hpp"
 
 #include <cmath>
 #include <limits>
@@ -44,3 +45,35 @@ TEST("histograms aggregate to buckets and keep a sum") {
   check_eq(buckets[3].count.value(), 2); // 9, 10
   check_eq(h1.sum(), 55);
 }
+
+TEST("histograms compute bucket indexes for log-linear bounds") {
+  auto bounds = log_linear_buckets<int64_t>::upper_bounds(0, 100, 2);
+  int_histogram h1({}, nullptr, bounds);
+  check(h1.log_linear());
+  for (int64_t value : {0, 3, 8, 9, 10, 100, 1000})
+    h1.observe(value);
+  auto buckets = h1.buckets();
+  require_eq(buckets.size(), bounds.size() + 1);
+  check_eq(buckets[0].count.value(), 1);  // 0
+  check_eq(buckets[3].count.value(), 1);  // 3
+  check_eq(buckets[8].count.value(), 2);  // 8, 9
+  check_eq(buckets[9].count.value(), 1);  // 10
+  check_eq(buckets[22].count.value(), 1); // 100
+  check_eq(buckets[23].count.value(), 1); // 1000
+  check_eq(h1.sum(), 1130);
+  check(!int_histogram{1, 2, 4, 8}.log_linear());
+}
+
+TEST("histograms estimate quantiles from their buckets") {
+  dbl_histogram h1{1.0, 2.0, 4.0};
+  check(std::isnan(h1.quantile(0.5)));
+  for (auto value : {0.5, 1.5, 1.5, 3.0})
+    h1.observe(value);
+  check_eq(h1.quantile(0.0), test::approx{0.0});
+  check_eq(h1.quantile(0.25), test::approx{1.0});
+  check_eq(h1.quantile(0.5), test::approx{1.5});
+  check_eq(h1.quantile(0.75), test::approx{2.0});
+  check_eq(h1.quantile(1.0), test::approx{4.0});
+  h1.observe(100.0);
+  check_eq(h1.quantile(1.0), test::approx{4.0});
+}
@@ -0,0 +1,191 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/assert.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace caf::telemetry {
+
+/// Describes log-linear (HDR-style) bucket bounds for a @ref histogram. Each
+/// power of two is split into `2^precision` buckets of equal width. Hence, the
+/// width of a bucket never exceeds `2^-precision` times its lower bound and
+/// the bucket for a value follows from the exponent and the leading mantissa
+/// bits of the value, i.e., computing it does not depend on the number of
+/// buckets.
+///
+/// Integer buckets have a width of 1 up to `2^(precision + 1)`. Floating point
+/// buckets split the range between the smallest and the largest bound
+/// without special cases, because floating point numbers store an exponent
+/// and a mantissa anyway.
+template <class ValueType>
+class log_linear_buckets {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  // -- constants --------------------------------------------------------------
+
+  /// The maximum number of mantissa bits for selecting a bucket.
+  static constexpr unsigned max_precision = 10;
+
+  static constexpr bool has_int_value = std::is_same_v<value_type, int64_t>;
+
+  // -- factories --------------------------------------------------------------
+
+  /// Returns the upper bounds of log-linear buckets that cover all values in
+  /// the range `[min, max]`.
+  /// @pre `min < max`
+  /// @pre `min > 0` if `value_type` is a floating point type
+  /// @pre `precision <= max_precision`
+  static std::vector<value_type>
+  upper_bounds(value_type min, value_type max, unsigned precision) {
+    CAF_ASSERT(min < max);
+    CAF_ASSERT(precision <= max_precision);
+    std::vector<value_type> result;
+    uint64_t first = 0;
+    uint64_t last = 0;
+    if constexpr (has_int_value) {
+      first = key(static_cast<uint64_t>(std::max(min, value_type{0})),
+                  precision);
+      last = key(static_cast<uint64_t>(std::max(max, value_type{0})),
+                 precision);
+    } else {
+      CAF_ASSERT(min > 0);
+      first = key(std::bit_cast<uint64_t>(min), precision);
+      last = key(std::bit_cast<uint64_t>(max) - 1, precision) + 1;
+    }
+    result.reserve(last - first + 1);
+    for (auto k = first; k <= last; ++k)
+      result.push_back(bound(k, precision));
+    return result;
+  }
+
+  /// Returns the log-linear layout that matches `bounds` exactly or `nullopt`
+  /// if `bounds` do not form log-linear buckets.
+  static std::optional<log_linear_buckets>
+  from(std::span<const value_type> bounds) {
+    if (bounds.size() < 2)
+      return std::nullopt;
+    if constexpr (has_int_value) {
+      if (bounds[0] < 0)
+        return std::nullopt;
+      for (unsigned precision = 0; precision <= max_precision; ++precision) {
+        auto first = key(static_cast<uint64_t>(bounds[0]), precision);
+        if (matches(bounds, first, precision))
+          return log_linear_buckets{precision, first, bounds};
+      }
+    } else {
+      if (!(bounds[0] > 0) || !std::isfinite(bounds.back()))
+        return std::nullopt;
+      // Neighboring bounds differ by one in the leading mantissa bits.
+      auto bits = std::bit_cast<uint64_t>(bounds[0]);
+      auto step = std::bit_cast<uint64_t>(bounds[1]) - bits;
+      if (!std::has_single_bit(step) || bits % step != 0)
+        return std::nullopt;
+      auto shift = static_cast<unsigned>(std::countr_zero(step));
+      if (shift > mantissa_bits || mantissa_bits - shift > max_precision)
+        return std::nullopt;
+      auto precision = mantissa_bits - shift;
+      if (matches(bounds, key(bits, precision), precision))
+        return log_linear_buckets{precision, key(bits, precision), bounds};
+    }
+    return std::nullopt;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of mantissa bits for selecting a bucket.
+  unsigned precision() const noexcept {
+    return precision_;
+  }
+
+  /// Returns the index of the bucket for `value`. The index `n` for `n` bounds
+  /// denotes the bucket for values above the last bound.
+  size_t index_of(value_type value) const noexcept {
+    if (!(value > first_bound_))
+      return 0;
+    uint64_t k = 0;
+    if constexpr (has_int_value) {
+      k = key(static_cast<uint64_t>(value), precision_);
+    } else {
+      // Buckets include their upper bound. Hence, we look up the predecessor
+      // of `value` to map a value that equals a bound to the bucket below.
+      k = key(std::bit_cast<uint64_t>(value) - 1, precision_) + 1;
+    }
+    return static_cast<size_t>(std::min(k - first_key_, uint64_t{size_}));
+  }
+
+private:
+  /// Number of mantissa bits of a `double`.
+  static constexpr unsigned mantissa_bits = 52;
+
+  log_linear_buckets(unsigned precision, uint64_t first_key,
+                     std::span<const value_type> bounds) noexcept
+    : precision_(precision),
+      first_key_(first_key),
+      size_(bounds.size()),
+      first_bound_(bounds[0]) {
+    // nop
+  }
+
+  /// Maps `x` to the number of its bucket. For integers, `x` is the value
+  /// itself and for floating point numbers, `x` is the binary representation.
+  static uint64_t key(uint64_t x, unsigned precision) noexcept {
+    if constexpr (has_int_value) {
+      if (x < (uint64_t{2} << precision))
+        return x;
+      auto shift = static_cast<unsigned>(std::bit_width(x)) - 1 - precision;
+      return ((uint64_t{shift} + 1) << precision) + (x >> shift)
+             - (uint64_t{1} << precision);
+    } else {
+      return x >> (mantissa_bits - precision);
+    }
+  }
+
+  /// Returns the (inclusive) upper bound of the bucket with number `k`.
+  static value_type bound(uint64_t k, unsigned precision) noexcept {
+    if constexpr (has_int_value) {
+      if (k < (uint64_t{2} << precision))
+        return static_cast<value_type>(k);
+      auto shift = (k >> precision) - 1;
+      auto mantissa = (k & ((uint64_t{1} << precision) - 1))
+                      + (uint64_t{1} << precision);
+      return static_cast<value_type>(((mantissa + 1) << shift) - 1);
+    } else {
+      return std::bit_cast<value_type>(k << (mantissa_bits - precision));
+    }
+  }
+
+  /// Checks whether `bounds` are the upper bounds of the buckets starting at
+  /// bucket `first`.
+  static bool matches(std::span<const value_type> bounds, uint64_t first,
+                      unsigned precision) noexcept {
+    for (size_t index = 0; index < bounds.size(); ++index)
+      if (bound(first + index, precision) != bounds[index])
+        return false;
+    return true;
+  }
+
+  unsigned precision_;
+
+  uint64_t first_key_;
+
+  size_t size_;
+
+  value_type first_bound_;
+};
+
+} // namespace caf::telemetry
@@ -0,0 +1,100 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/telemetry/log_linear_buckets.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace caf;
+using namespace caf::telemetry;
+
+namespace {
+
+// Returns the index of the first bucket that accepts `value`.
+template <class T>
+size_t linear_search(const std::vector<T>& bounds, T value) {
+  size_t index = 0;
+  while (index < bounds.size() && value > bounds[index])
+    ++index;
+  return index;
+}
+
+} // namespace
+
+TEST("integer buckets have a width of 1 for small values") {
+  auto bounds = log_linear_buckets<int64_t>::upper_bounds(0, 100, 2);
+  check_eq(bounds, std::vector<int64_t>{0,  1,  2,  3,  4,  5,  6,  7,
+                                        9,  11, 13, 15, 19, 23, 27, 31,
+                                        39, 47, 55, 63, 79, 95, 111});
+}
+
+TEST("log-linear buckets compute the index of a linear search") {
+  SECTION("integer buckets") {
+    for (unsigned precision : {0u, 1u, 3u, 7u}) {
+      auto bounds = log_linear_buckets<int64_t>::upper_bounds(10, 100'000,
+                                                              precision);
+      auto layout = log_linear_buckets<int64_t>::from(bounds);
+      if (!check(layout.has_value()))
+        continue;
+      check_eq(layout->precision(), precision);
+      for (int64_t value = -5; value < 200'000; value += 7)
+        if (!check_eq(layout->index_of(value), linear_search(bounds, value)))
+          break;
+      for (auto value : bounds)
+        check_eq(layout->index_of(value), linear_search(bounds, value));
+      auto max = std::numeric_limits<int64_t>::max();
+      check_eq(layout->index_of(max), bounds.size());
+    }
+  }
+  SECTION("floating point buckets") {
+    for (unsigned precision : {0u, 2u, 5u}) {
+      auto bounds = log_linear_buckets<double>::upper_bounds(1e-6, 10.0,
+                                                             precision);
+      auto layout = log_linear_buckets<double>::from(bounds);
+      if (!check(layout.has_value()))
+        continue;
+      check_eq(layout->precision(), precision);
+      for (auto value = 1e-8; value < 100.0; value *= 1.01)
+        if (!check_eq(layout->index_of(value), linear_search(bounds, value)))
+          break;
+      for (auto value : bounds) {
+        auto below = std::nextafter(value, 0.0);
+        auto above = std::nextafter(value, 100.0);
+        check_eq(layout->index_of(below), linear_search(bounds, below));
+        check_eq(layout->index_of(value), linear_search(bounds, value));
+        check_eq(layout->index_of(above), linear_search(bounds, above));
+      }
+      check_eq(layout->index_of(-1.0), 0u);
+      check_eq(layout->index_of(0.0), 0u);
+      auto inf = std::numeric_limits<double>::infinity();
+      check_eq(layout->index_of(inf), bounds.size());
+    }
+  }
+}
+
+TEST("the precision limits the relative width of the buckets") {
+  auto bounds = log_linear_buckets<double>::upper_bounds(1e-9, 100.0, 3);
+  check_le(bounds.front(), 1e-9);
+  check_ge(bounds.back(), 100.0);
+  for (size_t index = 1; index < bounds.size(); ++index) {
+    auto width = bounds[index] - bounds[index - 1];
+    check_le(width / bounds[index - 1], 1.0 / 8);
+  }
+}
+
+TEST("arbitrary bucket bounds are not log-linear") {
+  check(!log_linear_buckets<int64_t>::from(std::vector<int64_t>{1, 2, 4, 8}));
+  check(!log_linear_buckets<int64_t>::from(std::vector<int64_t>{5}));
+  check(!log_linear_buckets<double>::from(std::vector{.1, .2, .4, .8}));
+  check(!log_linear_buckets<double>::from(std::vector{1.0, 2.0, 3.0, 5.0}));
+  // Powers of two are log-linear buckets without mantissa bits.
+  auto pow2 = log_linear_buckets<double>::from(std::vector{1.0, 2.0, 4.0, 8.0});
+  if (check(pow2.has_value()))
+    check_eq(pow2->precision(), 0u);
+}
@@ -91,8 +91,15 @@ public:
   template <class Collector>
   void collect(Collector& collector) const {
     std::unique_lock<std::mutex> guard{mx_};
-    for (auto& ptr : metrics_)
-      collector(this, ptr.get(), std::addressof(ptr->impl()));
+    for (auto& ptr : metrics_) {
+      if constexpr (requires { typename Type::snapshot_type; }) {
+        // Striped metrics appear to collectors as their regular counterpart.
+        const auto& snapshot = ptr->impl().snapshot();
+        collector(this, ptr.get(), std::addressof(snapshot));
+      } else {
+        collector(this, ptr.get(), std::addressof(ptr->impl()));
+      }
+    }
   }
 
 private:
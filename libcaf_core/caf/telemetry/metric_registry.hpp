@@ -13,6 +13,9 @@
 #include "caf/telemetry/gauge.hpp"
 #include "caf/telemetry/histogram.hpp"
 #include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/striped_counter.hpp"
+#include "caf/telemetry/striped_gauge.hpp"
+#include "caf/telemetry/striped_histogram.hpp"
 
 #include <algorithm>
 #include <initializer_list>
@@ -182,6 +185,83 @@ public:
     return fptr->get_or_add({});
   }
 
+  /// Returns a striped gauge metric family. Striped gauges avoid contention
+  /// when many threads update the same gauge, but each instance needs one cache
+  /// line per stripe. Creates the family lazily if necessary, but fails if the
+  /// full name already belongs to a different family.
+  /// @param prefix The prefix (namespace) this family belongs to. Usually the
+  ///               application or protocol name, e.g., `http`. The prefix `caf`
+  ///               as well as prefixes starting with an underscore are
+  ///               reserved.
+  /// @param name The human-readable name of the metric, e.g., `requests`.
+  /// @param labels Names for all label dimensions of the metric.
+  /// @param helptext Short explanation of the metric.
+  /// @param unit Unit of measurement. Please use base units such as `bytes` or
+  ///             `seconds` (prefer lowercase). The pseudo-unit `1` identifies
+  ///             dimensionless counts.
+  /// @param is_sum Setting this to `true` indicates that this metric adds
+  ///               something up to a total, where only the total value is of
+  ///               interest. For example, the total number of HTTP requests.
+  template <class ValueType = int64_t>
+  metric_family_impl<striped_gauge<ValueType>>*
+  striped_gauge_family(std::string_view prefix, std::string_view name,
+                       span_t<std::string_view> labels,
+                       std::string_view helptext, std::string_view unit = "1",
+                       bool is_sum = false) {
+    using gauge_type = striped_gauge<ValueType>;
+    using family_type = metric_family_impl<gauge_type>;
+    std::unique_lock<std::mutex> guard{families_mx_};
+    if (auto ptr = fetch(prefix, name)) {
+      assert_properties(ptr, gauge_type::runtime_type, labels, unit, is_sum);
+      return static_cast<family_type*>(ptr);
+    }
+    auto ptr = std::make_unique<family_type>(
+      std::string{prefix}, std::string{name}, to_sorted_vec(labels),
+      std::string{helptext}, std::string{unit}, is_sum);
+    auto result = ptr.get();
+    families_.emplace_back(std::move(ptr));
+    return result;
+  }
+
+  /// @copydoc striped_gauge_family
+  template <class ValueType = int64_t>
+  metric_family_impl<striped_gauge<ValueType>>*
+  striped_gauge_family(std::string_view prefix, std::string_view name,
+                       std::initializer_list<std::string_view> labels,
+                       std::string_view helptext, std::string_view unit = "1",
+                       bool is_sum = false) {
+    auto lbl_span = std::span{labels.begin(), labels.size()};
+    return striped_gauge_family<ValueType>(prefix, name, lbl_span, helptext,
+                                           unit, is_sum);
+  }
+
+  /// Returns a striped gauge metric singleton, i.e., the single instance of a
+  /// family without label dimensions. Creates all objects lazily if
+  /// necessary, but fails if the full name already belongs to a different
+  /// family.
+  /// @param prefix The prefix (namespace) this family belongs to. Usually the
+  ///               application or protocol name, e.g., `http`. The prefix `caf`
+  ///               as well as prefixes starting with an underscore are
+  ///               reserved.
+  /// @param name The human-readable name of the metric, e.g., `requests`.
+  /// @param helptext Short explanation of the metric.
+  /// @param unit Unit of measurement. Please use base units such as `bytes`
+  ///             or `seconds` (prefer lowercase). The pseudo-unit `1`
+  ///             identifies dimensionless counts.
+  /// @param is_sum Setting this to `true` indicates that this metric adds
+  ///               something up to a total, where only the total value is of
+  ///               interest. For example, the total number of HTTP requests.
+  template <class ValueType = int64_t>
+  striped_gauge<ValueType>*
+  striped_gauge_singleton(std::string_view prefix, std::string_view name,
+                          std::string_view helptext,
+                          std::string_view unit = "1", bool is_sum = false) {
+    span_t<std::string_view> lbls;
+    auto fptr = striped_gauge_family<ValueType>(prefix, name, lbls, helptext,
+                                                unit, is_sum);
+    return fptr->get_or_add({});
+  }
+
   /// Returns a counter metric family. Creates the family lazily if
   /// necessary, but fails if the full name already belongs to a different
   /// family.
@@ -295,6 +375,83 @@ public:
     return fptr->get_or_add({});
   }
 
+  /// Returns a striped counter metric family. Striped counters avoid
+  /// contention when many threads update the same counter, but each instance
+  /// needs one cache line per stripe. Creates the family lazily if necessary,
+  /// but fails if the full name already belongs to a different family.
+  /// @param prefix The prefix (namespace) this family belongs to. Usually the
+  ///               application or protocol name, e.g., `http`. The prefix `caf`
+  ///               as well as prefixes starting with an underscore are
+  ///               reserved.
+  /// @param name The human-readable name of the metric, e.g., `requests`.
+  /// @param labels Names for all label dimensions of the metric.
+  /// @param helptext Short explanation of the metric.
+  /// @param unit Unit of measurement. Please use base units such as `bytes` or
+  ///             `seconds` (prefer lowercase). The pseudo-unit `1` identifies
+  ///             dimensionless counts.
+  /// @param is_sum Setting this to `true` indicates that this metric adds
+  ///               something up to a total, where only the total value is of
+  ///               interest. For example, the total number of HTTP requests.
+  template <class ValueType = int64_t>
+  metric_family_impl<striped_counter<ValueType>>*
+  striped_counter_family(std::string_view prefix, std::string_view name,
+                         span_t<std::string_view> labels,
+                         std::string_view helptext, std::string_view unit = "1",
+                         bool is_sum = false) {
+    using counter_type = striped_counter<ValueType>;
+    using family_type = metric_family_impl<counter_type>;
+    std::unique_lock<std::mutex> guard{families_mx_};
+    if (auto ptr = fetch(prefix, name)) {
+      assert_properties(ptr, counter_type::runtime_type, labels, unit, is_sum);
+      return static_cast<family_type*>(ptr);
+    }
+    auto ptr = std::make_unique<family_type>(
+      std::string{prefix}, std::string{name}, to_sorted_vec(labels),
+      std::string{helptext}, std::string{unit}, is_sum);
+    auto result = ptr.get();
+    families_.emplace_back(std::move(ptr));
+    return result;
+  }
+
+  /// @copydoc striped_counter_family
+  template <class ValueType = int64_t>
+  metric_family_impl<striped_counter<ValueType>>*
+  striped_counter_family(std::string_view prefix, std::string_view name,
+                         std::initializer_list<std::string_view> labels,
+                         std::string_view helptext, std::string_view unit = "1",
+                         bool is_sum = false) {
+    auto lbl_span = std::span{labels.begin(), labels.size()};
+    return striped_counter_family<ValueType>(prefix, name, lbl_span, helptext,
+                                             unit, is_sum);
+  }
+
+  /// Returns a striped counter metric singleton, i.e., the single instance of
+  /// a family without label dimensions. Creates all objects lazily if
+  /// necessary, but fails if the full name already belongs to a different
+  /// family.
+  /// @param prefix The prefix (namespace) this family belongs to. Usually the
+  ///               application or protocol name, e.g., `http`. The prefix `caf`
+  ///               as well as prefixes starting with an underscore are
+  ///               reserved.
+  /// @param name The human-readable name of the metric, e.g., `requests`.
+  /// @param helptext Short explanation of the metric.
+  /// @param unit Unit of measurement. Please use base units such as `bytes`
+  ///             or `seconds` (prefer lowercase). The pseudo-unit `1`
+  ///             identifies dimensionless counts.
+  /// @param is_sum Setting this to `true` indicates that this metric adds
+  ///               something up to a total, where only the total value is of
+  ///               interest. For example, the total number of HTTP requests.
+  template <class ValueType = int64_t>
+  striped_counter<ValueType>*
+  striped_counter_singleton(std::string_view prefix, std::string_view name,
+                            std::string_view helptext,
+                            std::string_view unit = "1", bool is_sum = false) {
+    span_t<std::string_view> lbls;
+    auto fptr = striped_counter_family<ValueType>(prefix, name, lbls, helptext,
+                                                  unit, is_sum);
+    return fptr->get_or_add({});
+  }
+
   /// Returns a histogram metric family. Creates the family lazily if
   /// necessary, but fails if the full name already belongs to a different
   /// family.
@@ -323,42 +480,8 @@ public:
                    span_t<ValueType> default_upper_bounds,
                    std::string_view helptext, std::string_view unit = "1",
                    bool is_sum = false) {
-    using histogram_type = histogram<ValueType>;
-    using family_type = metric_family_impl<histogram_type>;
-    using upper_bounds_list = std::vector<ValueType>;
-    if (default_upper_bounds.empty())
-      CAF_RAISE_ERROR("at least one bucket must exist in the default settings");
-    std::unique_lock<std::mutex> guard{families_mx_};
-    if (auto ptr = fetch(prefix, name)) {
-      assert_properties(ptr, histogram_type::runtime_type, label_names, unit,
-                        is_sum);
-      return static_cast<family_type*>(ptr);
-    }
-    const settings* sub_settings = nullptr;
-    upper_bounds_list upper_bounds;
-    if (config_ != nullptr) {
-      if (auto grp = get_if<settings>(config_, prefix)) {
-        if (sub_settings = get_if<settings>(grp, name);
-            sub_settings != nullptr) {
-          if (auto lst = get_as<upper_bounds_list>(*sub_settings, "buckets")) {
-            std::sort(lst->begin(), lst->end());
-            lst->erase(std::unique(lst->begin(), lst->end()), lst->end());
-            if (!lst->empty())
-              upper_bounds = std::move(*lst);
-          }
-        }
-      }
-    }
-    if (upper_bounds.empty())
-      upper_bounds.assign(default_upper_bounds.begin(),
-                          default_upper_bounds.end());
-    auto ptr = std::make_unique<family_type>(
-      sub_settings, std::string{prefix}, std::string{name},
-      to_sorted_vec(label_names), std::string{helptext}, std::string{unit},
-      is_sum, std::move(upper_bounds));
-    auto result = ptr.get();
-    families_.emplace_back(std::move(ptr));
-    return result;
+    return make_histogram_family<histogram<ValueType>>(
+      prefix, name, label_names, default_upper_bounds, helptext, unit, is_sum);
   }
 
   /// Returns a histogram metric family. Creates the family lazily if
@@ -467,6 +590,83 @@ public:
     return fptr->get_or_add({});
   }
 
+  /// Returns a striped histogram metric family. Striped histograms avoid
+  /// contention when many threads observe values for the same histogram, but
+  /// each instance stores its bucket counts once per stripe. Creates the
+  /// family lazily if necessary, but fails if the full name already belongs to
+  /// a different family.
+  /// @param prefix The prefix (namespace) this family belongs to. Usually the
+  ///               application or protocol name, e.g., `http`. The prefix `caf`
+  ///               as well as prefixes starting with an underscore are
+  ///               reserved.
+  /// @param name The human-readable name of the metric, e.g., `requests`.
+  /// @param label_names Names for all label dimensions of the metric.
+  /// @param default_upper_bounds Upper bounds for the metric buckets.
+  /// @param helptext Short explanation of the metric.
+  /// @param unit Unit of measurement. Please use base units such as `bytes` or
+  ///             `seconds` (prefer lowercase). The pseudo-unit `1` identifies
+  ///             dimensionless counts.
+  /// @param is_sum Setting this to `true` indicates that this metric adds
+  ///               something up to a total, where only the total value is of
+  ///               interest. For example, the total number of HTTP requests.
+  /// @note The actor system config may override `upper_bounds`.
+  template <class ValueType = int64_t>
+  metric_family_impl<striped_histogram<ValueType>>*
+  striped_histogram_family(std::string_view prefix, std::string_view name,
+                           span_t<std::string_view> label_names,
+                           span_t<ValueType> default_upper_bounds,
+                           std::string_view helptext,
+                           std::string_view unit = "1", bool is_sum = false) {
+    return make_histogram_family<striped_histogram<ValueType>>(
+      prefix, name, label_names, default_upper_bounds, helptext, unit, is_sum);
+  }
+
+  /// @copydoc striped_histogram_family
+  template <class ValueType = int64_t>
+  metric_family_impl<striped_histogram<ValueType>>*
+  striped_histogram_family(std::string_view prefix, std::string_view name,
+                           std::initializer_list<std::string_view> label_names,
+                           span_t<ValueType> default_upper_bounds,
+                           std::string_view helptext,
+                           std::string_view unit = "1", bool is_sum = false) {
+    auto lbl_span = std::span{label_names.begin(), label_names.size()};
+    return striped_histogram_family<ValueType>(prefix, name, lbl_span,
+                                               default_upper_bounds, helptext,
+                                               unit, is_sum);
+  }
+
+  /// Returns a striped histogram metric singleton, i.e., the single instance
+  /// of a family without label dimensions. Creates all objects lazily if
+  /// necessary, but fails if the full name already belongs to a different
+  /// family.
+  /// @param prefix The prefix (namespace) this family belongs to. Usually the
+  ///               application or protocol name, e.g., `http`. The prefix `caf`
+  ///               as well as prefixes starting with an underscore are
+  ///               reserved.
+  /// @param name The human-readable name of the metric, e.g., `requests`.
+  /// @param upper_bounds Upper bounds for the metric buckets.
+  /// @param helptext Short explanation of the metric.
+  /// @param unit Unit of measurement. Please use base units such as `bytes` or
+  ///             `seconds` (prefer lowercase). The pseudo-unit `1` identifies
+  ///             dimensionless counts.
+  /// @param is_sum Setting this to `true` indicates that this metric adds
+  ///               something up to a total, where only the total value is of
+  ///               interest. For example, the total number of HTTP requests.
+  /// @note The actor system config may override `upper_bounds`.
+  template <class ValueType = int64_t>
+  striped_histogram<ValueType>*
+  striped_histogram_singleton(std::string_view prefix, std::string_view name,
+                              span_t<ValueType> upper_bounds,
+                              std::string_view helptext,
+                              std::string_view unit = "1",
+                              bool is_sum = false) {
+    span_t<std::string_view> lbls;
+    auto fptr = striped_histogram_family<ValueType>(prefix, name, lbls,
+                                                    upper_bounds, helptext,
+                                                    unit, is_sum);
+    return fptr->get_or_add({});
+  }
+
   /// @internal
   void config(const settings* ptr) {
     config_ = ptr;
@@ -504,6 +704,50 @@ private:
 
   static std::vector<std::string> to_sorted_vec(span_t<label_view> xs);
 
+  /// Implements `histogram_family` and `striped_histogram_family`.
+  template <class Histogram>
+  metric_family_impl<Histogram>* make_histogram_family(
+    std::string_view prefix, std::string_view name,
+    span_t<std::string_view> label_names,
+    span_t<typename Histogram::value_type> default_upper_bounds,
+    std::string_view helptext, std::string_view unit, bool is_sum) {
+    using family_type = metric_family_impl<Histogram>;
+    using upper_bounds_list = std::vector<typename Histogram::value_type>;
+    if (default_upper_bounds.empty())
+      CAF_RAISE_ERROR("at least one bucket must exist in the default settings");
+    std::unique_lock<std::mutex> guard{families_mx_};
+    if (auto ptr = fetch(prefix, name)) {
+      assert_properties(ptr, Histogram::runtime_type, label_names, unit,
+                        is_sum);
+      return static_cast<family_type*>(ptr);
+    }
+    const settings* sub_settings = nullptr;
+    upper_bounds_list upper_bounds;
+    if (config_ != nullptr) {
+      if (auto grp = get_if<settings>(config_, prefix)) {
+        if (sub_settings = get_if<settings>(grp, name);
+            sub_settings != nullptr) {
+          if (auto lst = get_as<upper_bounds_list>(*sub_settings, "buckets")) {
+            std::sort(lst->begin(), lst->end());
+            lst->erase(std::unique(lst->begin(), lst->end()), lst->end());
+            if (!lst->empty())
+              upper_bounds = std::move(*lst);
+          }
+        }
+      }
+    }
+    if (upper_bounds.empty())
+      upper_bounds.assign(default_upper_bounds.begin(),
+                          default_upper_bounds.end());
+    auto ptr = std::make_unique<family_type>(
+      sub_settings, std::string{prefix}, std::string{name},
+      to_sorted_vec(label_names), std::string{helptext}, std::string{unit},
+      is_sum, std::move(upper_bounds));
+    auto result = ptr.get();
+    families_.emplace_back(std::move(ptr));
+    return result;
+  }
+
   template <class F>
   static auto visit_family(F& f, const metric_family* ptr) {
     switch (ptr->type()) {
@@ -517,6 +761,24 @@ private:
         return f(static_cast<const metric_family_impl<int_gauge>*>(ptr));
       case metric_type::dbl_histogram:
         return f(static_cast<const metric_family_impl<dbl_histogram>*>(ptr));
+      case metric_type::striped_dbl_counter:
+        return f(
+          static_cast<const metric_family_impl<striped_dbl_counter>*>(ptr));
+      case metric_type::striped_int_counter:
+        return f(
+          static_cast<const metric_family_impl<striped_int_counter>*>(ptr));
+      case metric_type::striped_dbl_gauge:
+        return f(
+          static_cast<const metric_family_impl<striped_dbl_gauge>*>(ptr));
+      case metric_type::striped_int_gauge:
+        return f(
+          static_cast<const metric_family_impl<striped_int_gauge>*>(ptr));
+      case metric_type::striped_dbl_histogram:
+        return f(
+          static_cast<const metric_family_impl<striped_dbl_histogram>*>(ptr));
+      case metric_type::striped_int_histogram:
+        return f(
+          static_cast<const metric_family_impl<striped_int_histogram>*>(ptr));
       default:
         CAF_ASSERT(ptr->type() == metric_type::int_histogram);
         return f(static_cast<const metric_family_impl<int_histogram>*>(ptr));
@@ -161,6 +161,35 @@ caf.mailbox-size{name="parser"} 12)");
   }
 }
 
+TEST("collectors observe striped metrics as regular counters and gauges") {
+  auto pm = reg.striped_counter_family("caf", "processed-messages", {"name"},
+                                       "How many messages were processed?");
+  auto qm = reg.striped_gauge_singleton("caf", "queued-messages",
+                                        "How many messages are queued?");
+  check_eq(pm, reg.striped_counter_family("caf", "processed-messages",
+                                          {"name"}, ""));
+  pm->get_or_add({{"name", "printer"}})->inc(7);
+  qm->inc(5);
+  qm->dec(2);
+  reg.collect(collector);
+  check_eq(collector.result, R"(
+caf.processed-messages{name="printer"} 7
+caf.queued-messages 3)");
+}
+
+TEST("collectors observe striped histograms as regular histograms") {
+  auto bounds = std::vector<int64_t>{1, 2, 4};
+  auto h = reg.striped_histogram_singleton<int64_t>("caf", "latency", bounds,
+                                                    "How long did it take?");
+  check_eq(h, reg.striped_histogram_singleton<int64_t>("caf", "latency",
+                                                       bounds, ""));
+  h->observe(3);
+  h->observe(9);
+  reg.collect(collector);
+  check_eq(collector.result, R"(
+caf.latency 12)");
+}
+
 TEST("buckets for histograms are configurable via runtime settings") {
   auto bounds = [](auto&& buckets) {
     std::vector<int64_t> result;
@@ -15,6 +15,12 @@ enum class metric_type : uint8_t {
   int_gauge,
   dbl_histogram,
   int_histogram,
+  striped_dbl_counter,
+  striped_int_counter,
+  striped_dbl_gauge,
+  striped_int_gauge,
+  striped_dbl_histogram,
+  striped_int_histogram,
 };
 
 } // namespace caf::telemetry
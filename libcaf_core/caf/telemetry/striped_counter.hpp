@@ -0,0 +1,91 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/assert.hpp"
+#include "caf/detail/striped_atomic.hpp"
+#include "caf/fwd.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/metric_type.hpp"
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace caf::telemetry {
+
+/// A counter that spreads updates from different threads over multiple cache
+/// lines. Reading the value sums up all stripes. Prefer this type over
+/// `counter` only for values that many threads update frequently, because
+/// each instance occupies one cache line per stripe. Collectors receive a
+/// `counter` with the current value.
+template <class ValueType>
+class striped_counter {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  using family_setting = unit_t;
+
+  using snapshot_type = counter<value_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr metric_type runtime_type
+    = std::is_same_v<value_type, double> ? metric_type::striped_dbl_counter
+                                         : metric_type::striped_int_counter;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  striped_counter() noexcept = default;
+
+  explicit striped_counter(value_type initial_value) noexcept
+    : value_(initial_value) {
+    // nop
+  }
+
+  explicit striped_counter(std::span<const label>) noexcept {
+    // nop
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Increments the counter by 1.
+  void inc() noexcept {
+    value_.add(1);
+  }
+
+  /// Increments the counter by `amount`.
+  /// @pre `amount >= 0`
+  void inc(value_type amount) noexcept {
+    CAF_ASSERT(amount >= 0);
+    value_.add(amount);
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the current value of the counter.
+  value_type value() const noexcept {
+    return value_.load();
+  }
+
+  /// Returns a regular counter with the current value.
+  snapshot_type snapshot() const noexcept {
+    return snapshot_type{value()};
+  }
+
+private:
+  detail::striped_atomic<value_type> value_;
+};
+
+/// Convenience alias for a striped counter with value type `double`.
+using striped_dbl_counter = striped_counter<double>;
+
+/// Convenience alias for a striped counter with value type `int64_t`.
+using striped_int_counter = striped_counter<int64_t>;
+
+} // namespace caf::telemetry
@@ -0,0 +1,45 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/telemetry/striped_counter.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/test.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+TEST("striped counters can only increment") {
+  SECTION("double counters") {
+    telemetry::striped_dbl_counter c;
+    check_eq(c.value(), test::approx{0.0});
+    c.inc();
+    c.inc(2.0);
+    check_eq(c.value(), test::approx{3.0});
+    check_eq(telemetry::striped_dbl_counter{42.0}.value(), test::approx{42.0});
+  }
+  SECTION("integer counters") {
+    telemetry::striped_int_counter c;
+    check_eq(c.value(), 0);
+    c.inc();
+    c.inc(2);
+    check_eq(c.value(), 3);
+    check_eq(telemetry::striped_int_counter{42}.value(), 42);
+  }
+}
+
+TEST("striped counters sum up the updates of all threads") {
+  telemetry::striped_int_counter c;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 16; ++i)
+    threads.emplace_back([&c] {
+      for (int j = 0; j < 1000; ++j)
+        c.inc();
+    });
+  for (auto& thread : threads)
+    thread.join();
+  check_eq(c.value(), 16'000);
+}
@@ -0,0 +1,98 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/striped_atomic.hpp"
+#include "caf/fwd.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/metric_type.hpp"
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace caf::telemetry {
+
+/// A gauge that spreads updates from different threads over multiple cache
+/// lines. Reading the value sums up all stripes. Prefer this type over `gauge`
+/// only for values that many threads update frequently, because each instance
+/// occupies one cache line per stripe. Unlike `gauge`, this type cannot set
+/// its value atomically and thus offers neither a setter nor increment and
+/// decrement operators. Collectors receive a `gauge` with the current value.
+template <class ValueType>
+class striped_gauge {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  using family_setting = unit_t;
+
+  using snapshot_type = gauge<value_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr metric_type runtime_type
+    = std::is_same_v<value_type, int64_t> ? metric_type::striped_int_gauge
+                                          : metric_type::striped_dbl_gauge;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  striped_gauge() noexcept = default;
+
+  explicit striped_gauge(value_type value) noexcept : value_(value) {
+    // nop
+  }
+
+  explicit striped_gauge(std::span<const label>) noexcept {
+    // nop
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Increments the gauge by 1.
+  void inc() noexcept {
+    value_.add(1);
+  }
+
+  /// Increments the gauge by `amount`.
+  void inc(value_type amount) noexcept {
+    value_.add(amount);
+  }
+
+  /// Decrements the gauge by 1.
+  void dec() noexcept {
+    value_.add(-1);
+  }
+
+  /// Decrements the gauge by `amount`.
+  void dec(value_type amount) noexcept {
+    value_.add(-amount);
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the current value of the gauge.
+  value_type value() const noexcept {
+    return value_.load();
+  }
+
+  /// Returns a regular gauge with the current value.
+  snapshot_type snapshot() const noexcept {
+    return snapshot_type{value()};
+  }
+
+private:
+  detail::striped_atomic<value_type> value_;
+};
+
+/// Convenience alias for a striped gauge with value type `double`.
+using striped_dbl_gauge = striped_gauge<double>;
+
+/// Convenience alias for a striped gauge with value type `int64_t`.
+using striped_int_gauge = striped_gauge<int64_t>;
+
+} // namespace caf::telemetry
@@ -0,0 +1,35 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/telemetry/striped_gauge.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/test.hpp"
+
+using namespace caf;
+
+TEST("striped gauges can increment and decrement") {
+  SECTION("double gauges") {
+    telemetry::striped_dbl_gauge g;
+    check_eq(g.value(), test::approx{0.0});
+    g.inc();
+    g.inc(2.0);
+    check_eq(g.value(), test::approx{3.0});
+    g.dec();
+    g.dec(5.0);
+    check_eq(g.value(), test::approx{-3.0});
+    check_eq(telemetry::striped_dbl_gauge{42.0}.value(), test::approx{42.0});
+  }
+  SECTION("integer gauges") {
+    telemetry::striped_int_gauge g;
+    check_eq(g.value(), 0);
+    g.inc();
+    g.inc(2);
+    check_eq(g.value(), 3);
+    g.dec();
+    g.dec(5);
+    check_eq(g.value(), -3);
+    check_eq(telemetry::striped_int_gauge{42}.value(), 42);
+  }
+}
@@ -0,0 +1,140 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/striped_atomic.hpp"
+#include "caf/fwd.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/telemetry/label.hpp"
+#include "caf/telemetry/metric_type.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace caf::telemetry {
+
+/// A histogram that spreads updates from different threads over multiple
+/// copies of its bucket counts. Each stripe starts on a cache line of its own
+/// and reading the histogram sums up all stripes. Prefer this type over
+/// `histogram` only for distributions that many threads update frequently,
+/// because each instance stores its bucket counts once per stripe. Collectors
+/// receive a `histogram` with the current counts.
+template <class ValueType>
+class striped_histogram {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = ValueType;
+
+  using family_setting = std::vector<value_type>;
+
+  using snapshot_type = histogram<value_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr metric_type runtime_type
+    = std::is_same_v<value_type, double> ? metric_type::striped_dbl_histogram
+                                         : metric_type::striped_int_histogram;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  striped_histogram(std::span<const label> labels, const settings* cfg,
+                    std::span<const value_type> upper_bounds)
+    : snapshot_(labels, cfg, upper_bounds) {
+    auto num_buckets = snapshot_.buckets().size();
+    blocks_per_stripe_ = (num_buckets + counts_per_block - 1)
+                         / counts_per_block;
+    blocks_ = std::make_unique<block[]>(blocks_per_stripe_
+                                        * detail::striped_atomic_stripes);
+  }
+
+  explicit striped_histogram(std::initializer_list<value_type> upper_bounds)
+    : striped_histogram({}, nullptr,
+                        std::span{upper_bounds.begin(), upper_bounds.size()}) {
+    // nop
+  }
+
+  striped_histogram(const striped_histogram&) = delete;
+
+  striped_histogram& operator=(const striped_histogram&) = delete;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Increments the bucket where the observed value falls into and increments
+  /// the sum of all observed values. Only touches the stripe of the calling
+  /// thread.
+  void observe(value_type value) noexcept {
+    auto index = snapshot_.index_of(value);
+    count(detail::striped_atomic_index(), index)
+      .fetch_add(1, std::memory_order_relaxed);
+    sum_.add(value);
+  }
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the sum of all observed values.
+  value_type sum() const noexcept {
+    return sum_.load();
+  }
+
+  /// Returns a histogram with the sum of all stripes. The result remains
+  /// valid until destroying this object but changes with each call.
+  const snapshot_type& snapshot() const {
+    std::unique_lock guard{snapshot_mx_};
+    auto* buckets = snapshot_.buckets_;
+    for (size_t index = 0; index < snapshot_.num_buckets_; ++index) {
+      int64_t total = 0;
+      for (size_t stripe = 0; stripe < detail::striped_atomic_stripes;
+           ++stripe)
+        total += count(stripe, index).load(std::memory_order_relaxed);
+      // Bucket counts only grow, so the difference is never negative.
+      buckets[index].count.inc(total - buckets[index].count.value());
+    }
+    snapshot_.sum_.value(sum_.load());
+    return snapshot_;
+  }
+
+private:
+  static constexpr size_t counts_per_block
+    = CAF_CACHE_LINE_SIZE / sizeof(std::atomic<int64_t>);
+
+  struct alignas(CAF_CACHE_LINE_SIZE) block {
+    std::atomic<int64_t> counts[counts_per_block] = {};
+  };
+
+  std::atomic<int64_t>& count(size_t stripe, size_t index) const noexcept {
+    auto& blk = blocks_[stripe * blocks_per_stripe_ + index / counts_per_block];
+    return blk.counts[index % counts_per_block];
+  }
+
+  /// Stores the bucket bounds and the counts for collectors.
+  mutable snapshot_type snapshot_;
+
+  /// Protects `snapshot_` against concurrent updates.
+  mutable std::mutex snapshot_mx_;
+
+  /// Stores the number of blocks for the bucket counts of a single stripe.
+  size_t blocks_per_stripe_;
+
+  /// Stores the bucket counts of all stripes, one stripe after the other.
+  std::unique_ptr<block[]> blocks_;
+
+  /// Stores the sum of all observed values.
+  detail::striped_atomic<value_type> sum_;
+};
+
+/// Convenience alias for a striped histogram with value type `double`.
+using striped_dbl_histogram = striped_histogram<double>;
+
+/// Convenience alias for a striped histogram with value type `int64_t`.
+using striped_int_histogram = striped_histogram<int64_t>;
+
+} // namespace caf::telemetry
@@ -0,0 +1,71 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/telemetry/striped_histogram.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/telemetry/log_linear_buckets.hpp"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace caf::telemetry;
+
+TEST("striped histograms use the same buckets as regular histograms") {
+  SECTION("double histograms") {
+    striped_dbl_histogram h1{.1, .2, .4, .8};
+    auto buckets = h1.snapshot().buckets();
+    check_eq(buckets.size(), 5u);
+    check_eq(buckets.front().upper_bound, test::approx{.1});
+    check(std::isinf(buckets.back().upper_bound));
+    check_eq(h1.sum(), test::approx{0.0});
+  }
+  SECTION("integer histograms") {
+    auto bounds = log_linear_buckets<int64_t>::upper_bounds(0, 100, 2);
+    striped_int_histogram h1({}, nullptr, bounds);
+    check(h1.snapshot().log_linear());
+    check_eq(h1.snapshot().buckets().size(), bounds.size() + 1);
+  }
+}
+
+TEST("striped histograms aggregate to buckets and keep a sum") {
+  striped_int_histogram h1{2, 4, 8};
+  for (int64_t value = 1; value < 11; ++value)
+    h1.observe(value);
+  auto buckets = h1.snapshot().buckets();
+  require_eq(buckets.size(), 4u);
+  check_eq(buckets[0].count.value(), 2); // 1, 2
+  check_eq(buckets[1].count.value(), 2); // 3, 4
+  check_eq(buckets[2].count.value(), 4); // 5, 6, 7, 8
+  check_eq(buckets[3].count.value(), 2); // 9, 10
+  check_eq(h1.sum(), 55);
+  check_eq(h1.snapshot().sum(), 55);
+  h1.observe(3);
+  check_eq(buckets[1].count.value(), 2);
+  check_eq(h1.snapshot().buckets()[1].count.value(), 3);
+  check_eq(h1.snapshot().sum(), 58);
+}
+
+TEST("striped histograms sum up the updates of all threads") {
+  striped_int_histogram h1{2, 4, 8};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 16; ++i)
+    threads.emplace_back([&h1] {
+      for (int64_t value = 1; value < 11; ++value)
+        h1.observe(value);
+    });
+  for (auto& thread : threads)
+    thread.join();
+  auto buckets = h1.snapshot().buckets();
+  require_eq(buckets.size(), 4u);
+  check_eq(buckets[0].count.value(), 32);
+  check_eq(buckets[1].count.value(), 32);
+  check_eq(buckets[2].count.value(), 64);
+  check_eq(buckets[3].count.value(), 32);
+  check_eq(h1.sum(), 880);
+}
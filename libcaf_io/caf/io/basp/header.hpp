@@ -48,6 +48,10 @@ struct header {
   /// Identifies a receiver by name rather than ID.
   static const uint8_t named_receiver_flag = 0x01;
 
+  /// Signals support for the compact binary encoding in handshakes. Marks
+  /// payloads that use the compact binary encoding in direct messages.
+  static const uint8_t compact_encoding_flag = 0x02;
+
   /// Identifies the config server.
   static const uint64_t config_server_id = 1;
 
@@ -13,6 +13,7 @@
 #include "caf/binary_serializer.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/assert.hpp"
+#include "caf/detail/serialized_size.hpp"
 #include "caf/log/io.hpp"
 #include "caf/settings.hpp"
 #include "caf/telemetry/histogram.hpp"
@@ -22,6 +23,18 @@
 
 namespace caf::io::basp {
 
+namespace {
+
+/// Makes sure that `buf` can store `num_bytes` additional bytes without
+/// reallocating. Grows the buffer at least by a factor of two to amortize
+/// allocations when writing multiple messages to the same buffer.
+void reserve_additional(byte_buffer& buf, size_t num_bytes) {
+  if (auto required = buf.size() + num_bytes; required > buf.capacity())
+    buf.reserve(std::max(required, buf.capacity() * 2));
+}
+
+} // namespace
+
 instance::callee::callee(actor_system& sys, proxy_registry::backend& backend)
   : namespace_(sys, backend) {
   // nop
@@ -44,6 +57,15 @@ instance::instance(abstract_broker* parent, callee& lstnr)
     workers = std::min(3u, std::thread::hardware_concurrency() / 4u) + 1;
   for (size_t i = 0; i < workers; ++i)
     hub_.add_new_worker(queue_, proxies());
+  compact_encoding_ = get_or(config(), "caf.middleman.compact-encoding",
+                             false);
+}
+
+void instance::negotiate_encoding(connection_handle hdl, const header& hdr) {
+  if (compact_encoding_ && hdr.has(header::compact_encoding_flag)) {
+    log::io::debug("use compact encoding for connection {}", hdl);
+    tbl_.enable_compact_encoding(hdl);
+  }
 }
 
 connection_state instance::handle(scheduler* ctx, new_data_msg& dm, header& hdr,
@@ -171,16 +193,24 @@ bool instance::dispatch(scheduler* ctx, const strong_actor_ptr& sender,
     return false;
   auto& source_node = sender ? sender->node() : this_node_;
   if (dest_node == path->next_hop && source_node == this_node_) {
+    auto compact = tbl_.compact_encoding(path->hdl);
+    if (compact)
+      flags |= header::compact_encoding_flag;
     header hdr{message_type::direct_message,
                flags,
                0,
                mid.integer_value(),
                sender ? sender->id() : invalid_actor_id,
                dest_actor};
-    auto writer = make_callback([&](binary_serializer& sink) { //
+    auto writer = make_callback([&](binary_serializer& sink) {
+      if (compact)
+        sink.encoding(binary_encoding::compact);
       return sink.apply(msg);
     });
-    write(*sys_, ctx, callee_.get_buffer(path->hdl), hdr, &writer);
+    // Compute the size of the payload first to allocate the buffer only once.
+    auto& buf = callee_.get_buffer(path->hdl);
+    reserve_additional(buf, header_size + detail::serialized_size(*sys_, msg));
+    write(*sys_, ctx, buf, hdr, &writer);
   } else {
     header hdr{message_type::routed_message,
                flags,
@@ -196,7 +226,11 @@ bool instance::dispatch(scheduler* ctx, const strong_actor_ptr& sender,
              && sink.apply(dest_node) //
              && sink.apply(msg);
     });
-    write(*sys_, ctx, callee_.get_buffer(path->hdl), hdr, &writer);
+    auto& buf = callee_.get_buffer(path->hdl);
+    reserve_additional(buf, header_size
+                              + detail::serialized_size(*sys_, source_node,
+                                                        dest_node, msg));
+    write(*sys_, ctx, buf, hdr, &writer);
   }
   flush(*path);
   return true;
@@ -222,6 +256,8 @@ void instance::write(actor_system& sys, scheduler*, byte_buffer& buf,
     auto signed_payload_len = static_cast<uint32_t>(payload_len);
     mm_metrics.outbound_messages_size->observe(signed_payload_len);
     hdr.payload_len = static_cast<uint32_t>(payload_len);
+    // The header always uses the fixed encoding, because its size is fixed.
+    sink.encoding(binary_encoding::fixed);
   }
   if (!sink.apply(hdr))
     log::io::error("{}", sink.get_error());
@@ -260,7 +296,7 @@ void instance::write_server_handshake(scheduler* ctx, byte_buffer& out_buf,
            && sink.apply(iface);
   });
   header hdr{message_type::server_handshake,
-             0,
+             handshake_flags(),
              0,
              version,
              invalid_actor_id,
@@ -273,7 +309,7 @@ void instance::write_client_handshake(scheduler* ctx, byte_buffer& buf) {
     return sink.apply(this_node_);
   });
   header hdr{message_type::client_handshake,
-             0,
+             handshake_flags(),
              0,
              0,
              invalid_actor_id,
@@ -374,6 +410,7 @@ connection_state instance::handle(scheduler* ctx, connection_handle hdl,
       // Add direct route to this node and remove any indirect entry.
       log::io::debug("new direct connection: source_node = {}", source_node);
       tbl_.add_direct(hdl, source_node);
+      negotiate_encoding(hdl, hdr);
       auto was_indirect = tbl_.erase_indirect(source_node);
       // write handshake as client in response
       auto path = tbl_.lookup(source_node);
@@ -404,6 +441,7 @@ connection_state instance::handle(scheduler* ctx, connection_handle hdl,
       // Add direct route to this node and remove any indirect entry.
       log::io::debug("new direct connection: source_node = {}", source_node);
       tbl_.add_direct(hdl, source_node);
+      negotiate_encoding(hdl, hdr);
       auto was_indirect = tbl_.erase_indirect(source_node);
       callee_.learned_new_node_directly(source_node, was_indirect);
       break;
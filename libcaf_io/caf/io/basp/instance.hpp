@@ -215,6 +215,15 @@ private:
   void forward(scheduler* ctx, const node_id& dest_node, const header& hdr,
                byte_buffer& payload);
 
+  /// Returns the flags for outgoing handshakes.
+  uint8_t handshake_flags() const noexcept {
+    return compact_encoding_ ? header::compact_encoding_flag : 0;
+  }
+
+  /// Marks the connection `hdl` as using the compact binary encoding if both
+  /// nodes support it.
+  void negotiate_encoding(connection_handle hdl, const header& hdr);
+
   actor_system* sys_;
   routing_table tbl_;
   published_actor_map published_actors_;
@@ -222,6 +231,10 @@ private:
   callee& callee_;
   message_queue queue_;
   detail::worker_hub<worker> hub_;
+
+  /// Stores whether this node uses the compact binary encoding for message
+  /// payloads when the remote node supports it.
+  bool compact_encoding_ = false;
 };
 
 /// @}
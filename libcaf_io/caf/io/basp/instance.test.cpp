@@ -0,0 +1,349 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/io/basp/instance.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/io/abstract_broker.hpp"
+#include "caf/io/basp/version.hpp"
+#include "caf/io/middleman.hpp"
+
+#include "caf/actor_registry.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/binary_deserializer.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/defaults.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace caf;
+using namespace caf::io;
+using namespace std::literals;
+
+namespace {
+
+// Captures the output of a BASP instance instead of writing to sockets.
+class test_callee : public proxy_registry::backend,
+                    public basp::instance::callee {
+public:
+  explicit test_callee(actor_system& sys) : callee(sys, *this) {
+    // nop
+  }
+
+  void finalize_handshake(const node_id&, actor_id,
+                          std::set<std::string>&) override {
+    // nop
+  }
+
+  void purge_state(const node_id&) override {
+    // nop
+  }
+
+  void proxy_announced(const node_id&, actor_id) override {
+    // nop
+  }
+
+  void learned_new_node_directly(const node_id&, bool) override {
+    // nop
+  }
+
+  void learned_new_node_indirectly(const node_id&) override {
+    // nop
+  }
+
+  void handle_heartbeat() override {
+    // nop
+  }
+
+  scheduler* current_scheduler() override {
+    return nullptr;
+  }
+
+  byte_buffer& get_buffer(connection_handle hdl) override {
+    return buffers[hdl];
+  }
+
+  void flush(connection_handle) override {
+    // nop
+  }
+
+  strong_actor_ptr this_actor() override {
+    return nullptr;
+  }
+
+  strong_actor_ptr make_proxy(node_id, actor_id) override {
+    return nullptr;
+  }
+
+  void set_last_hop(node_id*) override {
+    // nop
+  }
+
+  std::unordered_map<connection_handle, byte_buffer> buffers;
+};
+
+struct fixture {
+  // Starts an actor system and a BASP instance that uses the compact encoding
+  // if `compact` is true.
+  void init(bool compact) {
+    cfg.load<io::middleman>();
+    // Deserialize messages in the calling thread.
+    cfg.set("caf.middleman.workers", 0);
+    cfg.set("caf.middleman.compact-encoding", compact);
+    sys.emplace(cfg);
+    // The instance only uses its parent for accessing the actor system.
+    auto basp = sys->middleman().get_named_broker("BASP");
+    auto ptr = actor_cast<abstract_actor*>(basp);
+    auto parent = dynamic_cast<abstract_broker*>(ptr);
+    callee.emplace(*sys);
+    uut.emplace(parent, *callee);
+  }
+
+  static node_id make_nid(uint32_t pid) {
+    return *make_node_id(pid, "0102030405060708090A0B0C0D0E0F1011121314");
+  }
+
+  byte_buffer serialize(const message& msg, binary_encoding encoding) {
+    byte_buffer result;
+    binary_serializer sink{*sys, result};
+    sink.encoding(encoding);
+    if (!sink.apply(msg))
+      test::runnable::current().fail("failed to serialize {}", msg);
+    return result;
+  }
+
+  message deserialize(const_byte_span bytes, binary_encoding encoding) {
+    message result;
+    binary_deserializer source{*sys, bytes};
+    source.encoding(encoding);
+    if (!source.apply(result))
+      test::runnable::current().fail("failed to deserialize a message");
+    return result;
+  }
+
+  // Lets the instance receive a client handshake on `hdl`.
+  basp::connection_state
+  receive_client_handshake(connection_handle hdl, const node_id& nid,
+                           uint8_t flags) {
+    byte_buffer payload;
+    binary_serializer sink{*sys, payload};
+    if (!sink.apply(nid))
+      test::runnable::current().fail("failed to serialize the handshake");
+    basp::header hdr{basp::message_type::client_handshake,
+                     flags,
+                     static_cast<uint32_t>(payload.size()),
+                     basp::version,
+                     invalid_actor_id,
+                     invalid_actor_id};
+    return uut->handle(nullptr, hdl, hdr, &payload);
+  }
+
+  // Lets the instance receive a server handshake on `hdl`.
+  basp::connection_state
+  receive_server_handshake(connection_handle hdl, const node_id& nid,
+                           uint8_t flags) {
+    byte_buffer payload;
+    binary_serializer sink{*sys, payload};
+    auto app_ids = std::vector<std::string>{
+      std::string{defaults::middleman::app_identifier}};
+    auto aid = invalid_actor_id;
+    auto sigs = std::set<std::string>{};
+    if (!sink.apply(nid) || !sink.apply(app_ids) || !sink.apply(aid)
+        || !sink.apply(sigs))
+      test::runnable::current().fail("failed to serialize the handshake");
+    basp::header hdr{basp::message_type::server_handshake,
+                     flags,
+                     static_cast<uint32_t>(payload.size()),
+                     basp::version,
+                     invalid_actor_id,
+                     invalid_actor_id};
+    return uut->handle(nullptr, hdl, hdr, &payload);
+  }
+
+  // Splits a single BASP message in `buf` into its header and its payload.
+  std::pair<basp::header, byte_buffer> split(const byte_buffer& buf) {
+    basp::header hdr;
+    binary_deserializer source{*sys, buf};
+    if (!source.apply(hdr))
+      test::runnable::current().fail("failed to deserialize a header");
+    auto payload = byte_buffer{buf.begin() + basp::header_size, buf.end()};
+    return {hdr, std::move(payload)};
+  }
+
+  // Returns the flags of the handshake that the instance writes.
+  template <class Fn>
+  uint8_t handshake_flags(Fn write_handshake) {
+    byte_buffer buf;
+    write_handshake(buf);
+    return split(buf).first.flags;
+  }
+
+  actor_system_config cfg;
+  std::optional<actor_system> sys;
+  std::optional<test_callee> callee;
+  std::optional<basp::instance> uut;
+  connection_handle hdl_b = connection_handle::from_int(1);
+  connection_handle hdl_c = connection_handle::from_int(2);
+  node_id node_b = make_nid(2);
+  node_id node_c = make_nid(3);
+  node_id node_d = make_nid(4);
+  message msg = make_message(int32_t{1}, uint64_t{2}, "hello"s, int64_t{-3});
+};
+
+constexpr auto compact_flag = basp::header::compact_encoding_flag;
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("nodes announce the compact encoding in their handshakes") {
+  SECTION("enabled") {
+    init(true);
+    check_eq(handshake_flags([this](byte_buffer& buf) {
+               uut->write_client_handshake(nullptr, buf);
+             }),
+             compact_flag);
+    check_eq(handshake_flags([this](byte_buffer& buf) {
+               uut->write_server_handshake(nullptr, buf, std::nullopt);
+             }),
+             compact_flag);
+  }
+  SECTION("disabled") {
+    init(false);
+    check_eq(handshake_flags([this](byte_buffer& buf) {
+               uut->write_client_handshake(nullptr, buf);
+             }),
+             uint8_t{0});
+    check_eq(handshake_flags([this](byte_buffer& buf) {
+               uut->write_server_handshake(nullptr, buf, std::nullopt);
+             }),
+             uint8_t{0});
+  }
+}
+
+TEST("connections use the compact encoding only if both nodes support it") {
+  SECTION("the server receives a client handshake") {
+    init(true);
+    check_eq(receive_client_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+    check_eq(receive_client_handshake(hdl_c, node_c, 0), basp::await_header);
+    check(uut->tbl().compact_encoding(hdl_b));
+    check(!uut->tbl().compact_encoding(hdl_c));
+  }
+  SECTION("the client receives a server handshake") {
+    init(true);
+    check_eq(receive_server_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+    check_eq(receive_server_handshake(hdl_c, node_c, 0), basp::await_header);
+    check(uut->tbl().compact_encoding(hdl_b));
+    check(!uut->tbl().compact_encoding(hdl_c));
+  }
+  SECTION("the local node disables the compact encoding") {
+    init(false);
+    check_eq(receive_client_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+    check_eq(receive_server_handshake(hdl_c, node_c, compact_flag),
+             basp::await_header);
+    check(!uut->tbl().compact_encoding(hdl_b));
+    check(!uut->tbl().compact_encoding(hdl_c));
+  }
+  SECTION("closing a connection resets its encoding") {
+    init(true);
+    check_eq(receive_client_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+    uut->tbl().erase_direct(hdl_b);
+    check(!uut->tbl().compact_encoding(hdl_b));
+  }
+}
+
+TEST("direct messages use the encoding of their connection") {
+  init(true);
+  require_eq(receive_client_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+  require_eq(receive_client_handshake(hdl_c, node_c, 0), basp::await_header);
+  auto fixed = serialize(msg, binary_encoding::fixed);
+  auto compact = serialize(msg, binary_encoding::compact);
+  check_lt(compact.size(), fixed.size());
+  SECTION("the peer supports the compact encoding") {
+    check(uut->dispatch(nullptr, nullptr, node_b, 42, 0, make_message_id(),
+                        msg));
+    auto [hdr, payload] = split(callee->buffers[hdl_b]);
+    check_eq(hdr.operation, basp::message_type::direct_message);
+    check(hdr.has(compact_flag));
+    check_eq(payload, compact);
+    check_eq(to_string(deserialize(payload, binary_encoding::compact)),
+             to_string(msg));
+  }
+  SECTION("the peer does not support the compact encoding") {
+    check(uut->dispatch(nullptr, nullptr, node_c, 42, 0, make_message_id(),
+                        msg));
+    auto [hdr, payload] = split(callee->buffers[hdl_c]);
+    check_eq(hdr.operation, basp::message_type::direct_message);
+    check(!hdr.has(compact_flag));
+    check_eq(payload, fixed);
+  }
+}
+
+TEST("routed messages always use the fixed encoding") {
+  init(true);
+  require_eq(receive_client_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+  require(uut->tbl().add_indirect(node_b, node_d));
+  check(uut->dispatch(nullptr, nullptr, node_d, 42, 0, make_message_id(),
+                      msg));
+  auto [hdr, payload] = split(callee->buffers[hdl_b]);
+  check_eq(hdr.operation, basp::message_type::routed_message);
+  check(!hdr.has(compact_flag));
+  binary_deserializer source{*sys, payload};
+  node_id source_node;
+  node_id dest_node;
+  message content;
+  check(source.apply(source_node));
+  check(source.apply(dest_node));
+  check(source.apply(content));
+  check_eq(source.remaining(), 0u);
+  check_eq(source_node, sys->node());
+  check_eq(dest_node, node_d);
+  check_eq(to_string(content), to_string(msg));
+}
+
+TEST("receivers decode compact direct messages") {
+  init(true);
+  require_eq(receive_client_handshake(hdl_b, node_b, compact_flag),
+             basp::await_header);
+  scoped_actor self{*sys};
+  sys->registry().put(self->id(), actor_cast<strong_actor_ptr>(self));
+  auto payload = serialize(msg, binary_encoding::compact);
+  basp::header hdr{basp::message_type::direct_message,
+                   compact_flag,
+                   static_cast<uint32_t>(payload.size()),
+                   make_message_id().integer_value(),
+                   invalid_actor_id,
+                   self->id()};
+  check_eq(uut->handle(nullptr, hdl_b, hdr, &payload), basp::await_header);
+  auto received = false;
+  self->receive(
+    [&](int32_t x, uint64_t y, const std::string& str, int64_t z) {
+      received = true;
+      check_eq(x, 1);
+      check_eq(y, 2u);
+      check_eq(str, "hello");
+      check_eq(z, -3);
+    },
+    after(1s) >> [] {
+      // nop
+    });
+  check(received);
+  sys->registry().erase(self->id());
+}
+
+} // WITH_FIXTURE(fixture)
@@ -42,6 +42,8 @@ public:
     message msg;
     auto mid = make_message_id(dref.hdr_.operation_data);
     binary_deserializer source{sys, dref.payload_};
+    if (dref.hdr_.has(basp::header::compact_encoding_flag))
+      source.encoding(binary_encoding::compact);
     // Make sure to drop the message in case we return abnormally.
     auto guard = detail::scope_guard{
       [&]() noexcept { dref.queue_->drop(ctx, dref.msg_id_); }};
@@ -76,11 +76,22 @@ node_id routing_table::erase_direct(const connection_handle& hdl) {
   if (i == direct_by_hdl_.end())
     return {};
   direct_by_nid_.erase(i->second);
+  compact_.erase(hdl);
   node_id result = std::move(i->second);
   direct_by_hdl_.erase(i->first);
   return result;
 }
 
+void routing_table::enable_compact_encoding(const connection_handle& hdl) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  compact_.emplace(hdl);
+}
+
+bool routing_table::compact_encoding(const connection_handle& hdl) const {
+  std::unique_lock<std::mutex> guard{mtx_};
+  return compact_.count(hdl) != 0;
+}
+
 bool routing_table::erase_indirect(const node_id& dest) {
   std::unique_lock<std::mutex> guard{mtx_};
   auto i = indirect_.find(dest);
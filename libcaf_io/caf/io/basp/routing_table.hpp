@@ -59,6 +59,14 @@ public:
   /// unreachable as a result of this operation.
   node_id erase_direct(const connection_handle& hdl);
 
+  /// Marks the direct connection `hdl` as using the compact binary encoding
+  /// for message payloads.
+  void enable_compact_encoding(const connection_handle& hdl);
+
+  /// Returns whether the direct connection `hdl` uses the compact binary
+  /// encoding for message payloads.
+  bool compact_encoding(const connection_handle& hdl) const;
+
   /// Removes any entry for indirect connection to `dest` and returns
   /// `true` if `dest` had an indirect route, otherwise `false`.
   bool erase_indirect(const node_id& dest);
@@ -76,6 +84,7 @@ public:
   std::unordered_map<connection_handle, node_id> direct_by_hdl_;
   std::unordered_map<node_id, connection_handle> direct_by_nid_;
   std::unordered_map<node_id, node_id_set> indirect_;
+  std::unordered_set<connection_handle> compact_;
 };
 
 /// @}
@@ -193,7 +193,10 @@ void middleman::add_module_options(actor_system_config& cfg) {
                    "(disabled if 0, ignored if heartbeats are disabled)")
     .add<bool>("attach-utility-actors",
                "schedule utility actors instead of dedicating threads")
-    .add<size_t>("workers", "number of deserialization workers");
+    .add<size_t>("workers", "number of deserialization workers")
+    .add<bool>("compact-encoding",
+               "encodes integers in message payloads as varints if the "
+               "remote node supports it");
   config_option_adder{cfg.custom_options(), "caf.middleman.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
     .add<std::string>("address", "bind address for the HTTP server socket")
@@ -204,6 +207,7 @@ void middleman::add_module_options(actor_system_config& cfg) {
   put_missing(grp, "app-identifiers",
               std::vector<std::string>{std::move(default_id)});
   put_missing(grp, "enable-automatic-connections", false);
+  put_missing(grp, "compact-encoding", false);
   put_missing(grp, "max-consecutive-reads",
               defaults::middleman::max_consecutive_reads);
   put_missing(grp, "heartbeat-interval",
@@ -4,11 +4,16 @@
 
 #include "caf/detail/rfc6455.hpp"
 
+#include "caf/config.hpp"
 #include "caf/detail/network_order.hpp"
 
 #include <cstring>
 #include <limits>
 
+#ifdef CAF_HAS_SSE2
+#  include <emmintrin.h>
+#endif
+
 namespace caf::detail {
 
 void rfc6455::mask_data(uint32_t key, std::span<char> data, size_t offset) {
@@ -19,11 +24,44 @@ void rfc6455::mask_data(uint32_t key, byte_span data, size_t offset) {
   auto no_key = to_network_order(key);
   std::byte arr[4];
   memcpy(arr, &no_key, 4);
-  auto i = offset % 4;
-  for (auto it = data.begin() + offset; it < data.end(); ++it) {
-    *it ^= arr[i];
-    i = (i + 1) % 4;
+  auto* first = data.data() + offset;
+  auto* last = data.data() + data.size();
+  // Mask byte-wise until we reach the start of the key.
+  for (auto i = offset % 4; i != 0 && first != last; i = (i + 1) % 4)
+    *first++ ^= arr[i];
+  // Mask the bulk of the data with the key repeated to fill a word.
+  std::byte arr8[8];
+  memcpy(arr8, arr, 4);
+  memcpy(arr8 + 4, arr, 4);
+  uint64_t key8;
+  memcpy(&key8, arr8, 8);
+#ifdef CAF_HAS_SSE2
+  auto key16 = _mm_set1_epi64x(static_cast<long long>(key8));
+  auto mask16 = [key16](std::byte* ptr) {
+    auto* addr = reinterpret_cast<__m128i*>(ptr);
+    _mm_storeu_si128(addr, _mm_xor_si128(_mm_loadu_si128(addr), key16));
+  };
+  while (last - first >= 32) {
+    mask16(first);
+    mask16(first + 16);
+    first += 32;
+  }
+  if (last - first >= 16) {
+    mask16(first);
+    first += 16;
+  }
+#endif
+  while (last - first >= 8) {
+    uint64_t block;
+    memcpy(&block, first, 8);
+    block ^= key8;
+    memcpy(first, &block, 8);
+    first += 8;
   }
+  // Mask the remaining bytes. We always consume multiples of the key length
+  // above, so the tail starts at the beginning of the key.
+  for (size_t i = 0; first != last; ++i)
+    *first++ ^= arr8[i];
 }
 
 void rfc6455::assemble_frame(uint32_t mask_key, std::span<const char> data,
@@ -71,6 +71,26 @@ TEST("partial masking with offset") {
   }
 }
 
+TEST("masking matches the byte-wise algorithm for any length and offset") {
+  auto key = uint32_t{0xDEADC0DE};
+  auto key_bytes = bytes({0xDE, 0xAD, 0xC0, 0xDE});
+  // Covers all combinations of head, bulk and tail sizes.
+  for (size_t len = 0; len < 80; ++len) {
+    auto data = byte_buffer{};
+    for (size_t i = 0; i < len; ++i)
+      data.push_back(static_cast<std::byte>(i * 7 + 3));
+    for (size_t offset = 0; offset <= len; ++offset) {
+      auto expected = data;
+      for (auto i = offset; i < len; ++i)
+        expected[i] ^= key_bytes[i % 4];
+      auto masked_data = data;
+      impl::mask_data(key, masked_data, offset);
+      if (!check_eq(masked_data, expected))
+        return;
+    }
+  }
+}
+
 TEST("decoding a frame with RSV bits fails") {
   std::vector<uint8_t> data;
   byte_buffer out = bytes({
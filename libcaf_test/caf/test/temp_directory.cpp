@@ -0,0 +1,37 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/test/temp_directory.hpp"
+
+#include <atomic>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace caf::test {
+
+temp_directory::temp_directory(std::string_view prefix) {
+  // The counter keeps names unique within a process and the random part keeps
+  // them unique across test processes that run in parallel.
+  static std::atomic<size_t> instances;
+  auto id = std::to_string(std::random_device{}()) + '-'
+            + std::to_string(++instances);
+  auto name = std::string{prefix};
+  name += '-';
+  name += id;
+  path_ = fs::temp_directory_path() / name;
+  fs::remove_all(path_);
+  fs::create_directories(path_);
+}
+
+temp_directory::~temp_directory() {
+  std::error_code ec;
+  fs::remove_all(path_, ec);
+}
+
+std::string temp_directory::file(std::string_view name) const {
+  return (path_ / name).string();
+}
+
+} // namespace caf::test
@@ -0,0 +1,42 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/test_export.hpp"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace caf::test {
+
+/// Creates an empty directory with a unique name in the temporary directory of
+/// the system and removes it, including its content, on destruction. Fixtures
+/// must not share directories, because the test runner creates the fixture for
+/// the next run of a test before destroying the fixture of the previous run.
+class CAF_TEST_EXPORT temp_directory {
+public:
+  /// Creates a new directory with a name that starts with `prefix`.
+  explicit temp_directory(std::string_view prefix);
+
+  temp_directory(const temp_directory&) = delete;
+
+  temp_directory& operator=(const temp_directory&) = delete;
+
+  ~temp_directory();
+
+  /// Returns the path to the directory.
+  const std::filesystem::path& path() const noexcept {
+    return path_;
+  }
+
+  /// Returns the path to the file `name` inside the directory.
+  std::string file(std::string_view name) const;
+
+private:
+  std::filesystem::path path_;
+};
+
+} // namespace caf::test
@@ -0,0 +1,26 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/test/temp_directory.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+TEST("temporary directories are unique and removed on destruction") {
+  auto first_path = fs::path{};
+  {
+    caf::test::temp_directory first{"caf-temp-directory-test"};
+    caf::test::temp_directory second{"caf-temp-directory-test"};
+    first_path = first.path();
+    check(fs::is_directory(first.path()));
+    check(fs::is_directory(second.path()));
+    check_ne(first.path().string(), second.path().string());
+    std::ofstream{first.file("foo.txt")} << "foo";
+    check(fs::exists(first.path() / "foo.txt"));
+  }
+  check(!fs::exists(first_path));
+}
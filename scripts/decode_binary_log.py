@@ -0,0 +1,140 @@
+#!/usr/bin/env python
+
+# Converts a binary CAF log file to text. CAF writes binary log files when
+# setting caf.logger.file.binary and caf.logger.deferred-formatting to true.
+# Records in a binary log store the format string and the arguments instead of
+# the formatted message, so this script performs the formatting step offline.
+
+# usage (read file): decode_binary_log.py FILENAME
+#      (read stdin): decode_binary_log.py -
+
+import argparse, datetime, struct, sys
+
+MAGIC = b'CAF-BLOG'
+
+VERSION = 1
+
+LEVEL_NAMES = {200: 'ERROR', 300: 'WARN', 400: 'INFO', 500: 'DEBUG',
+               600: 'TRACE'}
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def read(self, fmt):
+        res = struct.unpack_from('<' + fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return res[0]
+
+    def read_str(self):
+        size = self.read('I')
+        res = self.data[self.pos:self.pos + size].decode('utf-8', 'replace')
+        self.pos += size
+        return res
+
+def read_arg(rd):
+    tag = rd.read('B')
+    if tag == 0:
+        return 'true' if rd.read('B') != 0 else 'false'
+    if tag == 1:
+        return chr(rd.read('B'))
+    if tag == 2:
+        return rd.read('q')
+    if tag == 3:
+        return rd.read('Q')
+    if tag == 4:
+        return rd.read('d')
+    return rd.read_str()
+
+def read_record(rd):
+    rec = {}
+    rec['level'] = rd.read('I')
+    rec['line'] = rd.read('I')
+    flags = rd.read('B')
+    num_args = rd.read('B')
+    rec['ts'] = rd.read('q')
+    rec['aid'] = rd.read('Q')
+    rec['thread'] = rd.read_str()
+    rec['component'] = rd.read_str()
+    rec['file'] = rd.read_str()
+    rec['function'] = rd.read_str()
+    fmt = rd.read_str()
+    args = [read_arg(rd) for _ in range(num_args)]
+    if flags & 1:
+        rec['message'] = fmt
+    else:
+        try:
+            rec['message'] = fmt.format(*args)
+        except (IndexError, KeyError, ValueError):
+            rec['message'] = '{} {}'.format(fmt, args)
+    return rec
+
+def render(rec, t0, line_format):
+    out = []
+    it = iter(line_format)
+    for ch in it:
+        if ch != '%':
+            out.append(ch)
+            continue
+        field = next(it, '')
+        if field == 'c':
+            out.append(rec['component'])
+        elif field == 'C':
+            out.append('null')
+        elif field == 'd':
+            ts = datetime.datetime.fromtimestamp(rec['ts'] / 1e9,
+                                                 datetime.timezone.utc)
+            out.append(ts.isoformat(timespec='milliseconds'))
+        elif field == 'F':
+            out.append(rec['file'])
+        elif field == 'L':
+            out.append(str(rec['line']))
+        elif field == 'm':
+            out.append(rec['message'])
+        elif field == 'M':
+            out.append(rec['function'])
+        elif field == 'n':
+            out.append('\n')
+        elif field == 'p':
+            out.append(LEVEL_NAMES.get(rec['level'], str(rec['level'])))
+        elif field == 'r':
+            out.append(str((rec['ts'] - t0) // 1000000))
+        elif field == 't':
+            out.append(rec['thread'])
+        elif field == 'a':
+            out.append(str(rec['aid']))
+        elif field == '%':
+            out.append('%')
+    return ''.join(out)
+
+def decode(data, line_format):
+    if not data.startswith(MAGIC):
+        sys.exit('not a binary CAF log file')
+    rd = Reader(data)
+    rd.pos = len(MAGIC)
+    version = rd.read('I')
+    if version != VERSION:
+        sys.exit('unsupported version: {}'.format(version))
+    t0 = rd.read('q')
+    while rd.pos < len(data):
+        size = rd.read('I')
+        end = rd.pos + size
+        sys.stdout.write(render(read_record(rd), t0, line_format))
+        rd.pos = end
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary CAF log.')
+    parser.add_argument('-f', dest='format',
+                        default='%r %c %p %a %t %M %F:%L %m%n',
+                        help='line format (same syntax as the CAF logger)')
+    parser.add_argument('log', help='path to the log file or - for stdin')
+    args = parser.parse_args()
+    if args.log == '-':
+        decode(sys.stdin.buffer.read(), args.format)
+    else:
+        with open(args.log, 'rb') as f:
+            decode(f.read(), args.format)
+
+if __name__ == '__main__':
+    main()